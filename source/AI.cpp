@@ -209,7 +209,7 @@ namespace {
 	}
 	
 	// Wrapper for ship - target system uses.
-	bool ShouldRefuel(const Ship &ship, const System *to)
+	bool ShouldRefuel(const Ship &ship, const System *to, RouteCache &routes)
 	{
 		if(!to || ship.Fuel() == 1. || !ship.GetSystem()->HasFuelFor(ship))
 			return false;
@@ -223,7 +223,7 @@ namespace {
 		{
 			// If no direct jump route, or the target system has no
 			// fuel, perform a more elaborate refueling check.
-			return ShouldRefuel(ship, DistanceMap(ship, to), fuelCapacity);
+			return ShouldRefuel(ship, routes.Get(ship, to), fuelCapacity);
 		}
 	}
 	
@@ -253,12 +253,12 @@ namespace {
 	
 	// Set the ship's TargetStellar or TargetSystem in order to reach the
 	// next desired system. Will target a landable planet to refuel.
-	void SelectRoute(Ship &ship, const System *targetSystem)
+	void SelectRoute(Ship &ship, const System *targetSystem, RouteCache &routes)
 	{
 		const System *from = ship.GetSystem();
 		if(from == targetSystem || !targetSystem)
 			return;
-		const DistanceMap route(ship, targetSystem);
+		const DistanceMap &route = routes.Get(ship, targetSystem);
 		const bool needsRefuel = ShouldRefuel(ship, route);
 		const System *to = route.Route(from);
 		// The destination may be accessible by both jump and wormhole.
@@ -290,6 +290,39 @@ namespace {
 		ship.SetTargetStellar(nullptr);
 	}
 	
+	// The motion of all the bodies that a ship might fire at, relative to one
+	// of its hardpoints. Each value is kept in its own array so that the loops
+	// over all the targets can be vectorized by the compiler.
+	class TargetKinematics {
+	public:
+		// Record the position and velocity of a potential target.
+		void Add(const Body &body);
+		size_t Size() const;
+		// Find where each target will be one step from now relative to the given
+		// firing point, and its velocity relative to the given velocity. The
+		// distances are also calculated.
+		void Update(const Point &start, const Point &velocity);
+		// Get the number of steps a projectile with the given speed needs to
+		// reach each target, or NaN if it cannot.
+		void RendezvousTimes(double vp, vector<double> &times) const;
+		
+		Point RelativePosition(size_t i) const;
+		Point RelativeVelocity(size_t i) const;
+		double Distance(size_t i) const;
+		
+	private:
+		vector<double> x;
+		vector<double> y;
+		vector<double> vx;
+		vector<double> vy;
+		
+		vector<double> px;
+		vector<double> py;
+		vector<double> rvx;
+		vector<double> rvy;
+		vector<double> distance;
+	};
+	
 	const double MAX_DISTANCE_FROM_CENTER = 10000.;
 	// Constants for the invisible fence timer.
 	const int FENCE_DECAY = 4;
@@ -427,7 +460,7 @@ void AI::UpdateKeys(PlayerInfo &player, Command &activeCommands)
 
 
 
-void AI::UpdateEvents(const list<ShipEvent> &events)
+void AI::UpdateEvents(const vector<ShipEvent> &events)
 {
 	for(const ShipEvent &event : events)
 	{
@@ -471,14 +504,18 @@ void AI::Clean()
 	governmentActions.clear();
 	scanPermissions.clear();
 	playerActions.clear();
+	slotOwners.clear();
 	swarmCount.clear();
 	fenceCount.clear();
 	miningAngle.clear();
+	hasMiningAngle.clear();
 	miningTime.clear();
 	appeasmentThreshold.clear();
 	shipStrength.clear();
+	hasStrength.clear();
 	enemyStrength.clear();
 	allyStrength.clear();
+	routes.Clear();
 }
 
 
@@ -502,21 +539,20 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 	CacheShipLists();
 	
 	// Update the counts of how long ships have been outside the "invisible fence."
-	// If a ship ceases to exist, this also ensures that it will be removed from
-	// the fence count map after a few seconds.
-	for(auto it = fenceCount.begin(); it != fenceCount.end(); )
-	{
-		it->second -= FENCE_DECAY;
-		if(it->second < 0)
-			it = fenceCount.erase(it);
-		else
-			++it;
-	}
+	// If a ship ceases to exist, this also ensures that its count will be
+	// cleared after a few seconds.
+	for(int &value : fenceCount)
+		if(value >= 0)
+		{
+			value -= FENCE_DECAY;
+			if(value < 0)
+				value = -1;
+		}
 	for(const auto &it : ships)
 		if(it->Position().Length() >= MAX_DISTANCE_FROM_CENTER)
 		{
-			int &value = fenceCount[&*it];
-			value = min(FENCE_MAX, value + FENCE_DECAY + 1);
+			int &value = fenceCount[Slot(*it)];
+			value = min(FENCE_MAX, max(value, 0) + FENCE_DECAY + 1);
 		}
 	
 	const Ship *flagship = player.Flagship();
@@ -567,7 +603,7 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 				if(personality.IsAppeasing())
 				{
 					double health = .5 * it->Shields() + it->Hull();
-					double &threshold = appeasmentThreshold[it.get()];
+					double &threshold = appeasmentThreshold[Slot(*it)];
 					threshold = max((1. - health) + .1, threshold);
 				}
 				continue;
@@ -652,7 +688,7 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			if(personality.IsAppeasing() && it->Cargo().Used())
 			{
 				double health = .5 * it->Shields() + it->Hull();
-				double &threshold = appeasmentThreshold[it.get()];
+				double &threshold = appeasmentThreshold[Slot(*it)];
 				if(1. - health > threshold)
 				{
 					int toDump = 11 + (1. - health) * .5 * it->Cargo().Size();
@@ -741,7 +777,7 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			// Miners with free cargo space and available mining time should mine. Mission NPCs
 			// should mine even if there are other miners or they have been mining a while.
 			if(it->Cargo().Free() >= 5 && IsArmed(*it) && (it->IsSpecial()
-					|| (++miningTime[&*it] < 3600 && ++minerCount < maxMinerCount)))
+					|| (++miningTime[Slot(*it)] < 3600 && ++minerCount < maxMinerCount)))
 			{
 				if(it->HasBays())
 				{
@@ -755,7 +791,7 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 			// Fighters and drones should assist their parent's mining operation if they cannot
 			// carry ore, and the asteroid is near enough that the parent can harvest the ore.
 			const shared_ptr<Minable> &minable = parent ? parent->GetTargetAsteroid() : nullptr;
-			if(it->CanBeCarried() && parent && miningTime[&*parent] < 3601 && minable
+			if(it->CanBeCarried() && parent && miningTime[Slot(*parent)] < 3601 && minable
 					&& minable->Position().Distance(parent->Position()) < 600.)
 			{
 				it->SetTargetAsteroid(minable);
@@ -970,11 +1006,8 @@ bool AI::CanPursue(const Ship &ship, const Ship &target) const
 		return true;
 	
 	// Check if the target is beyond the "invisible fence" for this system.
-	const auto fit = fenceCount.find(&target);
-	if(fit == fenceCount.end())
-		return true;
-	else
-		return (fit->second != FENCE_MAX);
+	int slot = FindSlot(target);
+	return (slot < 0 || fenceCount[slot] != FENCE_MAX);
 }
 
 
@@ -1145,9 +1178,9 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	bool canPlunder = person.Plunders() && ship.Cargo().Free();
 	// Figure out how strong this ship is.
 	int64_t maxStrength = 0;
-	auto strengthIt = shipStrength.find(&ship);
-	if(!person.IsHeroic() && strengthIt != shipStrength.end())
-		maxStrength = 2 * strengthIt->second;
+	int slot = FindSlot(ship);
+	if(!person.IsHeroic() && slot >= 0 && hasStrength[slot])
+		maxStrength = 2 * shipStrength[slot];
 	
 	// Get a list of all targetable, hostile ships in this system.
 	const auto enemies = GetShipsList(ship, true);
@@ -1173,8 +1206,8 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 		// Unless this ship is "heroic", it should not chase much stronger ships.
 		if(maxStrength && range > 1000. && !foe->IsDisabled())
 		{
-			const auto otherStrengthIt = shipStrength.find(foe.get());
-			if(otherStrengthIt != shipStrength.end() && otherStrengthIt->second > maxStrength)
+			int foeSlot = FindSlot(*foe);
+			if(foeSlot >= 0 && hasStrength[foeSlot] && shipStrength[foeSlot] > maxStrength)
 				continue;
 		}
 		
@@ -1330,7 +1363,7 @@ bool AI::FollowOrders(Ship &ship, Command &command) const
 		// The desired position is in a different system. Find the best
 		// way to reach that system (via wormhole or jumping). This may
 		// result in the ship landing to refuel.
-		SelectRoute(ship, it->second.targetSystem);
+		SelectRoute(ship, it->second.targetSystem, routes);
 		
 		// Travel there even if your parent is not planning to travel.
 		if(ship.GetTargetSystem())
@@ -1515,7 +1548,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 	// Choose the best method of reaching the target system, which may mean
 	// using a local wormhole rather than jumping. If this ship has chosen
 	// to land, this decision will not be altered.
-	SelectRoute(ship, ship.GetTargetSystem());
+	SelectRoute(ship, ship.GetTargetSystem(), routes);
 	
 	if(ship.GetTargetSystem())
 	{
@@ -1574,7 +1607,7 @@ void AI::MoveEscort(Ship &ship, Command &command) const
 		{
 			// Route to the parent ship's system and check whether
 			// the ship should land (refuel or wormhole) or jump.
-			SelectRoute(ship, parent.GetSystem());
+			SelectRoute(ship, parent.GetSystem(), routes);
 		}
 		
 		// Perform the action that this ship previously decided on.
@@ -1602,13 +1635,12 @@ void AI::MoveEscort(Ship &ship, Command &command) const
 	// If the parent is in-system and planning to jump, non-staying escorts should follow suit.
 	else if(parent.Commands().Has(Command::JUMP) && parent.GetTargetSystem() && !isStaying)
 	{
-		DistanceMap distance(ship, parent.GetTargetSystem());
-		const System *dest = distance.Route(ship.GetSystem());
+		const System *dest = routes.Get(ship, parent.GetTargetSystem()).Route(ship.GetSystem());
 		ship.SetTargetSystem(dest);
 		if(!dest)
 			// This ship has no route to the parent's destination system, so protect it until it jumps away.
 			KeepStation(ship, command, parent);
-		else if(ShouldRefuel(ship, dest))
+		else if(ShouldRefuel(ship, dest, routes))
 			Refuel(ship, command);
 		else if(!ship.JumpsRemaining())
 			// Return to the system center to maximize solar collection rate.
@@ -2220,9 +2252,9 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		if(target)
 		{
 			// Allow another swarming ship to consider the target.
-			auto sit = swarmCount.find(target.get());
-			if(sit != swarmCount.end() && sit->second > 0)
-				--sit->second;
+			int slot = FindSlot(*target);
+			if(slot >= 0 && swarmCount[slot] > 0)
+				--swarmCount[slot];
 			// Release the current target.
 			target.reset();
 			ship.SetTargetShip(target);
@@ -2238,7 +2270,7 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 			if(!other->GetPersonality().IsSwarming())
 			{
 				// Prefer to swarm ships that are not already being heavily swarmed.
-				int count = swarmCount[other.get()] + Random::Int(4);
+				int count = swarmCount[Slot(*other)] + Random::Int(4);
 				if(count < lowestCount)
 				{
 					target = other;
@@ -2247,7 +2279,7 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 			}
 		ship.SetTargetShip(target);
 		if(target)
-			++swarmCount[target.get()];
+			++swarmCount[Slot(*target)];
 	}
 	// If a friendly ship to flock with was not found, return to an available planet.
 	if(target)
@@ -2384,10 +2416,13 @@ void AI::DoMining(Ship &ship, Command &command)
 {
 	// This function is only called for ships that are in the player's system.
 	// Update the radius that the ship is searching for asteroids at.
-	bool isNew = !miningAngle.count(&ship);
-	Angle &angle = miningAngle[&ship];
-	if(isNew)
+	int slot = Slot(ship);
+	Angle &angle = miningAngle[slot];
+	if(!hasMiningAngle[slot])
+	{
 		angle = Angle::Random();
+		hasMiningAngle[slot] = true;
+	}
 	angle += Angle::Random(1.) - Angle::Random(1.);
 	double miningRadius = ship.GetSystem()->AsteroidBelt() * pow(2., angle.Unit().X());
 	
@@ -2553,7 +2588,8 @@ bool AI::DoCloak(Ship &ship, Command &command)
 				// TODO: This could use an "Avoid" method, to account for other in-system hazards.
 				// Simple approximation: move equally away from both the system center and the
 				// nearest enemy, until the constrainment boundary is reached.
-				if(ship.GetPersonality().IsUnconstrained() || !fenceCount.count(&ship))
+				int slot = FindSlot(ship);
+				if(ship.GetPersonality().IsUnconstrained() || slot < 0 || fenceCount[slot] < 0)
 					safety = 2 * ship.Position().Unit() - nearestEnemy->Position().Unit();
 				else
 					safety = -ship.Position().Unit();
@@ -2779,6 +2815,10 @@ void AI::AimTurrets(const Ship &ship, Command &command, bool opportunistic) cons
 		return;
 	}
 	// Each hardpoint should aim at the target that it is "closest" to hitting.
+	TargetKinematics kinematics;
+	for(const Body *target : targets)
+		kinematics.Add(*target);
+	vector<double> times;
 	for(const Hardpoint &hardpoint : ship.Weapons())
 		if(hardpoint.CanAim())
 		{
@@ -2796,20 +2836,17 @@ void AI::AimTurrets(const Ship &ship, Command &command, bool opportunistic) cons
 			// to aim at it and for a projectile to hit it.
 			double bestScore = numeric_limits<double>::infinity();
 			double bestAngle = 0.;
-			for(const Body *target : targets)
+			// Only take the ship's velocity into account if this weapon
+			// does not have its own acceleration. By the time this action is
+			// performed, the targets will have moved forward one time step.
+			kinematics.Update(start, weapon->Acceleration() ? Point() : ship.Velocity());
+			// Find out how long it would take for this projectile to reach each target.
+			kinematics.RendezvousTimes(vp, times);
+			for(size_t i = 0; i < kinematics.Size(); ++i)
 			{
-				Point p = target->Position() - start;
-				Point v = target->Velocity();
-				// Only take the ship's velocity into account if this weapon
-				// does not have its own acceleration.
-				if(!weapon->Acceleration())
-					v -= ship.Velocity();
-				// By the time this action is performed, the target will
-				// have moved forward one time step.
-				p += v;
-				
-				// Find out how long it would take for this projectile to reach the target.
-				double rendezvousTime = RendezvousTime(p, v, vp);
+				Point p = kinematics.RelativePosition(i);
+				Point v = kinematics.RelativeVelocity(i);
+				double rendezvousTime = times[i];
 				// If there is no intersection (i.e. the turret is not facing the target),
 				// consider this target "out-of-range" but still targetable.
 				if(std::isnan(rendezvousTime))
@@ -2912,6 +2949,20 @@ void AI::AutoFire(const Ship &ship, Command &command, bool secondary) const
 			&& find(enemies.cbegin(), enemies.cend(), currentTarget) == enemies.cend())
 		enemies.push_back(currentTarget);
 	
+	// Gather everything about the enemies that does not depend on which
+	// weapon is firing. Only fire on disabled targets if you don't want to
+	// plunder them, but NPCs shoot ships that they just plundered.
+	TargetKinematics kinematics;
+	vector<char> canFireAt;
+	vector<const Mask *> masks;
+	for(const auto &target : enemies)
+	{
+		bool hasBoarded = !ship.IsYours() && Has(ship, target, ShipEvent::BOARD);
+		canFireAt.push_back(!(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride));
+		kinematics.Add(*target);
+		masks.push_back(&target->GetMask(step));
+	}
+	
 	int index = -1;
 	for(const Hardpoint &hardpoint : ship.Weapons())
 	{
@@ -2989,36 +3040,31 @@ void AI::AutoFire(const Ship &ship, Command &command, bool secondary) const
 			}
 			continue;
 		}
-		// For non-homing weapons:
-		for(const auto &target : enemies)
+		// For non-homing weapons, only take the ship's velocity into account
+		// if this weapon does not have its own acceleration. By the time this
+		// action is performed, the ships will have moved forward one time step.
+		kinematics.Update(start, weapon->Acceleration() ? Point() : ship.Velocity());
+		// Get the vector the weapon will travel along.
+		Point aim = (ship.Facing() + hardpoint.GetAngle()).Unit() * vp;
+		for(size_t i = 0; i < enemies.size(); ++i)
 		{
-			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, target, ShipEvent::BOARD);
-			if(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
+			if(!canFireAt[i])
 				continue;
 			
-			Point p = target->Position() - start;
-			Point v = target->Velocity();
-			// Only take the ship's velocity into account if this weapon
-			// does not have its own acceleration.
-			if(!weapon->Acceleration())
-				v -= ship.Velocity();
-			// By the time this action is performed, the ships will have moved
-			// forward one time step.
-			p += v;
-			
 			// Non-homing weapons may have a blast radius or proximity trigger.
 			// Do not fire this weapon if we will be caught in the blast.
-			if(!weapon->IsSafe() && p.Length() <= (weapon->BlastRadius() + weapon->TriggerRadius()))
+			if(!weapon->IsSafe() && kinematics.Distance(i) <= (weapon->BlastRadius() + weapon->TriggerRadius()))
 				continue;
 			
-			// Get the vector the weapon will travel along.
-			v = (ship.Facing() + hardpoint.GetAngle()).Unit() * vp - v;
 			// Extrapolate over the lifetime of the projectile.
-			v *= lifetime;
+			Point v = (aim - kinematics.RelativeVelocity(i)) * lifetime;
+			// Skip the collision check if the target is too far away for this
+			// projectile to possibly reach it. This is the same test that
+			// Mask::Collide() starts with.
+			if(kinematics.Distance(i) > masks[i]->Radius() + v.Length())
+				continue;
 			
-			const Mask &mask = target->GetMask(step);
-			if(mask.Collide(-p, v, target->Facing()) < 1.)
+			if(masks[i]->Collide(-kinematics.RelativePosition(i), v, enemies[i]->Facing()) < 1.)
 			{
 				command.SetFire(index);
 				break;
@@ -3711,7 +3757,9 @@ void AI::UpdateStrengths(map<const Government *, int64_t> &strength, const Syste
 		if(!gov || it->GetSystem() != playerSystem || it->IsDisabled() || Random::Int(60))
 			continue;
 		
-		int64_t &myStrength = shipStrength[it.get()];
+		int slot = Slot(*it);
+		hasStrength[slot] = true;
+		int64_t &myStrength = shipStrength[slot];
 		for(const auto &allies : governmentRosters)
 		{
 			// If this is not an allied government, its ships will not assist this ship when attacked.
@@ -3748,6 +3796,40 @@ void AI::CacheShipLists()
 
 
 
+int AI::Slot(Ship &ship)
+{
+	int slot = FindSlot(ship);
+	if(slot >= 0)
+		return slot;
+	
+	// The ship has no entry yet, or its slot was handed out before the last
+	// call to Clean(). Either way, start it off with the default state.
+	slot = slotOwners.size();
+	ship.SetAISlot(slot);
+	slotOwners.push_back(&ship);
+	swarmCount.push_back(0);
+	fenceCount.push_back(-1);
+	miningAngle.emplace_back();
+	hasMiningAngle.push_back(false);
+	miningTime.push_back(0);
+	appeasmentThreshold.push_back(0.);
+	shipStrength.push_back(0);
+	hasStrength.push_back(false);
+	return slot;
+}
+
+
+
+int AI::FindSlot(const Ship &ship) const
+{
+	int slot = ship.AISlot();
+	if(slot < 0 || static_cast<size_t>(slot) >= slotOwners.size() || slotOwners[slot] != &ship)
+		return -1;
+	return slot;
+}
+
+
+
 void AI::IssueOrders(const PlayerInfo &player, const Orders &newOrders, const string &description)
 {
 	string who;
@@ -3890,3 +3972,99 @@ void AI::UpdateOrders(const Ship &ship)
 		order.targetSystem = ship.GetSystem();
 	}
 }
+
+
+
+namespace {
+	// Record the position and velocity of a potential target.
+	void TargetKinematics::Add(const Body &body)
+	{
+		x.push_back(body.Position().X());
+		y.push_back(body.Position().Y());
+		vx.push_back(body.Velocity().X());
+		vy.push_back(body.Velocity().Y());
+	}
+	
+	
+	
+	size_t TargetKinematics::Size() const
+	{
+		return x.size();
+	}
+	
+	
+	
+	// Find where each target will be one step from now relative to the given
+	// firing point, and its velocity relative to the given velocity.
+	void TargetKinematics::Update(const Point &start, const Point &velocity)
+	{
+		size_t size = x.size();
+		px.resize(size);
+		py.resize(size);
+		rvx.resize(size);
+		rvy.resize(size);
+		distance.resize(size);
+		
+		// The arithmetic is done in the same order as with Points, so that
+		// the results are exactly the same.
+		const double sx = start.X();
+		const double sy = start.Y();
+		const double svx = velocity.X();
+		const double svy = velocity.Y();
+		for(size_t i = 0; i < size; ++i)
+		{
+			rvx[i] = vx[i] - svx;
+			rvy[i] = vy[i] - svy;
+			px[i] = (x[i] - sx) + rvx[i];
+			py[i] = (y[i] - sy) + rvy[i];
+			distance[i] = px[i] * px[i] + py[i] * py[i];
+		}
+		for(size_t i = 0; i < size; ++i)
+			distance[i] = sqrt(distance[i]);
+	}
+	
+	
+	
+	// This is the same calculation as AI::RendezvousTime(), but with no
+	// branches, so that it can be done for all the targets at once.
+	void TargetKinematics::RendezvousTimes(double vp, vector<double> &times) const
+	{
+		size_t size = x.size();
+		times.resize(size);
+		const double NaN = numeric_limits<double>::quiet_NaN();
+		for(size_t i = 0; i < size; ++i)
+		{
+			double a = (rvx[i] * rvx[i] + rvy[i] * rvy[i]) - vp * vp;
+			double b = 2. * (px[i] * rvx[i] + py[i] * rvy[i]);
+			double c = px[i] * px[i] + py[i] * py[i];
+			double discriminant = b * b - 4 * a * c;
+			double root = sqrt(max(discriminant, 0.));
+			double r1 = (-b + root) / (2. * a);
+			double r2 = (-b - root) / (2. * a);
+			double t = (r1 >= 0. && r2 >= 0.) ? min(r1, r2) : (r1 >= 0. || r2 >= 0.) ? max(r1, r2) : NaN;
+			times[i] = (discriminant < 0.) ? NaN : t;
+		}
+	}
+	
+	
+	
+	Point TargetKinematics::RelativePosition(size_t i) const
+	{
+		return Point(px[i], py[i]);
+	}
+	
+	
+	
+	Point TargetKinematics::RelativeVelocity(size_t i) const
+	{
+		return Point(rvx[i], rvy[i]);
+	}
+	
+	
+	
+	double TargetKinematics::Distance(size_t i) const
+	{
+		return distance[i];
+	}
+	
+}
@@ -13,8 +13,10 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef AI_H_
 #define AI_H_
 
+#include "Angle.h"
 #include "Command.h"
 #include "Point.h"
+#include "RouteCache.h"
 
 #include <cstdint>
 #include <list>
@@ -22,7 +24,6 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <memory>
 #include <vector>
 
-class Angle;
 class AsteroidField;
 class Body;
 class Flotsam;
@@ -57,7 +58,7 @@ template <class Type>
 	void UpdateKeys(PlayerInfo &player, Command &clickCommands);
 	
 	// Allow the AI to track any events it is interested in.
-	void UpdateEvents(const std::list<ShipEvent> &events);
+	void UpdateEvents(const std::vector<ShipEvent> &events);
 	// Reset the AI's memory of events.
 	void Clean();
 	// Clear ship orders. This should be done when the player lands on a planet,
@@ -146,6 +147,12 @@ private:
 	void UpdateStrengths(std::map<const Government *, int64_t> &strength, const System *playerSystem);
 	void CacheShipLists();
 	
+	// Get the index of the given ship's entry in the per-ship arrays, giving it
+	// a new entry if it does not have one yet.
+	int Slot(Ship &ship);
+	// Get the index of the given ship's entry, or -1 if it does not have one.
+	int FindSlot(const Ship &ship) const;
+	
 	
 private:
 	class Orders {
@@ -207,13 +214,26 @@ private:
 	std::map<const Government *, bool> scanPermissions;
 	std::map<std::weak_ptr<const Ship>, int, Comp> playerActions;
 	std::map<const Ship *, std::weak_ptr<Ship>> helperList;
-	std::map<const Ship *, int> swarmCount;
-	std::map<const Ship *, int> fenceCount;
-	std::map<const Ship *, Angle> miningAngle;
-	std::map<const Ship *, int> miningTime;
-	std::map<const Ship *, double> appeasmentThreshold;
 	
-	std::map<const Ship *, int64_t> shipStrength;
+	// Bookkeeping for individual ships, stored in parallel arrays indexed by
+	// each ship's AI slot. The slots are only handed out again after Clean(),
+	// so the owner of each one is recorded to catch ships whose slot is stale.
+	std::vector<const Ship *> slotOwners;
+	std::vector<int> swarmCount;
+	// The time each ship has spent beyond the "invisible fence," or -1 if it
+	// has not been out there recently.
+	std::vector<int> fenceCount;
+	std::vector<Angle> miningAngle;
+	std::vector<char> hasMiningAngle;
+	std::vector<int> miningTime;
+	std::vector<double> appeasmentThreshold;
+	std::vector<int64_t> shipStrength;
+	std::vector<char> hasStrength;
+	
+	// Routes to other systems, shared by all ships with the same destination
+	// and drives. Events can only change the hyperspace links when the player
+	// enters a new system, which is also when this is cleared.
+	mutable RouteCache routes;
 	
 	std::map<const Government *, int64_t> enemyStrength;
 	std::map<const Government *, int64_t> allyStrength;
@@ -251,15 +251,17 @@ void BankPanel::Draw()
 		table.Draw("[apply]", selected);
 	}
 	
+	static const int CAN_PAY = Information::ConditionSlot("can pay");
+	
 	// Draw the "Pay All" button.
 	const Interface *bankUi = GameData::Interfaces().Get("bank");
 	Information info;
 	if((salariesOwed || maintenanceDue) && player.Accounts().Credits() > 0)
-		info.SetCondition("can pay");
+		info.SetCondition(CAN_PAY);
 	else
 		for(const Mortgage &mortgage : player.Accounts().Mortgages())
 			if(mortgage.Principal() <= player.Accounts().Credits())
-				info.SetCondition("can pay");
+				info.SetCondition(CAN_PAY);
 	bankUi->Draw(info, this);
 }
 
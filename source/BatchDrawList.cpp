@@ -30,6 +30,9 @@ namespace {
 		v.push_back(t);
 		v.push_back(frame);
 	}
+	
+	// The number of floats in the data for each sprite.
+	const size_t SPRITE_SIZE = 6 * 5;
 }
 
 
@@ -45,9 +48,10 @@ void BatchDrawList::Clear(int step, double zoom)
 
 
 
-void BatchDrawList::SetCenter(const Point &center)
+void BatchDrawList::SetCenter(const Point &center, const Point &centerVelocity)
 {
 	this->center = center;
+	this->centerVelocity = centerVelocity;
 }
 
 
@@ -65,43 +69,79 @@ bool BatchDrawList::Add(const Body &body, float clip)
 	// we want it to be drawn with its center halfway to the target. For longer-lived projectiles, we
 	// expect the position to be the actual location of the projectile at that point in time.
 	Point position = (body.Position() + .5 * body.Velocity() - center) * zoom;
-	return Add(body, position, clip);
+	if(!body.HasSprite() || !body.Zoom())
+		return false;
+	Point unit = body.Unit();
+	double width = body.Width();
+	double height = body.Height();
+	if(Cull(position, unit, width, height))
+		return false;
+	
+	AddSprite(body.GetSprite(), body.GetFrame(step), position, body.Velocity(), unit, width, height, clip);
+	return true;
 }
 
 
 
-// TODO: Once we have sprite reference positions, this method will not be needed.
-bool BatchDrawList::AddVisual(const Body &visual)
+// Add a particle: a sprite at the default zoom, drawn at its exact position
+// rather than one offset by its velocity.
+// TODO: Once we have sprite reference positions, this method will not need to
+// differ from Add().
+bool BatchDrawList::AddParticle(const Sprite *sprite, const Point &position, const Point &velocity, const Angle &facing, float frame)
 {
-	return Add(visual, (visual.Position() - center) * zoom, 1.f);
+	// This is the same size a Body with this sprite and a zoom of 1 would have.
+	Point unit = facing.Unit() * .5;
+	double width = .5f * sprite->Width();
+	double height = .5f * sprite->Height();
+	Point screenPosition = (position - center) * zoom;
+	if(Cull(screenPosition, unit, width, height))
+		return false;
+	
+	AddSprite(sprite, frame, screenPosition, velocity, unit, width, height, 1.f);
+	return true;
 }
 
 
 
 // Draw all the items in this list.
-void BatchDrawList::Draw() const
+void BatchDrawList::Draw(double interpolation) const
 {
 	BatchShader::Bind();
 	
-	for(const pair<const Sprite * const, vector<float>> &it : data)
-		BatchShader::Add(it.first, isHighDPI, it.second);
+	vector<float> moved;
+	for(const auto &it : data)
+	{
+		const Batch &batch = it.second;
+		if(!interpolation)
+		{
+			BatchShader::Add(it.first, batch.frames, batch.vertices);
+			continue;
+		}
+		
+		// Move every vertex of each sprite the given fraction of a step along
+		// that sprite's velocity.
+		moved = batch.vertices;
+		for(size_t i = 0; i < moved.size(); i += 5)
+		{
+			const float *velocity = &batch.velocities[2 * (i / SPRITE_SIZE)];
+			moved[i] += static_cast<float>(velocity[0] * interpolation);
+			moved[i + 1] += static_cast<float>(velocity[1] * interpolation);
+		}
+		BatchShader::Add(it.first, batch.frames, moved);
+	}
 	
 	BatchShader::Unbind();
 }
 
 
 
-bool BatchDrawList::Cull(const Body &body, const Point &position) const
+bool BatchDrawList::Cull(const Point &position, const Point &unit, double width, double height) const
 {
-	if(!body.HasSprite() || !body.Zoom())
-		return true;
-	
-	Point unit = body.Unit();
 	// Cull sprites that are completely off screen, to reduce the number of draw
 	// calls that we issue (which may be the bottleneck on some systems).
 	Point size(
-		fabs(unit.X() * body.Height()) + fabs(unit.Y() * body.Width()),
-		fabs(unit.X() * body.Width()) + fabs(unit.Y() * body.Height()));
+		fabs(unit.X() * height) + fabs(unit.Y() * width),
+		fabs(unit.X() * width) + fabs(unit.Y() * height));
 	Point topLeft = position - size * zoom;
 	Point bottomRight = position + size * zoom;
 	if(bottomRight.X() < Screen::Left() || bottomRight.Y() < Screen::Top())
@@ -114,20 +154,26 @@ bool BatchDrawList::Cull(const Body &body, const Point &position) const
 
 
 
-bool BatchDrawList::Add(const Body &body, Point position, float clip)
+void BatchDrawList::AddSprite(const Sprite *sprite, float frame, const Point &position, const Point &velocity, Point unit, double width, double height, float clip)
 {
-	if(Cull(body, position))
-		return false;
-	
-	// Get the data vector for this particular sprite.
-	vector<float> &v = data[body.GetSprite()];
-	// The sprite frame is the same for every vertex.
-	float frame = body.GetFrame(step);
+	// Get the data for this sprite's texture.
+	Batch &batch = data[sprite->Texture(isHighDPI)];
+	batch.frames = sprite->Frames();
+	vector<float> &v = batch.vertices;
+	Point screenVelocity = (velocity - centerVelocity) * zoom;
+	batch.velocities.push_back(screenVelocity.X());
+	batch.velocities.push_back(screenVelocity.Y());
+	// Get the area of the texture that this sprite uses.
+	const float *rect = sprite->TextureRect(isHighDPI);
+	float left = rect[0];
+	float top = rect[1];
+	float textureWidth = rect[2] - rect[0];
+	float textureHeight = rect[3] - rect[1];
 	
 	// Get unit vectors in the direction of the object's width and height.
-	Point unit = body.Unit() * zoom;
-	Point uw = Point(unit.Y(), -unit.X()) * body.Width();
-	Point uh = unit * body.Height();
+	unit *= zoom;
+	Point uw = Point(unit.Y(), -unit.X()) * width;
+	Point uh = unit * height;
 	
 	// Get the "bottom" corner, the one that won't be clipped.
 	Point topLeft = position - (uw + uh);
@@ -142,12 +188,13 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 	
 	// Push two copies of the first and last vertices to mark the break between
 	// the sprites.
-	Push(v, topLeft, 0.f, 1.f, frame);
-	Push(v, topLeft, 0.f, 1.f, frame);
-	Push(v, topRight, 1.f, 1.f, frame);
-	Push(v, bottomLeft, 0.f, 1.f - clip, frame);
-	Push(v, bottomRight, 1.f, 1.f - clip, frame);
-	Push(v, bottomRight, 1.f, 1.f - clip, frame);
-	
-	return true;
+	float right = left + textureWidth;
+	float bottom = top + textureHeight;
+	float clipTop = top + textureHeight * (1.f - clip);
+	Push(v, topLeft, left, bottom, frame);
+	Push(v, topLeft, left, bottom, frame);
+	Push(v, topRight, right, bottom, frame);
+	Push(v, bottomLeft, left, clipTop, frame);
+	Push(v, bottomRight, right, clipTop, frame);
+	Push(v, bottomRight, right, clipTop, frame);
 }
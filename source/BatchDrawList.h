@@ -13,8 +13,10 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef BATCH_DRAW_LIST_H_
 #define BATCH_DRAW_LIST_H_
 
+#include "Angle.h"
 #include "Point.h"
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -24,27 +26,32 @@ class Sprite;
 
 
 // This class collects a set of OpenGL draw commands to issue and groups them by
-// sprite, so all instances of each sprite can be drawn with a single command.
+// texture, so all instances of each sprite, and of any other sprites sharing
+// its texture, can be drawn with a single command.
 class BatchDrawList {
 public:
 	// Clear the list, also setting the global time step for animation.
 	void Clear(int step = 0, double zoom = 1.);
-	void SetCenter(const Point &center);
+	void SetCenter(const Point &center, const Point &centerVelocity = Point());
 	
 	// Add an unswizzled object based on the Body class.
 	bool Add(const Body &body, float clip = 1.f);
-	bool AddVisual(const Body &visual);
+	// Add a particle: a sprite at the default zoom, drawn at its exact position
+	// rather than one offset by its velocity.
+	bool AddParticle(const Sprite *sprite, const Point &position, const Point &velocity, const Angle &facing, float frame);
 	
-	// Draw all the items in this list.
-	void Draw() const;
+	// Draw all the items in this list. If the interpolation is not zero, each
+	// item is drawn that fraction of a step further along its velocity.
+	void Draw(double interpolation = 0.) const;
 	
 	
 private:
-	// Determine if the given body should be drawn at all.
-	bool Cull(const Body &body, const Point &position) const;
+	// Determine if a sprite with the given half-size, orientation, and screen
+	// position should be drawn at all.
+	bool Cull(const Point &position, const Point &unit, double width, double height) const;
 	
-	// Add the given body at the given position.
-	bool Add(const Body &body, Point position, float clip);
+	// Add the vertices of the given sprite, which has already passed culling.
+	void AddSprite(const Sprite *sprite, float frame, const Point &position, const Point &velocity, Point unit, double width, double height, float clip);
 	
 	
 private:
@@ -52,12 +59,21 @@ private:
 	double zoom = 1.;
 	bool isHighDPI = false;
 	Point center;
+	Point centerVelocity;
 	
-	// Each sprite consists of six vertices (four vertices to form a quad and
-	// two dummy vertices to mark the break in between them). Each of those
-	// vertices has five attributes: (x, y) position in pixels, (s, t) texture
-	// coordinates, and the index of the sprite frame.
-	std::map<const Sprite *, std::vector<float>> data;
+	class Batch {
+	public:
+		int frames = 1;
+		// Each sprite consists of six vertices (four vertices to form a quad and
+		// two dummy vertices to mark the break in between them). Each of those
+		// vertices has five attributes: (x, y) position in pixels, (s, t) texture
+		// coordinates, and the index of the sprite frame.
+		std::vector<float> vertices;
+		// The (x, y) velocity of each sprite relative to the center, in pixels.
+		std::vector<float> velocities;
+	};
+	// The sprites drawn with each texture.
+	std::map<uint32_t, Batch> data;
 };
 
 
@@ -14,7 +14,6 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "Screen.h"
 #include "Shader.h"
-#include "Sprite.h"
 
 using namespace std;
 
@@ -118,16 +117,16 @@ void BatchShader::Bind()
 
 
 
-void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const vector<float> &data)
+void BatchShader::Add(uint32_t texture, int frames, const vector<float> &data)
 {
 	// Do nothing if there are no sprites to draw.
 	if(data.empty())
 		return;
 	
 	// First, bind the proper texture.
-	glBindTexture(GL_TEXTURE_2D_ARRAY, sprite->Texture(isHighDPI));
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
 	// The shader also needs to know how many frames the texture has.
-	glUniform1f(frameCountI, sprite->Frames());
+	glUniform1f(frameCountI, frames);
 	
 	// Upload the vertex data.
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * data.size(), data.data(), GL_STREAM_DRAW);
@@ -13,21 +13,21 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef BATCH_SHADER_H_
 #define BATCH_SHADER_H_
 
-class Sprite;
-
+#include <cstdint>
 #include <vector>
 
 
 
 // Class for drawing sprites in a batch. The input to each draw command is a
-// sprite, whether it should be drawn high DPI, and the vertex data.
+// texture, its number of frames, and the vertex data. Sprites that share a
+// texture (see SpriteAtlas) can all be drawn with a single command.
 class BatchShader {
 public:
 	// Initialize the shaders.
 	static void Init();
 	
 	static void Bind();
-	static void Add(const Sprite *sprite, bool isHighDPI, const std::vector<float> &data);
+	static void Add(uint32_t texture, int frames, const std::vector<float> &data);
 	static void Unbind();
 };
 
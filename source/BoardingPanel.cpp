@@ -152,38 +152,55 @@ void BoardingPanel::Draw()
 		font.Draw({item.Size(), {330, Alignment::RIGHT}}, pos, color);
 	}
 	
+	static const int CAN_EXIT = Information::ConditionSlot("can exit");
+	static const int CAN_TAKE = Information::ConditionSlot("can take");
+	static const int CAN_CAPTURE = Information::ConditionSlot("can capture");
+	static const int CAN_ATTACK = Information::ConditionSlot("can attack");
+	static const int CAN_DEFEND = Information::ConditionSlot("can defend");
+	static const int CARGO_SPACE = Information::StringSlot("cargo space");
+	static const int YOUR_CREW = Information::StringSlot("your crew");
+	static const int YOUR_ATTACK = Information::StringSlot("your attack");
+	static const int YOUR_DEFENSE = Information::StringSlot("your defense");
+	static const int ENEMY_CREW = Information::StringSlot("enemy crew");
+	static const int ENEMY_ATTACK = Information::StringSlot("enemy attack");
+	static const int ENEMY_DEFENSE = Information::StringSlot("enemy defense");
+	static const int ATTACK_ODDS = Information::StringSlot("attack odds");
+	static const int ATTACK_CASUALTIES = Information::StringSlot("attack casualties");
+	static const int DEFENSE_ODDS = Information::StringSlot("defense odds");
+	static const int DEFENSE_CASUALTIES = Information::StringSlot("defense casualties");
+	
 	// Set which buttons are active.
 	Information info;
 	if(CanExit())
-		info.SetCondition("can exit");
+		info.SetCondition(CAN_EXIT);
 	if(CanTake())
-		info.SetCondition("can take");
+		info.SetCondition(CAN_TAKE);
 	if(CanCapture())
-		info.SetCondition("can capture");
+		info.SetCondition(CAN_CAPTURE);
 	if(CanAttack() && (you->Crew() > 1 || !victim->RequiredCrew()))
-		info.SetCondition("can attack");
+		info.SetCondition(CAN_ATTACK);
 	if(CanAttack())
-		info.SetCondition("can defend");
+		info.SetCondition(CAN_DEFEND);
 	
 	// This should always be true, but double check.
 	int crew = 0;
 	if(you)
 	{
 		crew = you->Crew();
-		info.SetString("cargo space", to_string(you->Cargo().Free()));
-		info.SetString("your crew", to_string(crew));
-		info.SetString("your attack",
+		info.SetString(CARGO_SPACE, to_string(you->Cargo().Free()));
+		info.SetString(YOUR_CREW, to_string(crew));
+		info.SetString(YOUR_ATTACK,
 			Round(attackOdds.AttackerPower(crew)));
-		info.SetString("your defense",
+		info.SetString(YOUR_DEFENSE,
 			Round(defenseOdds.DefenderPower(crew)));
 	}
 	int vCrew = victim ? victim->Crew() : 0;
 	if(victim && (victim->IsCapturable() || victim->IsYours()))
 	{
-		info.SetString("enemy crew", to_string(vCrew));
-		info.SetString("enemy attack",
+		info.SetString(ENEMY_CREW, to_string(vCrew));
+		info.SetString(ENEMY_ATTACK,
 			Round(defenseOdds.AttackerPower(vCrew)));
-		info.SetString("enemy defense",
+		info.SetString(ENEMY_DEFENSE,
 			Round(attackOdds.DefenderPower(vCrew)));
 	}
 	if(victim && victim->IsCapturable() && !victim->IsYours())
@@ -194,13 +211,13 @@ void BoardingPanel::Draw()
 		double odds = attackOdds.Odds(crew, vCrew);
 		if(!isCapturing)
 			odds *= (1. - victim->Attributes().Get("self destruct"));
-		info.SetString("attack odds",
+		info.SetString(ATTACK_ODDS,
 			Round(100. * odds) + "%");
-		info.SetString("attack casualties",
+		info.SetString(ATTACK_CASUALTIES,
 			Round(attackOdds.AttackerCasualties(crew, vCrew)));
-		info.SetString("defense odds",
+		info.SetString(DEFENSE_ODDS,
 			Round(100. * (1. - defenseOdds.Odds(vCrew, crew))) + "%");
-		info.SetString("defense casualties",
+		info.SetString(DEFENSE_CASUALTIES,
 			Round(defenseOdds.DefenderCasualties(vCrew, crew)));
 	}
 	
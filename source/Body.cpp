@@ -340,9 +340,24 @@ void Body::SetStep(int step) const
 		frameOffset -= frameRate * step;
 	}
 	
-	// Figure out what fraction of the way in between frames we are. Avoid any
-	// possible floating-point glitches that might result in a negative frame.
-	frame = max(0.f, frameRate * step + frameOffset);
+	// Figure out what fraction of the way in between frames we are.
+	frame = WrapFrame(frameRate * step + frameOffset, frames, cycle, repeat, rewind);
+}
+
+
+
+// Map an unbounded frame index onto an animation with the given number of
+// frames and cycle length, according to its repeat and rewind settings.
+float Body::WrapFrame(float frame, float frames, float cycle, bool repeat, bool rewind)
+{
+	// If the sprite only has one frame, no need to animate anything.
+	if(frames <= 1.f)
+		return 0.f;
+	float lastFrame = frames - 1.f;
+	
+	// Avoid any possible floating-point glitches that might result in a
+	// negative frame.
+	frame = max(0.f, frame);
 	// If repeating, wrap the frame index by the total cycle time.
 	if(repeat)
 		frame = fmod(frame, cycle);
@@ -366,4 +381,5 @@ void Body::SetStep(int step) const
 		// be less than 0, clamp it to 0.
 		frame = max(0.f, lastFrame * 2.f - frame);
 	}
+	return frame;
 }
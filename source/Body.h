@@ -102,6 +102,9 @@ private:
 	// Set what animation step we're on. This affects future calls to GetMask()
 	// and GetFrame().
 	void SetStep(int step) const;
+	// Map an unbounded frame index onto an animation with the given number of
+	// frames and cycle length, according to its repeat and rewind settings.
+	static float WrapFrame(float frame, float frames, float cycle, bool repeat, bool rewind);
 	
 	
 private:
@@ -127,6 +130,9 @@ private:
 	// the same step over and over again.
 	mutable int currentStep = -1;
 	mutable float frame = 0.f;
+	
+	// Allow the particle system to copy the animation of a Visual.
+	friend class ParticleSystem;
 };
 
 
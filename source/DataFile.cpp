@@ -13,7 +13,10 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "DataFile.h"
 
 #include "Files.h"
-#include "text/Utf8.h"
+#include "Gzip.h"
+#include "MappedFile.h"
+
+#include <algorithm>
 
 using namespace std;
 
@@ -38,19 +41,25 @@ DataFile::DataFile(istream &in)
 // Load from a file path (in UTF-8).
 void DataFile::Load(const string &path)
 {
-	string data = Files::Read(path);
-	if(data.empty())
+	// Parse the file straight out of the page cache, without copying it.
+	MappedFile file(path);
+	if(!file.Size())
 		return;
 	
-	// As a sentinel, make sure the file always ends in a newline.
-	if(data.empty() || data.back() != '\n')
-		data.push_back('\n');
-	
 	// Note what file this node is in, so it will show up in error traces.
 	root.tokens.push_back("file");
 	root.tokens.push_back(path);
 	
-	LoadData(data);
+	// Saved games may be compressed.
+	if(Gzip::IsCompressed(string(file.Data(), min<size_t>(file.Size(), 2))))
+	{
+		string data = Gzip::Decompress(string(file.Data(), file.Size()));
+		if(data.empty())
+			Files::LogError("Error: unable to decompress \"" + path + "\".");
+		LoadData(data.data(), data.size());
+	}
+	else
+		LoadData(file.Data(), file.Size());
 }
 
 
@@ -68,11 +77,8 @@ void DataFile::Load(istream &in)
 		in.read(&*data.begin() + currentSize, BLOCK);
 		data.resize(currentSize + in.gcount());
 	}
-	// As a sentinel, make sure the file always ends in a newline.
-	if(data.empty() || data.back() != '\n')
-		data.push_back('\n');
 	
-	LoadData(data);
+	LoadData(data.data(), data.size());
 }
 
 
@@ -93,8 +99,8 @@ list<DataNode>::const_iterator DataFile::end() const
 
 
 
-// Parse the given text.
-void DataFile::LoadData(const string &data)
+// Parse the given text. It does not need to end in a newline.
+void DataFile::LoadData(const char *data, size_t size)
 {
 	// Keep track of the current stack of indentation levels and the most recent
 	// node at each level - that is, the node that will be the "parent" of any
@@ -105,12 +111,22 @@ void DataFile::LoadData(const string &data)
 	bool warned = false;
 	size_t lineNumber = 0;
 	
-	size_t end = data.length();
-	for(size_t pos = 0; pos < end; )
+	// The parser only needs to recognize whitespace, quotes, comments, and line
+	// breaks, all of which are ASCII. Every byte of a multi-byte UTF-8 character
+	// is above 0x7F, so the text can be scanned one byte at a time, and none of
+	// those bytes will be mistaken for a delimiter. The end of the text counts
+	// as the end of a line, so the last line need not end in a newline.
+	size_t pos = 0;
+	auto next = [data, size, &pos]() -> unsigned char
+	{
+		return (pos < size) ? data[pos++] : '\n';
+	};
+	
+	while(pos < size)
 	{
 		++lineNumber;
 		size_t tokenPos = pos;
-		char32_t c = Utf8::DecodeCodePoint(data, pos);
+		unsigned char c = next();
 		
 		// Find the first non-white character in this line.
 		bool isSpaces = false;
@@ -136,13 +152,13 @@ void DataFile::LoadData(const string &data)
 			
 			++white;
 			tokenPos = pos;
-			c = Utf8::DecodeCodePoint(data, pos);
+			c = next();
 		}
 		
 		// If the line is a comment, skip to the end of the line.
 		if(c == '#')
 			while(c != '\n')
-				c = Utf8::DecodeCodePoint(data, pos);
+				c = next();
 		// Skip empty lines (including comment lines).
 		if(c == '\n')
 			continue;
@@ -170,12 +186,12 @@ void DataFile::LoadData(const string &data)
 		{
 			// Check if this token begins with a quotation mark. If so, it will
 			// include everything up to the next instance of that mark.
-			char32_t endQuote = c;
+			unsigned char endQuote = c;
 			bool isQuoted = (endQuote == '"' || endQuote == '`');
 			if(isQuoted)
 			{
 				tokenPos = pos;
-				c = Utf8::DecodeCodePoint(data, pos);
+				c = next();
 			}
 			
 			size_t endPos = tokenPos;
@@ -184,7 +200,7 @@ void DataFile::LoadData(const string &data)
 			while(c != '\n' && (isQuoted ? (c != endQuote) : (c > ' ')))
 			{
 				endPos = pos;
-				c = Utf8::DecodeCodePoint(data, pos);
+				c = next();
 			}
 			
 			// It ought to be legal to construct a string from an empty iterator
@@ -193,7 +209,7 @@ void DataFile::LoadData(const string &data)
 			if(tokenPos == endPos)
 				node.tokens.emplace_back();
 			else
-				node.tokens.emplace_back(data, tokenPos, endPos - tokenPos);
+				node.tokens.emplace_back(data + tokenPos, endPos - tokenPos);
 			// This is not a fatal error, but it may indicate a format mistake:
 			if(isQuoted && c == '\n')
 				node.PrintTrace("Closing quotation mark is missing:");
@@ -205,12 +221,12 @@ void DataFile::LoadData(const string &data)
 				if(isQuoted)
 				{
 					tokenPos = pos;
-					c = Utf8::DecodeCodePoint(data, pos);
+					c = next();
 				}
 				while(c != '\n' && c <= ' ' && c != '#')
 				{
 					tokenPos = pos;
-					c = Utf8::DecodeCodePoint(data, pos);
+					c = next();
 				}
 				
 				// If a comment is encountered outside of a token, skip the rest
@@ -218,7 +234,7 @@ void DataFile::LoadData(const string &data)
 				if(c == '#')
 				{
 					while(c != '\n')
-						c = Utf8::DecodeCodePoint(data, pos);
+						c = next();
 				}
 			}
 		}
@@ -15,6 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "DataNode.h"
 
+#include <cstddef>
 #include <istream>
 #include <list>
 #include <string>
@@ -43,7 +44,7 @@ public:
 	
 	
 private:
-	void LoadData(const std::string &data);
+	void LoadData(const char *data, std::size_t size);
 	
 	
 private:
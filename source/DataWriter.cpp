@@ -34,10 +34,32 @@ DataWriter::DataWriter(const string &path)
 
 
 
+// Constructor for writing to a string instead of a file.
+DataWriter::DataWriter()
+	: before(&indent)
+{
+	out.precision(8);
+}
+
+
+
 // Destructor, which saves the file all in one block.
 DataWriter::~DataWriter()
 {
-	Files::Write(path, out.str());
+	if(!path.empty())
+		Files::Write(path, out.str());
+}
+
+
+
+// Get the text that has been written so far.
+string DataWriter::SaveToString()
+{
+	string text = out.str();
+	out.str(string());
+	indent.clear();
+	before = &indent;
+	return text;
 }
 
 
@@ -32,6 +32,9 @@ class DataWriter {
 public:
 	// Constructor, specifying the file to write.
 	explicit DataWriter(const std::string &path);
+	// Constructor for composing the text in memory without writing it to any
+	// file. Use SaveToString() to retrieve it.
+	DataWriter();
 	DataWriter(const DataWriter &) = delete;
 	DataWriter(DataWriter &&) = delete;
 	DataWriter &operator=(const DataWriter &) = delete;
@@ -40,6 +43,9 @@ public:
 	// it possible to write the whole file in a single chunk.
 	~DataWriter();
 	
+	// Get the text written so far, and start over with an empty buffer.
+	std::string SaveToString();
+	
 	// The Write() function can take any number of arguments. Each argument is
 	// converted to a token. Arguments may be strings or numeric values.
 	template <class A, class ...B>
@@ -69,7 +75,7 @@ public:
 	
 	
 private:
-	// Save path (in UTF-8).
+	// Save path (in UTF-8). If this is empty, nothing is written to disk.
 	std::string path;
 	// Current indentation level.
 	std::string indent;
@@ -18,10 +18,78 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "StellarObject.h"
 #include "System.h"
 
+#include <algorithm>
+
 using namespace std;
 
 
 
+// The best path found so far to each system is only valid if that system's
+// stamp matches the current search's epoch, so starting a new search never
+// requires clearing the arrays.
+class DistanceMap::Workspace {
+public:
+	// Start a new search.
+	void Reset();
+	// Get the best path found so far to the given system, if any.
+	Edge *Find(const System &system);
+	// Record a new best path to the given system.
+	void Set(const System &system, const Edge &edge);
+	
+public:
+	// The systems reached in this search, in the order they were found.
+	vector<const System *> found;
+	// The paths waiting to be explored, stored as a heap.
+	vector<Edge> edges;
+	
+private:
+	vector<Edge> best;
+	vector<unsigned> stamp;
+	unsigned epoch = 0;
+};
+
+
+
+void DistanceMap::Workspace::Reset()
+{
+	found.clear();
+	edges.clear();
+	// If the epoch wraps around, old stamps could be mistaken for new ones.
+	if(!++epoch)
+	{
+		fill(stamp.begin(), stamp.end(), 0);
+		epoch = 1;
+	}
+}
+
+
+
+DistanceMap::Edge *DistanceMap::Workspace::Find(const System &system)
+{
+	size_t index = system.Index();
+	return (index < stamp.size() && stamp[index] == epoch) ? &best[index] : nullptr;
+}
+
+
+
+void DistanceMap::Workspace::Set(const System &system, const Edge &edge)
+{
+	size_t index = system.Index();
+	if(index >= stamp.size())
+	{
+		stamp.resize(index + 1, 0);
+		best.resize(index + 1);
+	}
+	if(stamp[index] != epoch)
+	{
+		stamp[index] = epoch;
+		found.push_back(&system);
+	}
+	best[index] = edge;
+}
+
+
+
 // Find paths to the given system. If the given maximum count is above zero,
 // it is a limit on how many systems should be returned. If it is below zero
 // it specifies the maximum distance away that paths should be found.
@@ -63,7 +131,7 @@ DistanceMap::DistanceMap(const PlayerInfo &player, const System *center)
 // ship will use a jump drive or hyperdrive depending on what it has. The
 // pathfinding will stop once a path to the destination is found.
 DistanceMap::DistanceMap(const Ship &ship, const System *destination)
-	: source(ship.GetSystem()), center(destination)
+	: source(ship.GetSystem()), center(destination), toCenter(true)
 {
 	if(!source || !destination)
 		return;
@@ -73,10 +141,21 @@ DistanceMap::DistanceMap(const Ship &ship, const System *destination)
 
 
 
+// Calculate the paths that the given ship, or any ship with the same drives
+// and access to the same wormholes, would take to get to the destination
+// from every system that can reach it.
+DistanceMap::DistanceMap(const System *destination, const Ship &ship)
+	: center(destination), toCenter(true)
+{
+	Init(&ship);
+}
+
+
+
 // Find out if the given system is reachable.
 bool DistanceMap::HasRoute(const System *system) const
 {
-	return route.count(system);
+	return Find(system);
 }
 
 
@@ -84,8 +163,8 @@ bool DistanceMap::HasRoute(const System *system) const
 // Find out how many days away the given system is.
 int DistanceMap::Days(const System *system) const
 {
-	auto it = route.find(system);
-	return (it == route.end() ? -1 : it->second.days);
+	const Edge *edge = Find(system);
+	return (edge ? edge->days : -1);
 }
 
 
@@ -93,8 +172,8 @@ int DistanceMap::Days(const System *system) const
 // Starting in the given system, what is the next system along the route?
 const System *DistanceMap::Route(const System *system) const
 {
-	auto it = route.find(system);
-	return (it == route.end() ? nullptr : it->second.next);
+	const Edge *edge = Find(system);
+	return (edge ? edge->next : nullptr);
 }
 	
 	
@@ -102,10 +181,7 @@ const System *DistanceMap::Route(const System *system) const
 // Get a set containing all the systems.
 set<const System *> DistanceMap::Systems() const
 {
-	set<const System *> systems;
-	for(const auto &it : route)
-		systems.insert(it.first);
-	return systems;
+	return set<const System *>(systems.begin(), systems.end());
 }
 
 
@@ -120,11 +196,11 @@ const System *DistanceMap::End() const
 
 int DistanceMap::RequiredFuel(const System *system1, const System *system2) const
 {
-	auto it1 = route.find(system1);
-	auto it2 = route.find(system2);
-	if(it1 == route.end() || it2 == route.end())
+	const Edge *edge1 = Find(system1);
+	const Edge *edge2 = Find(system2);
+	if(!edge1 || !edge2)
 		return -1;
-	return abs(it1->second.fuel - it2->second.fuel);
+	return abs(edge1->fuel - edge2->fuel);
 }
 
 
@@ -152,15 +228,43 @@ bool DistanceMap::Edge::operator<(const Edge &other) const
 
 
 
-// Depending on the capabilities of the given ship, use hyperspace paths,
-// jump drive paths, or both to find the shortest route. Bail out if the
-// source system or the maximum count is reached.
+// Run the search in this thread's workspace, then copy out the results.
 void DistanceMap::Init(const Ship *ship)
 {
 	if(!center)
 		return;
 	
-	route[center] = Edge();
+	static thread_local Workspace threadWorkspace;
+	workspace = &threadWorkspace;
+	workspace->Reset();
+	Search(ship);
+	
+	// Copy the results into an array that is just big enough to hold them.
+	systems = workspace->found;
+	int last = 0;
+	firstIndex = systems.front()->Index();
+	for(const System *system : systems)
+	{
+		firstIndex = min(firstIndex, system->Index());
+		last = max(last, system->Index());
+	}
+	Edge unreachable;
+	unreachable.days = -1;
+	route.assign(last + 1 - firstIndex, unreachable);
+	for(const System *system : systems)
+		route[system->Index() - firstIndex] = *workspace->Find(*system);
+	
+	workspace = nullptr;
+}
+
+
+
+// Depending on the capabilities of the given ship, use hyperspace paths,
+// jump drive paths, or both to find the shortest route. Bail out if the
+// source system or the maximum count is reached.
+void DistanceMap::Search(const Ship *ship)
+{
+	workspace->Set(*center, Edge());
 	if(!maxDistance)
 		return;
 	
@@ -177,8 +281,9 @@ void DistanceMap::Init(const Ship *ship)
 			hyperspaceFuel = 0.;
 		
 		// If this ship has no mode of hyperspace travel, and no local
-		// wormhole to use, bail out.
-		if(!jumpFuel && !hyperspaceFuel)
+		// wormhole to use, bail out. (If the ship's location does not matter,
+		// the route may still start from some other wormhole.)
+		if(!jumpFuel && !hyperspaceFuel && (source || !toCenter))
 		{
 			bool hasWormhole = false;
 			for(const StellarObject &object : ship->GetSystem()->Objects())
@@ -197,11 +302,13 @@ void DistanceMap::Init(const Ship *ship)
 	// choose the one with the fewest jumps (i.e. using jump drive rather than
 	// hyperdrive). If multiple routes have the same fuel and the same number of
 	// jumps, break the tie by using how "dangerous" the route is.
-	edges.emplace(center);
+	vector<Edge> &edges = workspace->edges;
+	edges.emplace_back(center);
 	while(maxCount && !edges.empty())
 	{
-		Edge top = edges.top();
-		edges.pop();
+		pop_heap(edges.begin(), edges.end());
+		Edge top = edges.back();
+		edges.pop_back();
 		
 		// Source is only defined when given a ship and a destination system.
 		// Once we have a route between them, stop searching for more routes.
@@ -219,9 +326,9 @@ void DistanceMap::Init(const Ship *ship)
 			for(const StellarObject &object : top.next->Objects())
 				if(object.HasSprite() && object.HasValidPlanet() && object.GetPlanet()->IsWormhole())
 				{
-					// If we're seeking a path toward a "source," travel through
+					// If we're seeking paths toward the center, travel through
 					// wormholes in the reverse of the normal direction.
-					const System &link = source ?
+					const System &link = toCenter ?
 						*object.GetPlanet()->WormholeSource(top.next) :
 						*object.GetPlanet()->WormholeDestination(top.next);
 					if(HasBetter(link, top))
@@ -276,8 +383,8 @@ bool DistanceMap::Propagate(Edge edge, bool useJump)
 // Check if we already have a better path to the given system.
 bool DistanceMap::HasBetter(const System &to, const Edge &edge)
 {
-	auto it = route.find(&to);
-	return (it != route.end() && !(it->second < edge));
+	const Edge *best = workspace->Find(to);
+	return (best && !(*best < edge));
 }
 
 
@@ -287,10 +394,13 @@ void DistanceMap::Add(const System &to, Edge edge)
 {
 	// This is the best path we have found so far to this system, but it is
 	// conceivable that a better one will be found.
-	route[&to] = edge;
+	workspace->Set(to, edge);
 	edge.next = &to;
 	if(maxDistance < 0 || edge.days < maxDistance)
-		edges.emplace(edge);
+	{
+		workspace->edges.push_back(edge);
+		push_heap(workspace->edges.begin(), workspace->edges.end());
+	}
 }
 
 
@@ -317,3 +427,15 @@ bool DistanceMap::CheckLink(const System &from, const System &to, bool useJump)
 	
 	return (player->HasVisited(from) || player->HasVisited(to));
 }
+
+
+
+// Get the route to the given system, or nullptr if it is not reachable.
+const DistanceMap::Edge *DistanceMap::Find(const System *system) const
+{
+	if(!system)
+		return nullptr;
+	
+	size_t index = system->Index() - firstIndex;
+	return (index < route.size() && route[index].days >= 0) ? &route[index] : nullptr;
+}
@@ -13,10 +13,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef DISTANCE_MAP_H_
 #define DISTANCE_MAP_H_
 
-#include <map>
-#include <queue>
 #include <set>
-#include <utility>
+#include <vector>
 
 class PlayerInfo;
 class Ship;
@@ -42,6 +40,11 @@ public:
 	// ship will use a jump drive or hyperdrive depending on what it has. The
 	// pathfinding will stop once a path to the destination is found.
 	DistanceMap(const Ship &ship, const System *destination);
+	// Calculate the paths that the given ship, or any ship with the same drives
+	// and access to the same wormholes, would take to get to the destination
+	// from every system that can reach it. The ship's location is ignored, so
+	// the result can be shared by all such ships with the same destination.
+	DistanceMap(const System *destination, const Ship &ship);
 	
 	// Find out if the given system is reachable.
 	bool HasRoute(const System *system) const;
@@ -77,12 +80,19 @@ private:
 		double danger = 0.;
 	};
 	
+	// The search for routes is done in a workspace that is reused by every
+	// distance map built in the same thread, so that it does not need to
+	// allocate or clear its per-system arrays each time.
+	class Workspace;
+	
 	
 private:
+	// Run the search in this thread's workspace, then copy out the results.
+	void Init(const Ship *ship = nullptr);
 	// Depending on the capabilities of the given ship, use hyperspace paths,
 	// jump drive paths, or both to find the shortest route. Bail out if the
 	// source system or the maximum count is reached.
-	void Init(const Ship *ship = nullptr);
+	void Search(const Ship *ship);
 	// Add the given links to the map. Return false if an end condition is hit.
 	bool Propagate(Edge edge, bool useJump);
 	// Check if we already have a better path to the given system.
@@ -93,13 +103,21 @@ private:
 	// constructor then this is always true; otherwise, the player must know
 	// that the given link exists.
 	bool CheckLink(const System &from, const System &to, bool useJump) const;
+	// Get the route to the given system, or nullptr if it is not reachable.
+	const Edge *Find(const System *system) const;
 	
 	
 private:
-	std::map<const System *, Edge> route;
+	// The route to each system, indexed by System::Index() minus the lowest
+	// index of any reachable system. Systems that are not reachable have a
+	// negative number of days.
+	std::vector<Edge> route;
+	int firstIndex = 0;
+	// All the reachable systems, in the order they were found.
+	std::vector<const System *> systems;
 	
 	// Variables only used during construction:
-	std::priority_queue<Edge> edges;
+	Workspace *workspace = nullptr;
 	const PlayerInfo *player = nullptr;
 	const System *source = nullptr;
 	const System *center = nullptr;
@@ -111,6 +129,8 @@ private:
 	int jumpFuel = 0;
 	bool useWormholes = true;
 	double jumpRange = 0.;
+	// If this is set, the routes lead to the center instead of away from it.
+	bool toCenter = false;
 };
 
 
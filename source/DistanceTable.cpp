@@ -0,0 +1,112 @@
+/* DistanceTable.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "DistanceTable.h"
+
+#include "System.h"
+
+using namespace std;
+
+namespace {
+	// Marker for pairs of systems that have no route between them.
+	const uint16_t NO_ROUTE = 0xFFFF;
+}
+
+
+
+// Recalculate the table. This must be done whenever the links change.
+void DistanceTable::Update(const Set<System> &systems)
+{
+	this->systems.clear();
+	index.clear();
+	for(const auto &it : systems)
+	{
+		index[&it.second] = this->systems.size();
+		this->systems.push_back(&it.second);
+	}
+	
+	// Every hyperspace jump takes one day, so a breadth-first search from each
+	// system finds the same distances that a DistanceMap would.
+	size_t size = this->systems.size();
+	days.assign(size * size, NO_ROUTE);
+	vector<int> queue;
+	queue.reserve(size);
+	for(size_t i = 0; i < size; ++i)
+	{
+		uint16_t *row = &days[i * size];
+		row[i] = 0;
+		queue.clear();
+		queue.push_back(i);
+		for(size_t next = 0; next < queue.size(); ++next)
+		{
+			int from = queue[next];
+			for(const System *link : this->systems[from]->Links())
+			{
+				int to = Index(link);
+				if(to < 0 || row[to] != NO_ROUTE)
+					continue;
+				
+				row[to] = row[from] + 1;
+				queue.push_back(to);
+			}
+		}
+	}
+}
+
+
+
+// Find out how many jumps away the given system is from the center, or -1
+// if there is no route between them.
+int DistanceTable::Days(const System *center, const System *system) const
+{
+	if(center == system)
+		return 0;
+	
+	int from = Index(center);
+	int to = Index(system);
+	if(from < 0 || to < 0)
+		return -1;
+	
+	uint16_t d = days[from * systems.size() + to];
+	return (d == NO_ROUTE) ? -1 : d;
+}
+
+
+
+// Get all the systems that are at most the given number of jumps away from
+// the center, in the same order as in the set they were loaded from.
+vector<const System *> DistanceTable::Systems(const System *center, int maxDistance) const
+{
+	vector<const System *> result;
+	int from = Index(center);
+	if(from < 0)
+	{
+		if(center && maxDistance >= 0)
+			result.push_back(center);
+		return result;
+	}
+	
+	const uint16_t *row = &days[from * systems.size()];
+	for(size_t i = 0; i < systems.size(); ++i)
+		if(row[i] != NO_ROUTE && (maxDistance < 0 || row[i] <= maxDistance))
+			result.push_back(systems[i]);
+	return result;
+}
+
+
+
+// Get the row or column of the given system, or -1 if it is not in the table.
+int DistanceTable::Index(const System *system) const
+{
+	auto it = index.find(system);
+	return (it == index.end()) ? -1 : it->second;
+}
@@ -0,0 +1,58 @@
+/* DistanceTable.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef DISTANCE_TABLE_H_
+#define DISTANCE_TABLE_H_
+
+#include "Set.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class System;
+
+
+
+// This is a table of how many hyperspace jumps it takes to get from every
+// system to every other system, using only hyperspace links. It gives the same
+// answers as a DistanceMap created for each system without a ship or a player,
+// but the whole galaxy is calculated at once whenever the links change, so
+// looking up a distance never has to rebuild anything.
+class DistanceTable {
+public:
+	// Recalculate the table. This must be done whenever the links change.
+	void Update(const Set<System> &systems);
+	
+	// Find out how many jumps away the given system is from the center, or -1
+	// if there is no route between them.
+	int Days(const System *center, const System *system) const;
+	// Get all the systems that are at most the given number of jumps away from
+	// the center, in the same order as in the set they were loaded from.
+	std::vector<const System *> Systems(const System *center, int maxDistance) const;
+	
+	
+private:
+	// Get the row or column of the given system, or -1 if it is not in the table.
+	int Index(const System *system) const;
+	
+	
+private:
+	std::vector<const System *> systems;
+	std::unordered_map<const System *, int> index;
+	// The number of jumps from system i to system j is stored at i * size + j.
+	std::vector<uint16_t> days;
+};
+
+
+
+#endif
@@ -19,16 +19,59 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "SpriteSet.h"
 #include "SpriteShader.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
 
+namespace {
+	// A run of items that share a texture and swizzle, and so can be drawn
+	// with a single instanced draw call.
+	class Batch {
+	public:
+		uint32_t texture;
+		uint32_t swizzle;
+		// The screen area covered by all the items in this batch.
+		float left;
+		float top;
+		float right;
+		float bottom;
+		size_t count;
+	};
+	
+	// When looking for a batch that an item can be added to, only look this
+	// many batches back from the most recent one.
+	const size_t MAX_BATCH_SEARCH = 32;
+	
+	// Get the screen area an item may draw to, including its motion blur.
+	void GetBounds(const SpriteShader::Item &item, float &left, float &top, float &right, float &bottom)
+	{
+		float blurX = 1.f + 2.f * fabs(item.blur[0]);
+		float blurY = 1.f + 2.f * fabs(item.blur[1]);
+		float halfWidth = .5f * (fabs(item.transform[0]) * blurX + fabs(item.transform[2]) * blurY);
+		float halfHeight = .5f * (fabs(item.transform[1]) * blurX + fabs(item.transform[3]) * blurY);
+		left = item.position[0] - halfWidth;
+		right = item.position[0] + halfWidth;
+		top = item.position[1] - halfHeight;
+		bottom = item.position[1] + halfHeight;
+	}
+	
+	// Get a copy of the item, moved the given fraction of a step along its velocity.
+	SpriteShader::Item Interpolate(SpriteShader::Item item, const Point &velocity, double interpolation)
+	{
+		item.position[0] += static_cast<float>(velocity.X() * interpolation);
+		item.position[1] += static_cast<float>(velocity.Y() * interpolation);
+		return item;
+	}
+}
+
 
 
 // Clear the list.
 void DrawList::Clear(int step, double zoom)
 {
 	items.clear();
+	velocities.clear();
 	this->step = step;
 	this->zoom = zoom;
 	isHighDPI = (Screen::IsHighResolution() ? zoom > .5 : zoom > 1.);
@@ -98,14 +141,69 @@ bool DrawList::AddSwizzled(const Body &body, int swizzle)
 
 
 // Draw all the items in this list.
-void DrawList::Draw() const
+void DrawList::Draw(double interpolation) const
 {
-	SpriteShader::Bind();
-	
 	bool withBlur = Preferences::Has("Render motion blur");
-	for(const SpriteShader::Item &item : items)
-		SpriteShader::Add(item, withBlur);
+	if(!SpriteShader::UseInstancing())
+	{
+		SpriteShader::Bind();
+		
+		for(size_t i = 0; i < items.size(); ++i)
+			SpriteShader::Add(Interpolate(items[i], velocities[i], interpolation), withBlur);
+		
+		SpriteShader::Unbind();
+		return;
+	}
+	
+	// Group the items into batches that share a texture and swizzle. An item
+	// may be moved back into an earlier batch only if it does not overlap any
+	// of the items drawn after that batch, so any two items that overlap are
+	// still drawn in the order they were added.
+	vector<Batch> batches;
+	vector<size_t> itemBatch(items.size());
+	for(size_t i = 0; i < items.size(); ++i)
+	{
+		SpriteShader::Item item = Interpolate(items[i], velocities[i], interpolation);
+		float left, top, right, bottom;
+		GetBounds(item, left, top, right, bottom);
+		
+		size_t index = batches.size();
+		size_t stop = (batches.size() > MAX_BATCH_SEARCH ? batches.size() - MAX_BATCH_SEARCH : 0);
+		for(size_t b = batches.size(); b-- > stop; )
+		{
+			const Batch &batch = batches[b];
+			if(batch.texture == item.texture && batch.swizzle == item.swizzle)
+			{
+				index = b;
+				break;
+			}
+			if(left <= batch.right && right >= batch.left && top <= batch.bottom && bottom >= batch.top)
+				break;
+		}
+		if(index == batches.size())
+			batches.push_back(Batch{item.texture, item.swizzle, left, top, right, bottom, 0});
+		else
+		{
+			Batch &batch = batches[index];
+			batch.left = min(batch.left, left);
+			batch.top = min(batch.top, top);
+			batch.right = max(batch.right, right);
+			batch.bottom = max(batch.bottom, bottom);
+		}
+		++batches[index].count;
+		itemBatch[i] = index;
+	}
+	
+	// Lay out the items batch by batch, keeping their order within each batch.
+	vector<size_t> next(batches.size());
+	for(size_t b = 1; b < batches.size(); ++b)
+		next[b] = next[b - 1] + batches[b - 1].count;
+	vector<SpriteShader::Item> sorted(items.size());
+	for(size_t i = 0; i < items.size(); ++i)
+		sorted[next[itemBatch[i]]++] = Interpolate(items[i], velocities[i], interpolation);
 	
+	SpriteShader::BindInstanced();
+	SpriteShader::AddInstanced(sorted, withBlur);
 	SpriteShader::Unbind();
 }
 
@@ -139,6 +237,8 @@ void DrawList::Push(const Body &body, Point pos, Point blur, double cloak, doubl
 	SpriteShader::Item item;
 	
 	item.texture = body.GetSprite()->Texture(isHighDPI);
+	const float *rect = body.GetSprite()->TextureRect(isHighDPI);
+	copy(rect, rect + 4, item.rect);
 	item.frame = body.GetFrame(step);
 	item.frameCount = body.GetSprite()->Frames();
 	
@@ -177,4 +277,5 @@ void DrawList::Push(const Body &body, Point pos, Point blur, double cloak, doubl
 	item.swizzle = swizzle;
 	
 	items.push_back(item);
+	velocities.push_back((body.Velocity() - centerVelocity) * zoom);
 }
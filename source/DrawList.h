@@ -44,8 +44,9 @@ public:
 	// Add an object using a specific swizzle (rather than its own).
 	bool AddSwizzled(const Body &body, int swizzle);
 	
-	// Draw all the items in this list.
-	void Draw() const;
+	// Draw all the items in this list. If the interpolation is not zero, each
+	// item is drawn that fraction of a step further along its velocity.
+	void Draw(double interpolation = 0.) const;
 	
 	
 private:
@@ -60,6 +61,8 @@ private:
 	double zoom = 1.;
 	bool isHighDPI = false;
 	std::vector<SpriteShader::Item> items;
+	// The velocity of each item relative to the center, in screen pixels.
+	std::vector<Point> velocities;
 	
 	Point center;
 	Point centerVelocity;
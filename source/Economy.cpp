@@ -0,0 +1,193 @@
+/* Economy.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "Economy.h"
+
+#include "Random.h"
+#include "System.h"
+#include "Trade.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+	// Dynamic economy parameters: how much of its production each system keeps
+	// and exports each day:
+	const double KEEP = .89;
+	const double EXPORT = .10;
+	// Standard deviation of the daily production of each commodity:
+	const double VOLUME = 2000.;
+}
+
+
+
+// Work out which commodities each system trades and how the systems are
+// linked. This must be done again whenever the systems are updated.
+void Economy::Load(Set<System> &systems, const Trade &trade)
+{
+	// Find out which commodities each system trades. The columns are sorted by
+	// name, which is the order in which each system stores its prices.
+	this->systems.clear();
+	set<string> names;
+	for(auto &it : systems)
+	{
+		this->systems.push_back(&it.second);
+		for(const auto &cit : it.second.trade)
+			names.insert(cit.first);
+	}
+	rows = this->systems.size();
+	columns = names.size();
+	commodities.assign(names.begin(), names.end());
+	map<string, int> columnIndex;
+	for(int c = 0; c < columns; ++c)
+		columnIndex[commodities[c]] = c;
+	
+	// Only the standard commodities are traded between systems.
+	vector<double> isStandard(columns, 0.);
+	for(const Trade::Commodity &commodity : trade.Commodities())
+	{
+		auto it = columnIndex.find(commodity.name);
+		if(it != columnIndex.end())
+			isStandard[it->second] = 1.;
+	}
+	
+	const size_t cells = static_cast<size_t>(rows) * columns;
+	supply.assign(cells, 0.);
+	exports.assign(cells, 0.);
+	present.assign(cells, 0.);
+	flows.assign(cells, 0.);
+	production.assign(cells, 0.);
+	tradeBegin.assign(1, 0);
+	traded.clear();
+	for(int r = 0; r < rows; ++r)
+	{
+		for(const auto &it : this->systems[r]->trade)
+		{
+			int c = columnIndex[it.first];
+			size_t i = static_cast<size_t>(r) * columns + c;
+			present[i] = 1.;
+			flows[i] = isStandard[c];
+			traded.push_back(c);
+		}
+		tradeBegin.push_back(traded.size());
+	}
+	
+	// Store the links as an adjacency list, in the same order as each system
+	// stores them so that the supplies are summed in a consistent order.
+	unordered_map<const System *, int> rowIndex;
+	for(int r = 0; r < rows; ++r)
+		rowIndex[this->systems[r]] = r;
+	linkBegin.assign(1, 0);
+	neighbors.clear();
+	linkCount.assign(rows, 0.);
+	for(int r = 0; r < rows; ++r)
+	{
+		const System &system = *this->systems[r];
+		linkCount[r] = system.Links().size();
+		for(const System *neighbor : system.Links())
+		{
+			auto it = rowIndex.find(neighbor);
+			if(it != rowIndex.end() && !neighbor->Links().empty())
+				neighbors.push_back(it->second);
+		}
+		linkBegin.push_back(neighbors.size());
+	}
+}
+
+
+
+// Simulate the given number of days, updating each system's supplies and
+// prices afterwards.
+void Economy::Step(int days)
+{
+	if(days <= 0)
+		return;
+	
+	Gather();
+	for(int day = 0; day < days; ++day)
+		StepOnce();
+	Scatter();
+}
+
+
+
+// Copy the supplies out of the systems. Each system's prices are visited in
+// order, so no commodity has to be looked up by name.
+void Economy::Gather()
+{
+	for(int r = 0; r < rows; ++r)
+	{
+		const int *column = traded.data() + tradeBegin[r];
+		double *row = supply.data() + static_cast<size_t>(r) * columns;
+		for(const auto &it : systems[r]->trade)
+			row[*column++] = it.second.supply;
+	}
+}
+
+
+
+// Copy the supplies back into the systems, and update their prices.
+void Economy::Scatter() const
+{
+	for(int r = 0; r < rows; ++r)
+	{
+		const int *column = traded.data() + tradeBegin[r];
+		const double *row = supply.data() + static_cast<size_t>(r) * columns;
+		for(auto &it : systems[r]->trade)
+		{
+			it.second.supply = row[*column++];
+			it.second.Update();
+		}
+	}
+}
+
+
+
+// Simulate a single day.
+void Economy::StepOnce()
+{
+	const size_t cells = supply.size();
+	
+	// The random numbers must be drawn one at a time, in the same order that
+	// each system would draw them in.
+	for(size_t i = 0; i < cells; ++i)
+		if(present[i])
+			production[i] = Random::Normal();
+	
+	// Each system generates new goods for local use and trade. A commodity
+	// that is not traded has zero supply and zero production, so it stays zero.
+	for(size_t i = 0; i < cells; ++i)
+	{
+		exports[i] = EXPORT * supply[i];
+		supply[i] = supply[i] * KEEP + production[i] * VOLUME;
+	}
+	
+	// Then, send out the trade goods. This has to be done after all systems
+	// have produced their goods, because otherwise whichever systems trade
+	// last would already have gotten supplied by the other systems.
+	for(int r = 0; r < rows; ++r)
+	{
+		double *row = &supply[static_cast<size_t>(r) * columns];
+		const double *flow = &flows[static_cast<size_t>(r) * columns];
+		for(int l = linkBegin[r]; l < linkBegin[r + 1]; ++l)
+		{
+			const int n = neighbors[l];
+			const double *source = &exports[static_cast<size_t>(n) * columns];
+			const double scale = linkCount[n];
+			for(int c = 0; c < columns; ++c)
+				row[c] += flow[c] * (source[c] / scale);
+		}
+	}
+}
@@ -0,0 +1,85 @@
+/* Economy.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef ECONOMY_H_
+#define ECONOMY_H_
+
+#include "Set.h"
+
+#include <string>
+#include <vector>
+
+class System;
+class Trade;
+
+
+
+// Class that simulates the galaxy's economy. The supply of every commodity in
+// every system is copied into a dense matrix (one row per system, one column
+// per commodity) and the hyperspace links are stored as an adjacency list in
+// compressed sparse row form, so that each day can be simulated with a few
+// tight loops over flat arrays instead of looking up commodities by name.
+// The layout only changes when systems do, so it is built once by Load() and
+// reused for every day until the next time the systems are updated.
+class Economy {
+public:
+	// Work out which commodities each system trades and how the systems are
+	// linked. This must be done again whenever the systems are updated.
+	void Load(Set<System> &systems, const Trade &trade);
+	// Simulate the given number of days, updating each system's supplies and
+	// prices afterwards.
+	void Step(int days = 1);
+
+
+private:
+	// Copy the supplies out of the systems, or back into them.
+	void Gather();
+	void Scatter() const;
+	// Simulate a single day.
+	void StepOnce();
+
+
+private:
+	int rows = 0;
+	int columns = 0;
+	// The system each row of the matrices belongs to.
+	std::vector<System *> systems;
+	// The name of the commodity in each column, in sorted order.
+	std::vector<std::string> commodities;
+	
+	// The supply of each commodity in each system, and how much of it is
+	// exported each day. A commodity a system does not trade is always zero.
+	std::vector<double> supply;
+	std::vector<double> exports;
+	// 1 for each commodity a system trades, 0 otherwise.
+	std::vector<double> present;
+	// 1 for each commodity a system trades with its neighbors, 0 otherwise.
+	std::vector<double> flows;
+	// Scratch space for the random daily production.
+	std::vector<double> production;
+	// The columns of the commodities traded by row i are traded[tradeBegin[i]]
+	// up to (but not including) traded[tradeBegin[i + 1]], in the same order
+	// that the system stores them in.
+	std::vector<int> tradeBegin;
+	std::vector<int> traded;
+	
+	// The neighbors of row i are neighbors[linkBegin[i]] up to (but not
+	// including) neighbors[linkBegin[i + 1]].
+	std::vector<int> linkBegin;
+	std::vector<int> neighbors;
+	// The number of links each system has, which its exports are split among.
+	std::vector<double> linkCount;
+};
+
+
+
+#endif
@@ -53,6 +53,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "StarField.h"
 #include "StellarObject.h"
 #include "System.h"
+#include "ThreadPool.h"
 #include "Visual.h"
 #include "Weather.h"
 #include "text/WrappedText.h"
@@ -197,6 +198,12 @@ Engine::Engine(PlayerInfo &player)
 {
 	zoom = Preferences::ViewZoom();
 	
+	// Each block of a parallel loop collects the objects it creates in buffers
+	// of its own.
+	blockVisuals.resize(ThreadPool::Blocks());
+	blockFlotsam.resize(ThreadPool::Blocks());
+	blockProjectiles.resize(ThreadPool::Blocks());
+	
 	// Start the thread for doing calculations.
 	calcThread = thread(&Engine::ThreadEntryPoint, this);
 	
@@ -597,7 +604,7 @@ void Engine::Step(bool isActive)
 			if(isEnemy || it->IsYours() || it->GetPersonality().IsEscort())
 			{
 				double width = min(it->Width(), it->Height());
-				statuses.emplace_back(it->Position() - center, it->Shields(), it->Hull(),
+				statuses.emplace_back(it->Position() - center, it->Velocity() - centerVelocity, it->Shields(), it->Hull(),
 					min(it->Hull(), it->DisabledHull()), max(20., width * .5), isEnemy);
 			}
 		}
@@ -620,6 +627,38 @@ void Engine::Step(bool isActive)
 	if(flagship && flagship->IsOverheated())
 		Messages::Add("Your ship has overheated.");
 	
+	// Look up the slots of the HUD information once, so that filling them in
+	// does not need to look up any names.
+	static const int PLAYER_SPRITE = Information::SpriteSlot("player sprite");
+	static const int LOCATION = Information::StringSlot("location");
+	static const int DATE = Information::StringSlot("date");
+	static const int FUEL = Information::BarSlot("fuel");
+	static const int ENERGY = Information::BarSlot("energy");
+	static const int HEAT = Information::BarSlot("heat");
+	static const int OVERHEAT = Information::BarSlot("overheat");
+	static const int OVERHEAT_BLINK = Information::BarSlot("overheat blink");
+	static const int SHIELDS = Information::BarSlot("shields");
+	static const int HULL = Information::BarSlot("hull");
+	static const int DISABLED_HULL = Information::BarSlot("disabled hull");
+	static const int CREDITS = Information::StringSlot("credits");
+	static const int NAVIGATION_MODE = Information::StringSlot("navigation mode");
+	static const int DESTINATION = Information::StringSlot("destination");
+	static const int TARGET_NAME = Information::StringSlot("target name");
+	static const int TARGET_SPRITE = Information::SpriteSlot("target sprite");
+	static const int RANGE_DISPLAY = Information::ConditionSlot("range display");
+	static const int TARGET_RANGE = Information::StringSlot("target range");
+	static const int TARGET_TYPE = Information::StringSlot("target type");
+	static const int TARGET_GOVERNMENT = Information::StringSlot("target government");
+	static const int MISSION_TARGET = Information::StringSlot("mission target");
+	static const int TARGET_SHIELDS = Information::BarSlot("target shields");
+	static const int TARGET_HULL = Information::BarSlot("target hull");
+	static const int TARGET_DISABLED_HULL = Information::BarSlot("target disabled hull");
+	static const int TACTICAL_DISPLAY = Information::ConditionSlot("tactical display");
+	static const int TARGET_CREW = Information::StringSlot("target crew");
+	static const int TARGET_FUEL = Information::StringSlot("target fuel");
+	static const int TARGET_ENERGY = Information::StringSlot("target energy");
+	static const int TARGET_HEAT = Information::StringSlot("target heat");
+	
 	// Clear the HUD information from the previous frame.
 	info = Information();
 	if(flagship && flagship->Hull())
@@ -628,29 +667,29 @@ void Engine::Step(bool isActive)
 		if(Preferences::Has("Rotate flagship in HUD"))
 			shipFacingUnit = flagship->Facing().Unit();
 		
-		info.SetSprite("player sprite", flagship->GetSprite(), shipFacingUnit, flagship->GetFrame(step));
+		info.SetSprite(PLAYER_SPRITE, flagship->GetSprite(), shipFacingUnit, flagship->GetFrame(step));
 	}
 	if(currentSystem)
-		info.SetString("location", currentSystem->Name());
-	info.SetString("date", player.GetDate().ToString());
+		info.SetString(LOCATION, currentSystem->Name());
+	info.SetString(DATE, player.GetDate().ToString());
 	if(flagship)
 	{
-		info.SetBar("fuel", flagship->Fuel(),
+		info.SetBar(FUEL, flagship->Fuel(),
 			flagship->Attributes().Get("fuel capacity") * .01);
-		info.SetBar("energy", flagship->Energy());
+		info.SetBar(ENERGY, flagship->Energy());
 		double heat = flagship->Heat();
-		info.SetBar("heat", min(1., heat));
+		info.SetBar(HEAT, min(1., heat));
 		// If heat is above 100%, draw a second overlaid bar to indicate the
 		// total heat level.
 		if(heat > 1.)
-			info.SetBar("overheat", min(1., heat - 1.));
+			info.SetBar(OVERHEAT, min(1., heat - 1.));
 		if(flagship->IsOverheated() && (step / 20) % 2)
-			info.SetBar("overheat blink", min(1., heat));
-		info.SetBar("shields", flagship->Shields());
-		info.SetBar("hull", flagship->Hull(), 20.);
-		info.SetBar("disabled hull", min(flagship->Hull(), flagship->DisabledHull()), 20.);
+			info.SetBar(OVERHEAT_BLINK, min(1., heat));
+		info.SetBar(SHIELDS, flagship->Shields());
+		info.SetBar(HULL, flagship->Hull(), 20.);
+		info.SetBar(DISABLED_HULL, min(flagship->Hull(), flagship->DisabledHull()), 20.);
 	}
-	info.SetString("credits",
+	info.SetString(CREDITS,
 		Format::Credits(player.Accounts().Credits()) + " credits");
 	bool isJumping = flagship && (flagship->Commands().Has(Command::JUMP) || flagship->IsEnteringHyperspace());
 	if(flagship && flagship->GetTargetStellar() && !isJumping)
@@ -659,12 +698,13 @@ void Engine::Step(bool isActive)
 		string navigationMode = flagship->Commands().Has(Command::LAND) ? "Landing on:" :
 			object->GetPlanet() && object->GetPlanet()->CanLand(*flagship) ? "Can land on:" :
 			"Cannot land on:";
-		info.SetString("navigation mode", navigationMode);
+		info.SetString(NAVIGATION_MODE, navigationMode);
 		const string &name = object->Name();
-		info.SetString("destination", name);
+		info.SetString(DESTINATION, name);
 		
 		targets.push_back({
 			object->Position() - center,
+			object->Velocity() - centerVelocity,
 			object->Facing(),
 			object->Radius(),
 			object->GetPlanet()->CanLand() ? Radar::FRIENDLY : Radar::HOSTILE,
@@ -672,16 +712,16 @@ void Engine::Step(bool isActive)
 	}
 	else if(flagship && flagship->GetTargetSystem())
 	{
-		info.SetString("navigation mode", "Hyperspace:");
+		info.SetString(NAVIGATION_MODE, "Hyperspace:");
 		if(player.HasVisited(*flagship->GetTargetSystem()))
-			info.SetString("destination", flagship->GetTargetSystem()->Name());
+			info.SetString(DESTINATION, flagship->GetTargetSystem()->Name());
 		else
-			info.SetString("destination", "unexplored system");
+			info.SetString(DESTINATION, "unexplored system");
 	}
 	else
 	{
-		info.SetString("navigation mode", "Navigation:");
-		info.SetString("destination", "no destination");
+		info.SetString(NAVIGATION_MODE, "Navigation:");
+		info.SetString(DESTINATION, "no destination");
 	}
 	// Use the radar that was just populated. (The draw tick-tock has not
 	// yet been toggled, but it will be at the end of this function.)
@@ -700,51 +740,52 @@ void Engine::Step(bool isActive)
 	if(!target)
 		targetSwizzle = -1;
 	if(!target && !targetAsteroid)
-		info.SetString("target name", "no target");
+		info.SetString(TARGET_NAME, "no target");
 	else if(!target)
 	{
-		info.SetSprite("target sprite",
+		info.SetSprite(TARGET_SPRITE,
 			targetAsteroid->GetSprite(),
 			targetAsteroid->Facing().Unit(),
 			targetAsteroid->GetFrame(step));
-		info.SetString("target name", Format::Capitalize(targetAsteroid->Name()) + " Asteroid");
+		info.SetString(TARGET_NAME, Format::Capitalize(targetAsteroid->Name()) + " Asteroid");
 		
 		targetVector = targetAsteroid->Position() - center;
 		
 		if(flagship->Attributes().Get("tactical scan power"))
 		{
-			info.SetCondition("range display");
+			info.SetCondition(RANGE_DISPLAY);
 			int targetRange = round(targetAsteroid->Position().Distance(flagship->Position()));
-			info.SetString("target range", to_string(targetRange));
+			info.SetString(TARGET_RANGE, to_string(targetRange));
 		}
 	}
 	else
 	{
 		if(target->GetSystem() == player.GetSystem() && target->Cloaking() < 1.)
 			targetUnit = target->Facing().Unit();
-		info.SetSprite("target sprite", target->GetSprite(), targetUnit, target->GetFrame(step));
-		info.SetString("target name", target->Name());
-		info.SetString("target type", target->ModelName());
+		info.SetSprite(TARGET_SPRITE, target->GetSprite(), targetUnit, target->GetFrame(step));
+		info.SetString(TARGET_NAME, target->Name());
+		info.SetString(TARGET_TYPE, target->ModelName());
 		if(!target->GetGovernment())
-			info.SetString("target government", "No Government");
+			info.SetString(TARGET_GOVERNMENT, "No Government");
 		else
-			info.SetString("target government", target->GetGovernment()->GetName());
+			info.SetString(TARGET_GOVERNMENT, target->GetGovernment()->GetName());
 		targetSwizzle = target->GetSwizzle();
-		info.SetString("mission target", target->GetPersonality().IsTarget() ? "(mission target)" : "");
+		info.SetString(MISSION_TARGET, target->GetPersonality().IsTarget() ? "(mission target)" : "");
 		
 		int targetType = RadarType(*target, step);
 		info.SetOutlineColor(Radar::GetColor(targetType));
 		if(target->GetSystem() == player.GetSystem() && target->IsTargetable())
 		{
-			info.SetBar("target shields", target->Shields());
-			info.SetBar("target hull", target->Hull(), 20.);
-			info.SetBar("target disabled hull", min(target->Hull(), target->DisabledHull()), 20.);
+			info.SetBar(TARGET_SHIELDS, target->Shields());
+			info.SetBar(TARGET_HULL, target->Hull(), 20.);
+			info.SetBar(TARGET_DISABLED_HULL, min(target->Hull(), target->DisabledHull()), 20.);
 			
 			// The target area will be a square, with sides proportional to the average
 			// of the width and the height of the sprite.
 			double size = (target->Width() + target->Height()) * .35;
 			targets.push_back({
 				target->Position() - center,
+				target->Velocity() - centerVelocity,
 				Angle(45.) + target->Facing(),
 				size,
 				targetType,
@@ -757,22 +798,22 @@ void Engine::Step(bool isActive)
 			double targetRange = target->Position().Distance(flagship->Position());
 			if(tacticalRange)
 			{
-				info.SetCondition("range display");
-				info.SetString("target range", to_string(static_cast<int>(round(targetRange))));
+				info.SetCondition(RANGE_DISPLAY);
+				info.SetString(TARGET_RANGE, to_string(static_cast<int>(round(targetRange))));
 			}
 			// Actual tactical information requires a scrutable
 			// target that is within the tactical scanner range.
 			if((targetRange <= tacticalRange && !target->Attributes().Get("inscrutable"))
 					|| (tacticalRange && target->IsYours()))
 			{
-				info.SetCondition("tactical display");
-				info.SetString("target crew", to_string(target->Crew()));
+				info.SetCondition(TACTICAL_DISPLAY);
+				info.SetString(TARGET_CREW, to_string(target->Crew()));
 				int fuel = round(target->Fuel() * target->Attributes().Get("fuel capacity"));
-				info.SetString("target fuel", to_string(fuel));
+				info.SetString(TARGET_FUEL, to_string(fuel));
 				int energy = round(target->Energy() * target->Attributes().Get("energy capacity"));
-				info.SetString("target energy", to_string(energy));
+				info.SetString(TARGET_ENERGY, to_string(energy));
 				int heat = round(100. * target->Heat());
-				info.SetString("target heat", to_string(heat) + "%");
+				info.SetString(TARGET_HEAT, to_string(heat) + "%");
 			}
 		}
 	}
@@ -781,7 +822,7 @@ void Engine::Step(bool isActive)
 	{
 		double width = max(target->Width(), target->Height());
 		Point pos = target->Position() - center;
-		statuses.emplace_back(pos, flagship->OutfitScanFraction(), flagship->CargoScanFraction(),
+		statuses.emplace_back(pos, target->Velocity() - centerVelocity, flagship->OutfitScanFraction(), flagship->CargoScanFraction(),
 			0, 10. + max(20., width * .5), 2, Angle(pos).Degrees() + 180.);
 	}
 	// Handle any events that change the selected ships.
@@ -827,6 +868,7 @@ void Engine::Step(bool isActive)
 			double size = (ship->Width() + ship->Height()) * .35;
 			targets.push_back({
 				ship->Position() - center,
+				ship->Velocity() - centerVelocity,
 				Angle(45.) + ship->Facing(),
 				size,
 				Radar::PLAYER,
@@ -845,6 +887,7 @@ void Engine::Step(bool isActive)
 			
 			targets.push_back({
 				offset,
+				minable->Velocity() - centerVelocity,
 				minable->Facing(),
 				.8 * minable->Radius(),
 				minable == flagship->GetTargetAsteroid() ? Radar::SPECIAL : Radar::INACTIVE,
@@ -869,7 +912,7 @@ void Engine::Go()
 
 // Pass the list of game events to MainPanel for handling by the player, and any
 // UI element generation.
-list<ShipEvent> &Engine::Events()
+vector<ShipEvent> &Engine::Events()
 {
 	return events;
 }
@@ -877,19 +920,27 @@ list<ShipEvent> &Engine::Events()
 
 
 // Draw a frame.
-void Engine::Draw() const
+void Engine::Draw(double interpolation) const
 {
-	GameData::Background().Draw(center, centerVelocity, zoom);
+	// Count the sprite draw calls made while drawing this frame.
+	unsigned spriteDrawCalls = SpriteShader::DrawCalls();
+	
+	// If the game is paused, nothing is moving.
+	if(!wasActive)
+		interpolation = 0.;
+	
+	GameData::Background().Draw(center + interpolation * centerVelocity, centerVelocity, zoom);
 	static const Set<Color> &colors = GameData::Colors();
 	const Interface *hud = GameData::Interfaces().Get("hud");
 	
 	// Draw any active planet labels.
 	for(const PlanetLabel &label : labels)
-		label.Draw();
+		label.Draw(-interpolation * zoom * centerVelocity);
 	
-	draw[drawTickTock].Draw();
-	batchDraw[drawTickTock].Draw();
+	draw[drawTickTock].Draw(interpolation);
+	batchDraw[drawTickTock].Draw(interpolation);
 	
+	RingShader::Bind();
 	for(const auto &it : statuses)
 	{
 		static const Color color[8] = {
@@ -902,16 +953,17 @@ void Engine::Draw() const
 			*colors.Get("overlay friendly disabled"),
 			*colors.Get("overlay hostile disabled")
 		};
-		Point pos = it.position * zoom;
+		Point pos = (it.position + interpolation * it.velocity) * zoom;
 		double radius = it.radius * zoom;
 		if(it.outer > 0.)
-			RingShader::Draw(pos, radius + 3., 1.5f, it.outer, color[it.type], 0.f, it.angle);
+			RingShader::Add(pos, radius + 3., 1.5f, it.outer, color[it.type], 0.f, it.angle);
 		double dashes = (it.type >= 2) ? 0. : 20. * min(1., zoom);
 		if(it.inner > 0.)
-			RingShader::Draw(pos, radius, 1.5f, it.inner, color[3 + it.type], dashes, it.angle);
+			RingShader::Add(pos, radius, 1.5f, it.inner, color[3 + it.type], dashes, it.angle);
 		if(it.disabled > 0.)
-			RingShader::Draw(pos, radius, 1.5f, it.disabled, color[6 + it.type], dashes, it.angle);
+			RingShader::Add(pos, radius, 1.5f, it.disabled, color[6 + it.type], dashes, it.angle);
 	}
+	RingShader::Unbind();
 	
 	// Draw the flagship highlight, if any.
 	if(highlightSprite)
@@ -954,7 +1006,7 @@ void Engine::Draw() const
 		PointerShader::Bind();
 		for(int i = 0; i < target.count; ++i)
 		{
-			PointerShader::Add(target.center * zoom, a.Unit(), 12.f, 14.f, -target.radius * zoom,
+			PointerShader::Add((target.center + interpolation * target.velocity) * zoom, a.Unit(), 12.f, 14.f, -target.radius * zoom,
 				Radar::GetColor(target.type));
 			a += da;
 		}
@@ -1044,6 +1096,16 @@ void Engine::Draw() const
 		Color color = *colors.Get("medium");
 		font.Draw(loadString,
 			Point(-10 - font.Width(loadString), Screen::Height() * -.5 + 5.), color);
+		string eventString = to_string(lround(eventLoad)) + " events / step";
+		font.Draw(eventString,
+			Point(-10 - font.Width(eventString), Screen::Height() * -.5 + 25.), color);
+		string drawString = to_string(SpriteShader::DrawCalls() - spriteDrawCalls) + " sprite draw calls";
+		font.Draw(drawString,
+			Point(-10 - font.Width(drawString), Screen::Height() * -.5 + 45.), color);
+		string allocationString = to_string(Flotsam::Allocations()) + " flotsam / "
+			+ to_string(projectileAllocations) + " projectile allocations";
+		font.Draw(allocationString,
+			Point(-10 - font.Width(allocationString), Screen::Height() * -.5 + 65.), color);
 	}
 }
 
@@ -1224,7 +1286,7 @@ void Engine::EnterSystem()
 	grudge.clear();
 	
 	projectiles.clear();
-	visuals.clear();
+	visuals.Clear();
 	flotsam.clear();
 	// Cancel any projectiles, visuals, or flotsam created by ships this step.
 	newProjectiles.clear();
@@ -1301,8 +1363,7 @@ void Engine::CalculateStep()
 	const Ship *flagship = player.Flagship();
 	bool wasHyperspacing = (flagship && flagship->IsEnteringHyperspace());
 	// Move all the ships.
-	for(const shared_ptr<Ship> &it : ships)
-		MoveShip(it);
+	MoveShips();
 	// If the flagship just began jumping, play the appropriate sound.
 	if(!wasHyperspacing && flagship && flagship->IsEnteringHyperspace())
 	{
@@ -1341,9 +1402,23 @@ void Engine::CalculateStep()
 		it->Move(newVisuals);
 	Prune(flotsam);
 	
-	// Move the projectiles.
-	for(Projectile &projectile : projectiles)
-		projectile.Move(newVisuals, newProjectiles);
+	// Move the projectiles. This is done in parallel, with each block of
+	// projectiles collecting the effects and submunitions it creates in buffers
+	// of its own, which are added in projectile order. Each block draws from
+	// its own random number stream, so the outcome does not depend on how many
+	// threads there are.
+	FindTargetableShips();
+	ThreadPool::Run(projectiles.size(), [this](int block, size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; ++i)
+			projectiles[i].Move(blockVisuals[block], blockProjectiles[block], targetableShips);
+	});
+	for(size_t block = 0; block < blockVisuals.size(); ++block)
+	{
+		Append(newVisuals, blockVisuals[block]);
+		Append(newProjectiles, blockProjectiles[block]);
+	}
+	targetableShips.clear();
 	Prune(projectiles);
 	
 	// Step the weather.
@@ -1352,9 +1427,7 @@ void Engine::CalculateStep()
 	Prune(activeWeather);
 	
 	// Move the visuals.
-	for(Visual &visual : visuals)
-		visual.Move();
-	Prune(visuals);
+	visuals.Move();
 	
 	// Perform various minor actions.
 	SpawnFleets();
@@ -1371,7 +1444,18 @@ void Engine::CalculateStep()
 	ships.splice(ships.end(), newShips);
 	Append(projectiles, newProjectiles);
 	flotsam.splice(flotsam.end(), newFlotsam);
-	Append(visuals, newVisuals);
+	
+	// The projectile buffers are compacted in place and never shrink, so once
+	// they are big enough for the battle in progress they stop allocating.
+	// Keep track of how often they still have to grow.
+	size_t capacity = projectiles.capacity() + newProjectiles.capacity();
+	for(const vector<Projectile> &buffer : blockProjectiles)
+		capacity += buffer.capacity();
+	if(capacity > projectileCapacity)
+	{
+		projectileCapacity = capacity;
+		++projectileAllocations;
+	}
 	
 	// Decrement the count of how long it's been since a ship last asked for help.
 	if(grudgeTime)
@@ -1391,6 +1475,10 @@ void Engine::CalculateStep()
 	for(Weather &weather : activeWeather)
 		DoWeather(weather);
 	
+	// The visuals created this step, including any explosions from collisions
+	// and weather, start out in the particle system now.
+	visuals.Append(newVisuals, step);
+	
 	// Check for flotsam collection (collisions with ships).
 	for(const shared_ptr<Flotsam> &it : flotsam)
 		DoCollection(*it);
@@ -1408,7 +1496,7 @@ void Engine::CalculateStep()
 		newCenterVelocity = flagship->Velocity();
 	}
 	draw[calcTickTock].SetCenter(newCenter, newCenterVelocity);
-	batchDraw[calcTickTock].SetCenter(newCenter);
+	batchDraw[calcTickTock].SetCenter(newCenter, newCenterVelocity);
 	radar[calcTickTock].SetCenter(newCenter);
 	
 	// Populate the radar.
@@ -1480,33 +1568,66 @@ void Engine::CalculateStep()
 	for(const Projectile &projectile : projectiles)
 		batchDraw[calcTickTock].Add(projectile, projectile.Clip());
 	// Draw the visuals.
-	for(const Visual &visual : visuals)
-		batchDraw[calcTickTock].AddVisual(visual);
+	visuals.Draw(batchDraw[calcTickTock], step);
 	
 	// Keep track of how much of the CPU time we are using.
 	loadSum += loadTimer.Time();
+	eventSum += eventQueue.size();
 	if(++loadCount == 60)
 	{
 		load = loadSum;
 		loadSum = 0.;
+		eventLoad = eventSum / 60.;
+		eventSum = 0;
 		loadCount = 0;
 	}
 }
 
 
 
+// Move all the ships. The part of each ship's movement that does not involve
+// any other ships is done in parallel, with the visuals and flotsam created by
+// each block of ships collected separately and then added in ship order. Each
+// block has its own random number stream, so the outcome does not depend on
+// how many threads there are. Everything else is done one ship at a time.
+void Engine::MoveShips()
+{
+	const Ship *flagship = player.Flagship();
+	movingShips.clear();
+	for(const shared_ptr<Ship> &it : ships)
+		movingShips.emplace_back(it, flagship);
+	
+	ThreadPool::Run(movingShips.size(), [this](int block, size_t begin, size_t end)
+	{
+		// Give each ship the list of visuals so that it can draw explosions,
+		// ion sparks, jump drive flashes, etc.
+		for(size_t i = begin; i < end; ++i)
+			movingShips[i].ship->Move(blockVisuals[block], blockFlotsam[block]);
+	});
+	for(size_t block = 0; block < blockVisuals.size(); ++block)
+	{
+		Append(newVisuals, blockVisuals[block]);
+		newFlotsam.splice(newFlotsam.end(), blockFlotsam[block]);
+	}
+	
+	for(const MovingShip &it : movingShips)
+		MoveShip(it);
+	movingShips.clear();
+}
+
+
+
 // Move a ship. Also determine if the ship should generate hyperspace sounds or
 // boarding events, fire weapons, and launch fighters.
-void Engine::MoveShip(const shared_ptr<Ship> &ship)
+void Engine::MoveShip(const MovingShip &moving)
 {
+	const shared_ptr<Ship> &ship = moving.ship;
 	const Ship *flagship = player.Flagship();
 	
-	bool isJump = ship->IsUsingJumpDrive();
-	bool wasHere = (flagship && ship->GetSystem() == flagship->GetSystem());
-	bool wasHyperspacing = ship->IsHyperspacing();
-	// Give the ship the list of visuals so that it can draw explosions,
-	// ion sparks, jump drive flashes, etc.
-	ship->Move(newVisuals, newFlotsam);
+	bool isJump = moving.isJump;
+	bool wasHere = moving.wasHere;
+	bool wasHyperspacing = moving.wasHyperspacing;
+	ship->FinishMove(newVisuals);
 	// Bail out if the ship just died.
 	if(ship->ShouldBeRemoved())
 	{
@@ -1575,6 +1696,19 @@ void Engine::MoveShip(const shared_ptr<Ship> &ship)
 
 
 
+// Find all the ships that projectiles can track in this step, sorted so that
+// projectiles can look up their targets without locking a weak pointer each.
+void Engine::FindTargetableShips()
+{
+	targetableShips.clear();
+	for(const shared_ptr<Ship> &ship : ships)
+		if(ship->IsTargetable())
+			targetableShips.push_back(ship);
+	sort(targetableShips.begin(), targetableShips.end(), owner_less<shared_ptr<Ship>>());
+}
+
+
+
 // Populate the ship collision detection set for projectile & flotsam computations.
 void Engine::FillCollisionSets()
 {
@@ -1896,9 +2030,9 @@ void Engine::HandleMouseClicks()
 
 
 
-// Perform collision detection. Note that unlike the preceding functions, this
-// one adds any visuals that are created directly to the main visuals list. If
-// this is multi-threaded in the future, that will need to change.
+// Perform collision detection. Any visuals that are created are added to the
+// list of new visuals, which is handed to the particle system after all the
+// collisions have been handled.
 void Engine::DoCollisions(Projectile &projectile)
 {
 	// The asteroids can collide with projectiles, the same as any other
@@ -1969,7 +2103,7 @@ void Engine::DoCollisions(Projectile &projectile)
 	{
 		// Create the explosion the given distance along the projectile's
 		// motion path for this step.
-		projectile.Explode(visuals, closestHit, hitVelocity);
+		projectile.Explode(newVisuals, closestHit, hitVelocity);
 		
 		// If this projectile has a blast radius, find all ships within its
 		// radius. Otherwise, only one is damaged.
@@ -2007,7 +2141,7 @@ void Engine::DoCollisions(Projectile &projectile)
 		// a chance to shoot it down.
 		for(Ship *ship : hasAntiMissile)
 			if(ship == projectile.Target() || gov->IsEnemy(ship->GetGovernment()))
-				if(ship->FireAntiMissile(projectile, visuals))
+				if(ship->FireAntiMissile(projectile, newVisuals))
 				{
 					projectile.Kill();
 					break;
@@ -2018,8 +2152,8 @@ void Engine::DoCollisions(Projectile &projectile)
 
 
 // Determine whether any active weather events have impacted the ships within
-// the system. As with DoCollisions, this function adds visuals directly to
-// the main visuals list.
+// the system. As with DoCollisions, this function adds visuals to the list of
+// new visuals.
 void Engine::DoWeather(Weather &weather)
 {
 	weather.CalculateStrength();
@@ -2032,7 +2166,7 @@ void Engine::DoWeather(Weather &weather)
 		// and max ranges at the hazard's origin. Any ship touching this ring takes
 		// hazard damage.
 		for(Body *body : shipCollisions.Ring(Point(), hazard->MinRange(), hazard->MaxRange()))
-			reinterpret_cast<Ship *>(body)->TakeHazardDamage(visuals, hazard, multiplier);
+			reinterpret_cast<Ship *>(body)->TakeHazardDamage(newVisuals, hazard, multiplier);
 	}
 }
 
@@ -2346,7 +2480,16 @@ void Engine::DoGrudge(const shared_ptr<Ship> &target, const Government *attacker
 
 
 // Constructor for the ship status display rings.
-Engine::Status::Status(const Point &position, double outer, double inner, double disabled, double radius, int type, double angle)
-	: position(position), outer(outer), inner(inner), disabled(disabled), radius(radius), type(type), angle(angle)
+Engine::MovingShip::MovingShip(const shared_ptr<Ship> &ship, const Ship *flagship)
+	: ship(ship), isJump(ship->IsUsingJumpDrive()),
+	wasHere(flagship && ship->GetSystem() == flagship->GetSystem()),
+	wasHyperspacing(ship->IsHyperspacing())
+{
+}
+
+
+
+Engine::Status::Status(const Point &position, const Point &velocity, double outer, double inner, double disabled, double radius, int type, double angle)
+	: position(position), velocity(velocity), outer(outer), inner(inner), disabled(disabled), radius(radius), type(type), angle(angle)
 {
 }
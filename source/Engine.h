@@ -21,6 +21,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "DrawList.h"
 #include "EscortDisplay.h"
 #include "Information.h"
+#include "ParticleSystem.h"
 #include "Point.h"
 #include "Radar.h"
 #include "Rectangle.h"
@@ -75,10 +76,12 @@ public:
 	
 	// Get any special events that happened in this step.
 	// MainPanel::Step will clear this list.
-	std::list<ShipEvent> &Events();
+	std::vector<ShipEvent> &Events();
 	
-	// Draw a frame.
-	void Draw() const;
+	// Draw a frame. Anything that is moving is drawn the given fraction of a
+	// step further along its velocity, so that frames can be drawn more often
+	// than steps are taken.
+	void Draw(double interpolation = 0.) const;
 	
 	// Give an (automated/scripted) command on behalf of the player.
 	void GiveCommand(const Command &command);
@@ -89,13 +92,29 @@ public:
 	void SelectGroup(int group, bool hasShift, bool hasControl);
 	
 	
+private:
+	// The state a ship was in before it moved, which is used to tell whether it
+	// has just jumped into or out of the player's system.
+	class MovingShip {
+	public:
+		MovingShip(const std::shared_ptr<Ship> &ship, const Ship *flagship);
+		
+		std::shared_ptr<Ship> ship;
+		bool isJump;
+		bool wasHere;
+		bool wasHyperspacing;
+	};
+	
+	
 private:
 	void EnterSystem();
 	
 	void ThreadEntryPoint();
 	void CalculateStep();
 	
-	void MoveShip(const std::shared_ptr<Ship> &ship);
+	void MoveShips();
+	void MoveShip(const MovingShip &moving);
+	void FindTargetableShips();
 	
 	void SpawnFleets();
 	void SpawnPersons();
@@ -122,6 +141,7 @@ private:
 	class Target {
 	public:
 		Point center;
+		Point velocity;
 		Angle angle;
 		double radius;
 		int type;
@@ -130,9 +150,10 @@ private:
 	
 	class Status {
 	public:
-		Status(const Point &position, double outer, double inner, double disabled, double radius, int type, double angle = 0.);
+		Status(const Point &position, const Point &velocity, double outer, double inner, double disabled, double radius, int type, double angle = 0.);
 		
 		Point position;
+		Point velocity;
 		double outer;
 		double inner;
 		double disabled;
@@ -149,7 +170,7 @@ private:
 	std::vector<Projectile> projectiles;
 	std::vector<Weather> activeWeather;
 	std::list<std::shared_ptr<Flotsam>> flotsam;
-	std::vector<Visual> visuals;
+	ParticleSystem visuals;
 	AsteroidField asteroids;
 	
 	// New objects created within the latest step:
@@ -158,6 +179,15 @@ private:
 	std::list<std::shared_ptr<Flotsam>> newFlotsam;
 	std::vector<Visual> newVisuals;
 	
+	// The ships being moved in this step, and the objects that each block of
+	// ships or projectiles created while moving in parallel.
+	std::vector<MovingShip> movingShips;
+	std::vector<std::vector<Visual>> blockVisuals;
+	std::vector<std::list<std::shared_ptr<Flotsam>>> blockFlotsam;
+	std::vector<std::vector<Projectile>> blockProjectiles;
+	// The ships that projectiles can track in this step, sorted by owner.
+	std::vector<std::shared_ptr<Ship>> targetableShips;
+	
 	// Track which ships currently have anti-missiles ready to fire.
 	std::vector<Ship *> hasAntiMissile;
 	
@@ -195,8 +225,11 @@ private:
 	
 	int step = 0;
 	
-	std::list<ShipEvent> eventQueue;
-	std::list<ShipEvent> events;
+	// Events are double buffered: the calculation thread adds to eventQueue
+	// while the previous step's events are being handled. Both vectors keep
+	// their capacity, so no allocations are needed in a typical step.
+	std::vector<ShipEvent> eventQueue;
+	std::vector<ShipEvent> events;
 	// Keep track of who has asked for help in fighting whom.
 	std::map<const Government *, std::weak_ptr<const Ship>> grudge;
 	int grudgeTime = 0;
@@ -233,6 +266,12 @@ private:
 	double load = 0.;
 	int loadCount = 0;
 	double loadSum = 0.;
+	// The average number of ShipEvents generated per step.
+	double eventLoad = 0.;
+	size_t eventSum = 0;
+	// The number of steps in which the projectile buffers had to grow.
+	unsigned projectileAllocations = 0;
+	size_t projectileCapacity = 0;
 };
 
 
@@ -140,6 +140,7 @@ void EscortDisplay::Draw(const Rectangle &bounds) const
 			fullColor[2].Additive(.5), fullColor[3].Additive(.5), fullColor[4].Additive(.5),
 		};
 		Point from(pos.X() + .5 * ICON_SIZE + BAR_PAD, pos.Y() - 8.5);
+		LineShader::Bind();
 		for(int i = 0; i < 5; ++i)
 		{
 			// If the low and high levels are different, draw a fully opaque bar up
@@ -150,12 +151,12 @@ void EscortDisplay::Draw(const Rectangle &bounds) const
 				const Color &color = (isSplit ? halfColor : fullColor)[i];
 				
 				Point to = from + Point(width * min(1., escort.high[i]), 0.);
-				LineShader::Draw(from, to, 1.5f, color);
+				LineShader::Add(from, to, 1.5f, color);
 				
 				if(isSplit)
 				{
 					Point to = from + Point(width * max(0., escort.low[i]), 0.);
-					LineShader::Draw(from, to, 1.5f, color);
+					LineShader::Add(from, to, 1.5f, color);
 				}
 			}
 			from.Y() += 4.;
@@ -165,6 +166,7 @@ void EscortDisplay::Draw(const Rectangle &bounds) const
 				width -= 5.;
 			}
 		}
+		LineShader::Unbind();
 	}
 }
 
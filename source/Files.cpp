@@ -17,6 +17,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <SDL2/SDL.h>
 
 #if defined _WIN32
+#include <io.h>
 #include <windows.h>
 #endif
 
@@ -441,6 +442,23 @@ time_t Files::Timestamp(const string &filePath)
 
 
 
+// Get the size of the given file in bytes, or 0 if it does not exist.
+size_t Files::Size(const string &filePath)
+{
+#if defined _WIN32
+	struct _stat buf;
+	if(_wstat(ToUTF16(filePath).c_str(), &buf))
+		return 0;
+#else
+	struct stat buf;
+	if(stat(filePath.c_str(), &buf))
+		return 0;
+#endif
+	return buf.st_size;
+}
+
+
+
 void Files::Copy(const string &from, const string &to)
 {
 #if defined _WIN32
@@ -513,9 +531,6 @@ string Files::Read(FILE *file)
 	size_t start = ftell(file);
 	fseek(file, 0, SEEK_END);
 	size_t size = ftell(file) - start;
-	// Reserve one extra byte because DataFile appends a '\n' to the end of each
-	// file it reads, and that's the most common use of this function.
-	result.reserve(size + 1);
 	result.resize(size);
 	fseek(file, start, SEEK_SET);
 	
@@ -547,6 +562,37 @@ void Files::Write(FILE *file, const string &data)
 
 
 
+bool Files::WriteAtomic(const string &path, const string &data)
+{
+	const string temp = path + ".tmp";
+	FILE *file = Open(temp, true);
+	if(!file)
+		return false;
+	
+	bool success = (fwrite(data.data(), 1, data.size(), file) == data.size());
+	success &= !fflush(file);
+	// Make sure the data is actually on the disk before the rename makes it
+	// visible; otherwise a crash could leave an empty file in its place.
+#if defined _WIN32
+	success &= !_commit(_fileno(file));
+#else
+	success &= !fsync(fileno(file));
+#endif
+	success &= !fclose(file);
+	
+#if defined _WIN32
+	success = success && MoveFileExW(ToUTF16(temp).c_str(), ToUTF16(path).c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+	success = success && !rename(temp.c_str(), path.c_str());
+#endif
+	if(!success)
+		Delete(temp);
+	return success;
+}
+
+
+
 void Files::LogError(const string &message)
 {
 	lock_guard<mutex> lock(errorMutex);
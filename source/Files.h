@@ -50,6 +50,8 @@ public:
 	
 	static bool Exists(const std::string &filePath);
 	static std::time_t Timestamp(const std::string &filePath);
+	// Get the size of the given file in bytes, or 0 if it does not exist.
+	static size_t Size(const std::string &filePath);
 	static void Copy(const std::string &from, const std::string &to);
 	static void Move(const std::string &from, const std::string &to);
 	static void Delete(const std::string &filePath);
@@ -63,6 +65,10 @@ public:
 	static std::string Read(FILE *file);
 	static void Write(const std::string &path, const std::string &data);
 	static void Write(FILE *file, const std::string &data);
+	// Write the data to a temporary file, flush it to the disk, and then rename
+	// it over the given path, so that the file is never left half written.
+	// Returns false if any step fails, in which case the file is unchanged.
+	static bool WriteAtomic(const std::string &path, const std::string &data);
 	
 	static void LogError(const std::string &message);
 };
@@ -18,18 +18,40 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Shader.h"
 
 #include <stdexcept>
+#include <vector>
 
 using namespace std;
 
 namespace {
 	Shader shader;
 	GLint scaleI;
-	GLint centerI;
-	GLint sizeI;
-	GLint colorI;
 	
 	GLuint vao;
 	GLuint vbo;
+	
+	// Each region is drawn as two triangles. Each vertex holds the corner of
+	// the region it is at, followed by the region's center, size, and color.
+	const int VERTEX_SIZE = 10;
+	const GLfloat CORNERS[] = {
+		-.5f, -.5f,
+		 .5f, -.5f,
+		-.5f,  .5f,
+		 .5f, -.5f,
+		-.5f,  .5f,
+		 .5f,  .5f
+	};
+	// The vertices of all the regions added since the last Bind().
+	vector<GLfloat> vertices;
+	
+	// Point the attribute with the given name at the given number of floats,
+	// starting at the given offset into each vertex.
+	void EnableAttribute(const char *name, int size, int offset)
+	{
+		GLint attrib = shader.Attrib(name);
+		glEnableVertexAttribArray(attrib);
+		glVertexAttribPointer(attrib, size, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),
+			reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+	}
 }
 
 
@@ -39,48 +61,42 @@ void FillShader::Init()
 	static const char *vertexCode =
 		"// vertex fill shader\n"
 		"uniform vec2 scale;\n"
-		"uniform vec2 center;\n"
-		"uniform vec2 size;\n"
 		
 		"in vec2 vert;\n"
+		"in vec2 center;\n"
+		"in vec2 size;\n"
+		"in vec4 color;\n"
+		"flat out vec4 fillColor;\n"
 		
 		"void main() {\n"
+		"  fillColor = color;\n"
 		"  gl_Position = vec4((center + vert * size) * scale, 0, 1);\n"
 		"}\n";
 
 	static const char *fragmentCode =
 		"// fragment fill shader\n"
-		"uniform vec4 color = vec4(1, 1, 1, 1);\n"
 		
+		"flat in vec4 fillColor;\n"
 		"out vec4 finalColor;\n"
 		
 		"void main() {\n"
-		"  finalColor = color;\n"
+		"  finalColor = fillColor;\n"
 		"}\n";
 	
 	shader = Shader(vertexCode, fragmentCode);
 	scaleI = shader.Uniform("scale");
-	centerI = shader.Uniform("center");
-	sizeI = shader.Uniform("size");
-	colorI = shader.Uniform("color");
 	
-	// Generate the vertex data for drawing sprites.
+	// Generate the buffer for uploading the fill vertex data.
 	glGenVertexArrays(1, &vao);
 	glBindVertexArray(vao);
 	
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	
-	GLfloat vertexData[] = {
-		-.5f, -.5f,
-		 .5f, -.5f,
-		-.5f,  .5f,
-		 .5f,  .5f
-	};
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertexData), vertexData, GL_STATIC_DRAW);
-	
-	glEnableVertexAttribArray(shader.Attrib("vert"));
-	glVertexAttribPointer(shader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	EnableAttribute("vert", 2, 0);
+	EnableAttribute("center", 2, 2);
+	EnableAttribute("size", 2, 4);
+	EnableAttribute("color", 4, 6);
 	
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -90,9 +106,49 @@ void FillShader::Init()
 
 
 void FillShader::Fill(const Point &center, const Point &size, const Color &color)
+{
+	Bind();
+	
+	Add(center, size, color);
+	
+	Unbind();
+}
+
+
+
+// Start a batch of regions. Nothing is drawn until Unbind() is called.
+void FillShader::Bind()
 {
 	if(!shader.Object())
-		throw runtime_error("FillShader: Draw() called before Init().");
+		throw runtime_error("FillShader: Bind() called before Init().");
+	
+	vertices.clear();
+}
+
+
+
+void FillShader::Add(const Point &center, const Point &size, const Color &color)
+{
+	const float *rgba = color.Get();
+	const GLfloat region[VERTEX_SIZE - 2] = {
+		static_cast<float>(center.X()), static_cast<float>(center.Y()),
+		static_cast<float>(size.X()), static_cast<float>(size.Y()),
+		rgba[0], rgba[1], rgba[2], rgba[3]
+	};
+	for(int i = 0; i < 6; ++i)
+	{
+		vertices.insert(vertices.end(), CORNERS + 2 * i, CORNERS + 2 * i + 2);
+		vertices.insert(vertices.end(), region, region + VERTEX_SIZE - 2);
+	}
+}
+
+
+
+// Fill all the regions added since Bind() with a single draw call.
+void FillShader::Unbind()
+{
+	if(vertices.empty())
+		return;
 	
 	glUseProgram(shader.Object());
 	glBindVertexArray(vao);
@@ -100,15 +156,12 @@ void FillShader::Fill(const Point &center, const Point &size, const Color &color
 	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
 	glUniform2fv(scaleI, 1, scale);
 	
-	GLfloat centerV[2] = {static_cast<float>(center.X()), static_cast<float>(center.Y())};
-	glUniform2fv(centerI, 1, centerV);
-	
-	GLfloat sizeV[2] = {static_cast<float>(size.X()), static_cast<float>(size.Y())};
-	glUniform2fv(sizeI, 1, sizeV);
-	
-	glUniform4fv(colorI, 1, color.Get());
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glDrawArrays(GL_TRIANGLES, 0, vertices.size() / VERTEX_SIZE);
+	vertices.clear();
 	
 	glBindVertexArray(0);
 	glUseProgram(0);
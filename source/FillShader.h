@@ -20,12 +20,18 @@ class Color;
 
 // Class holding a function to fill a rectangular region of the screen with a
 // given color. This can be used with translucent colors to darken or lighten a
-// part of the screen, or with additive colors (alpha = 0) as well.
+// part of the screen, or with additive colors (alpha = 0) as well. Regions
+// added between Bind() and Unbind() are all filled at once, when Unbind() is
+// called.
 class FillShader {
 public:
 	static void Init();
 	
 	static void Fill(const Point &center, const Point &size, const Color &color);
+	
+	static void Bind();
+	static void Add(const Point &center, const Point &size, const Color &color);
+	static void Unbind();
 };
 
 
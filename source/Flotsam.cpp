@@ -21,16 +21,141 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "SpriteSet.h"
 #include "Visual.h"
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
 
 using namespace std;
 
-
+namespace {
+	// Flotsam is created and destroyed by the dozen whenever a ship dies, so
+	// the memory for it is recycled instead of being returned to the heap. All
+	// the blocks in the pool are the same size: that of one flotsam object
+	// together with its shared_ptr control block. The pool is never destroyed,
+	// because flotsam may outlive it during static destruction.
+	class Pool {
+	public:
+		void *Allocate(size_t size);
+		void Free(void *block, size_t size);
+		
+		unsigned Allocations();
+		
+	private:
+		// Each free block holds a pointer to the next free block.
+		void *freeBlocks = nullptr;
+		size_t blockSize = 0;
+		unsigned allocations = 0;
+		mutex poolMutex;
+	};
+	
+	Pool &GetPool()
+	{
+		static Pool *pool = new Pool;
+		return *pool;
+	}
+	
+	// Allocator that takes its memory from the pool.
+	template <class Type>
+	class PoolAllocator {
+	public:
+		using value_type = Type;
+		
+		PoolAllocator() = default;
+		template <class Other>
+		PoolAllocator(const PoolAllocator<Other> &) {}
+		
+		Type *allocate(size_t count)
+		{
+			return static_cast<Type *>(GetPool().Allocate(count * sizeof(Type)));
+		}
+		void deallocate(Type *block, size_t count)
+		{
+			GetPool().Free(block, count * sizeof(Type));
+		}
+	};
+	
+	template <class Type, class Other>
+	bool operator==(const PoolAllocator<Type> &, const PoolAllocator<Other> &)
+	{
+		return true;
+	}
+	
+	template <class Type, class Other>
+	bool operator!=(const PoolAllocator<Type> &, const PoolAllocator<Other> &)
+	{
+		return false;
+	}
+	
+	
+	
+	void *Pool::Allocate(size_t size)
+	{
+		lock_guard<mutex> lock(poolMutex);
+		if(!blockSize)
+			blockSize = max(size, sizeof(void *));
+		if(size <= blockSize && freeBlocks)
+		{
+			void *block = freeBlocks;
+			freeBlocks = *static_cast<void **>(block);
+			return block;
+		}
+		
+		++allocations;
+		return ::operator new(max(size, blockSize));
+	}
+	
+	
+	
+	void Pool::Free(void *block, size_t size)
+	{
+		lock_guard<mutex> lock(poolMutex);
+		if(size > blockSize)
+		{
+			::operator delete(block);
+			return;
+		}
+		*static_cast<void **>(block) = freeBlocks;
+		freeBlocks = block;
+	}
+	
+	
+	
+	unsigned Pool::Allocations()
+	{
+		lock_guard<mutex> lock(poolMutex);
+		return allocations;
+	}
+}
 
 const int Flotsam::TONS_PER_BOX = 5;
 
 
 
+// Create flotsam carrying either a commodity or an outfit. Its memory comes
+// from a pool, and is reused once it is destroyed.
+shared_ptr<Flotsam> Flotsam::Create(const string &commodity, int count)
+{
+	return allocate_shared<Flotsam>(PoolAllocator<Flotsam>(), commodity, count);
+}
+
+
+
+shared_ptr<Flotsam> Flotsam::Create(const Outfit *outfit, int count)
+{
+	return allocate_shared<Flotsam>(PoolAllocator<Flotsam>(), outfit, count);
+}
+
+
+
+// Get the number of times that the memory pool for flotsam has had to
+// allocate a new block from the heap.
+unsigned Flotsam::Allocations()
+{
+	return GetPool().Allocations();
+}
+
+
+
 // Constructors for flotsam carrying either a commodity or an outfit.
 Flotsam::Flotsam(const string &commodity, int count)
 	: commodity(commodity), count(count)
@@ -17,6 +17,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Body.h"
 #include "Point.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,12 @@ public:
 	// Constructors for flotsam carrying either a commodity or an outfit.
 	Flotsam(const std::string &commodity, int count);
 	Flotsam(const Outfit *outfit, int count);
+	// Create flotsam in pooled memory. This is how flotsam should normally be
+	// created, because memory for it is reused rather than allocated each time.
+	static std::shared_ptr<Flotsam> Create(const std::string &commodity, int count);
+	static std::shared_ptr<Flotsam> Create(const Outfit *outfit, int count);
+	// Get the number of times the flotsam pool has had to allocate more memory.
+	static unsigned Allocations();
 	
 	/* Functions provided by the Body base class:
 	Frame GetFrame(int step = -1) const;
@@ -20,6 +20,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "DataFile.h"
 #include "DataNode.h"
 #include "DataWriter.h"
+#include "DistanceTable.h"
+#include "Economy.h"
 #include "Effect.h"
 #include "Files.h"
 #include "FillShader.h"
@@ -58,6 +60,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "TestData.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include <set>
@@ -103,8 +106,12 @@ namespace {
 	
 	Politics politics;
 	vector<StartConditions> startConditions;
+	// The number of jumps between every pair of systems, which must be kept
+	// up to date with the hyperspace links.
+	DistanceTable distances;
 	
 	Trade trade;
+	Economy economy;
 	map<const System *, map<string, int>> purchases;
 	
 	map<const Sprite *, string> landingMessages;
@@ -162,6 +169,9 @@ bool GameData::BeginLoad(const char * const *argv)
 	bool printShips = false;
 	bool printTests = false;
 	bool printWeapons = false;
+	bool printEconomy = false;
+	int economyDays = 0;
+	uint64_t economySeed = 0;
 	bool debugMode = false;
 	for(const char * const *it = argv + 1; *it; ++it)
 	{
@@ -176,6 +186,13 @@ bool GameData::BeginLoad(const char * const *argv)
 				printTests = true;
 			if(arg == "-d" || arg == "--debug")
 				debugMode = true;
+			if(arg == "--economy" && *(it + 1))
+			{
+				printEconomy = true;
+				economyDays = max(0, atoi(*++it));
+			}
+			if(arg == "--seed" && *(it + 1))
+				economySeed = strtoull(*++it, nullptr, 10);
 			continue;
 		}
 	}
@@ -199,9 +216,11 @@ bool GameData::BeginLoad(const char * const *argv)
 		// Check that the image set is complete.
 		it.second->Check();
 		// For landscapes, remember all the source files but don't load them yet.
+		// The economy simulation never draws anything, so it skips loading
+		// the sprites entirely.
 		if(ImageSet::IsDeferred(it.first))
 			deferred[SpriteSet::Get(it.first)] = it.second;
-		else
+		else if(!printEconomy)
 			spriteQueue.Add(it.second);
 	}
 	
@@ -256,7 +275,9 @@ bool GameData::BeginLoad(const char * const *argv)
 		PrintTestsTable();
 	if(printWeapons)
 		PrintWeaponTable();
-	return !(printShips || printWeapons || printTests);
+	if(printEconomy)
+		PrintEconomyTable(economyDays, economySeed);
+	return !(printShips || printWeapons || printTests || printEconomy);
 }
 
 
@@ -353,7 +374,7 @@ void GameData::CheckReferences()
 
 
 
-void GameData::LoadShaders(bool useShaderSwizzle)
+void GameData::LoadShaders(bool useShaderSwizzle, bool useInstancing)
 {
 	FontSet::Add(Files::Images() + "font/ubuntu14r.png", 14);
 	FontSet::Add(Files::Images() + "font/ubuntu18r.png", 18);
@@ -368,7 +389,7 @@ void GameData::LoadShaders(bool useShaderSwizzle)
 	OutlineShader::Init();
 	PointerShader::Init();
 	RingShader::Init();
-	SpriteShader::Init(useShaderSwizzle);
+	SpriteShader::Init(useShaderSwizzle, useInstancing);
 	BatchShader::Init();
 	
 	background.Init(16384, 4096);
@@ -473,6 +494,7 @@ void GameData::Revert()
 	governments.Revert(defaultGovernments);
 	planets.Revert(defaultPlanets);
 	systems.Revert(defaultSystems);
+	UpdateSystems();
 	galaxies.Revert(defaultGalaxies);
 	shipSales.Revert(defaultShipSales);
 	outfitSales.Revert(defaultOutfitSales);
@@ -572,7 +594,7 @@ void GameData::WriteEconomy(DataWriter &out)
 
 
 
-void GameData::StepEconomy()
+void GameData::StepEconomy(int days)
 {
 	// First, apply any purchases the player made. These are deferred until now
 	// so that prices will not change as you are buying or selling goods.
@@ -584,29 +606,9 @@ void GameData::StepEconomy()
 	}
 	purchases.clear();
 	
-	// Then, have each system generate new goods for local use and trade.
-	for(auto &it : systems)
-		it.second.StepEconomy();
-	
-	// Finally, send out the trade goods. This has to be done in a separate step
-	// because otherwise whichever systems trade last would already have gotten
-	// supplied by the other systems.
-	for(auto &it : systems)
-	{
-		System &system = it.second;
-		if(!system.Links().empty())
-			for(const Trade::Commodity &commodity : trade.Commodities())
-			{
-				double supply = system.Supply(commodity.name);
-				for(const System *neighbor : system.Links())
-				{
-					double scale = neighbor->Links().size();
-					if(scale)
-						supply += neighbor->Exports(commodity.name) / scale;
-				}
-				system.SetSupply(commodity.name, supply);
-			}
-	}
+	// Then, have each system generate new goods for local use and trade, and
+	// send out the trade goods to its neighbors.
+	economy.Step(days);
 }
 
 
@@ -659,6 +661,9 @@ void GameData::UpdateSystems()
 			continue;
 		it.second.UpdateSystem(systems, neighborDistances);
 	}
+	distances.Update(systems);
+	// The economy's layout only has to be rebuilt when the systems change.
+	economy.Load(systems, trade);
 }
 
 
@@ -845,6 +850,13 @@ const Set<System> &GameData::Systems()
 
 
 
+const DistanceTable &GameData::Distances()
+{
+	return distances;
+}
+
+
+
 const Government *GameData::PlayerGovernment()
 {
 	return playerGovernment;
@@ -1327,3 +1339,40 @@ void GameData::PrintWeaponTable()
 	}
 	cout.flush();
 }
+
+
+
+// Advance the economy by the given number of days, starting from the default
+// supplies, and print the resulting supply and price of each commodity in each
+// system as comma-separated values.
+void GameData::PrintEconomyTable(int days, uint64_t seed)
+{
+	Random::Seed(seed);
+	StepEconomy(days);
+	
+	auto quote = [](const string &text) -> string
+	{
+		string result = "\"";
+		for(char c : text)
+		{
+			if(c == '"')
+				result += '"';
+			result += c;
+		}
+		return result + '"';
+	};
+	cout << "system" << ',' << "commodity" << ',' << "supply" << ',' << "price" << '\n';
+	for(const auto &it : systems)
+	{
+		const System &system = it.second;
+		if(!system.IsValid() || !system.HasTrade())
+			continue;
+		
+		for(const Trade::Commodity &commodity : trade.Commodities())
+		{
+			cout << quote(system.Name()) << ',' << quote(commodity.name) << ',';
+			cout << system.Supply(commodity.name) << ',' << system.Trade(commodity.name) << '\n';
+		}
+	}
+	cout.flush();
+}
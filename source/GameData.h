@@ -17,6 +17,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Set.h"
 #include "Trade.h"
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -27,6 +28,7 @@ class Conversation;
 class DataNode;
 class DataWriter;
 class Date;
+class DistanceTable;
 class Effect;
 class Fleet;
 class Galaxy;
@@ -64,7 +66,7 @@ public:
 	static bool BeginLoad(const char * const *argv);
 	// Check for objects that are referred to but never defined.
 	static void CheckReferences();
-	static void LoadShaders(bool useShaderSwizzle);
+	static void LoadShaders(bool useShaderSwizzle, bool useInstancing);
 	// TODO: make Progress() a simple accessor.
 	static double Progress();
 	// Whether initial game loading is complete (sprites and audio are loaded).
@@ -83,7 +85,9 @@ public:
 	// Functions for the dynamic economy.
 	static void ReadEconomy(const DataNode &node);
 	static void WriteEconomy(DataWriter &out);
-	static void StepEconomy();
+	// Advance the economy by the given number of days. Any purchases the
+	// player has made are applied before the first day.
+	static void StepEconomy(int days = 1);
 	static void AddPurchase(const System &system, const std::string &commodity, int tons);
 	// Apply the given change to the universe.
 	static void Change(const DataNode &node);
@@ -118,6 +122,8 @@ public:
 	static const Set<Ship> &Ships();
 	static const Set<Sale<Ship>> &Shipyards();
 	static const Set<System> &Systems();
+	// Get the number of hyperspace jumps between any two systems.
+	static const DistanceTable &Distances();
 	static const Set<Test> &Tests();
 	static const Set<TestData> &TestDataSets();
 	
@@ -156,6 +162,7 @@ private:
 	static void PrintShipTable();
 	static void PrintTestsTable();
 	static void PrintWeaponTable();
+	static void PrintEconomyTable(int days, uint64_t seed);
 };
 
 
@@ -31,6 +31,7 @@ namespace {
 	int width = 0;
 	int height = 0;
 	bool hasSwizzle = false;
+	bool hasInstancing = false;
 	bool supportsAdaptiveVSync = false;
 	
 	// Logs SDL errors and returns true if found
@@ -201,6 +202,12 @@ bool GameWindow::Init()
 	
 	// Check for support of various graphical features.
 	hasSwizzle = HasOpenGLExtension("_texture_swizzle");
+	// Instanced vertex attributes are part of the core profile from OpenGL 3.3.
+	GLint majorVersion = 0;
+	GLint minorVersion = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+	glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+	hasInstancing = (majorVersion > 3 || (majorVersion == 3 && minorVersion >= 3));
 	supportsAdaptiveVSync = HasOpenGLExtension("_swap_control_tear");
 	
 	// Enable the user's preferred VSync state, otherwise update to an available
@@ -367,6 +374,18 @@ int GameWindow::Height()
 
 
 
+// Refresh rate of the display the window is on, or 60 if it is not known.
+int GameWindow::RefreshRate()
+{
+	SDL_DisplayMode mode;
+	if(!mainWindow || SDL_GetWindowDisplayMode(mainWindow, &mode) || mode.refresh_rate <= 0)
+		return 60;
+	
+	return mode.refresh_rate;
+}
+
+
+
 bool GameWindow::IsMaximized()
 {
 	return (SDL_GetWindowFlags(mainWindow) & SDL_WINDOW_MAXIMIZED);
@@ -403,6 +422,13 @@ bool GameWindow::HasSwizzle()
 
 
 
+bool GameWindow::HasInstancing()
+{
+	return hasInstancing;
+}
+
+
+
 void GameWindow::ExitWithError(const string& message, bool doPopUp)
 {
 	// Print the error message in the terminal and the error file.
@@ -40,12 +40,17 @@ public:
 	static int Width();
 	static int Height();
 	
+	// Refresh rate of the display the window is on, or 60 if it is not known.
+	static int RefreshRate();
+	
 	static bool IsMaximized();
 	static bool IsFullscreen();
 	static void ToggleFullscreen();	
 	
 	// Check if the initialized window system supports OpenGL texture_swizzle.
 	static bool HasSwizzle();
+	// Check if the initialized window system supports instanced drawing.
+	static bool HasInstancing();
 	
 	// Print the error message in the terminal, error file, and message box.
 	// Checks for video system errors and records those as well.
@@ -0,0 +1,158 @@
+/* Gzip.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "Gzip.h"
+
+#include "Files.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include <zlib.h>
+
+using namespace std;
+
+namespace {
+	// Adding 16 to the window size tells zlib to use a gzip header and footer
+	// instead of the bare zlib format.
+	const int WINDOW_BITS = 15 + 16;
+	// The data is passed through zlib in pieces of this size.
+	const size_t CHUNK = 1 << 16;
+}
+
+
+
+// Check whether the given data begins with a gzip header.
+bool Gzip::IsCompressed(const string &data)
+{
+	return data.size() >= 2 && static_cast<unsigned char>(data[0]) == 0x1F
+		&& static_cast<unsigned char>(data[1]) == 0x8B;
+}
+
+
+
+string Gzip::Compress(const string &data)
+{
+	z_stream stream = {};
+	if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return string();
+	
+	string result;
+	result.resize(deflateBound(&stream, data.size()));
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+	stream.avail_in = data.size();
+	stream.next_out = reinterpret_cast<Bytef *>(&result[0]);
+	stream.avail_out = result.size();
+	// The output buffer is big enough for the whole stream, so this finishes
+	// in a single call.
+	int status = deflate(&stream, Z_FINISH);
+	result.resize(stream.total_out);
+	deflateEnd(&stream);
+	
+	return (status == Z_STREAM_END) ? result : string();
+}
+
+
+
+string Gzip::Decompress(const string &data)
+{
+	z_stream stream = {};
+	if(inflateInit2(&stream, WINDOW_BITS) != Z_OK)
+		return string();
+	
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+	stream.avail_in = data.size();
+	
+	// The size of the uncompressed data is not known ahead of time, so keep
+	// growing the output until zlib reaches the end of the stream.
+	string result;
+	int status = Z_OK;
+	while(status == Z_OK)
+	{
+		size_t size = result.size();
+		result.resize(size + CHUNK);
+		stream.next_out = reinterpret_cast<Bytef *>(&result[size]);
+		stream.avail_out = CHUNK;
+		status = inflate(&stream, Z_NO_FLUSH);
+		result.resize(size + CHUNK - stream.avail_out);
+	}
+	inflateEnd(&stream);
+	
+	return (status == Z_STREAM_END) ? result : string();
+}
+
+
+
+// Read the given file a piece at a time, decompressing it if it is compressed.
+void Gzip::Read(const string &path, const function<bool(const char *data, size_t size)> &function)
+{
+	FILE *file = Files::Open(path);
+	if(!file)
+		return;
+	
+	vector<char> input(CHUNK);
+	vector<char> output;
+	z_stream stream = {};
+	bool isCompressed = false;
+	bool isFirst = true;
+	bool isDone = false;
+	while(!isDone)
+	{
+		size_t size = fread(input.data(), 1, input.size(), file);
+		if(isFirst)
+		{
+			isFirst = false;
+			if(!size)
+				break;
+			isCompressed = IsCompressed(string(input.data(), min<size_t>(size, 2)));
+			if(isCompressed)
+			{
+				if(inflateInit2(&stream, WINDOW_BITS) != Z_OK)
+					break;
+				output.resize(CHUNK);
+			}
+		}
+		if(!isCompressed)
+		{
+			isDone = !size || !function(input.data(), size);
+			continue;
+		}
+		
+		// Once the whole file has been read, have zlib finish off any output
+		// that it is still holding on to.
+		int flush = size ? Z_NO_FLUSH : Z_FINISH;
+		stream.next_in = reinterpret_cast<Bytef *>(input.data());
+		stream.avail_in = size;
+		// If the output buffer was filled, zlib may have more output pending
+		// even if all the input has been used up.
+		do {
+			stream.next_out = reinterpret_cast<Bytef *>(output.data());
+			stream.avail_out = output.size();
+			// Z_BUF_ERROR just means that no progress could be made, or that
+			// the output buffer filled up before zlib could finish.
+			int status = inflate(&stream, flush);
+			if(status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR)
+				isDone = true;
+			else
+			{
+				size_t produced = output.size() - stream.avail_out;
+				isDone = (produced && !function(output.data(), produced)) || status == Z_STREAM_END;
+			}
+		} while(!isDone && (stream.avail_in || !stream.avail_out));
+		// If the file ended before the compressed data did, it was cut short.
+		isDone |= !size;
+	}
+	if(isCompressed)
+		inflateEnd(&stream);
+	fclose(file);
+}
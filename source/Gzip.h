@@ -0,0 +1,44 @@
+/* Gzip.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef GZIP_H_
+#define GZIP_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+
+
+// Functions for converting data to and from the gzip format. Saved games can
+// optionally be written compressed; DataFile checks for the gzip header when
+// loading a file, so either kind of file can be read in the same way.
+class Gzip {
+public:
+	// Check whether the given data begins with a gzip header.
+	static bool IsCompressed(const std::string &data);
+	
+	// If the data cannot be compressed, this returns an empty string.
+	static std::string Compress(const std::string &data);
+	// If the data is not valid gzip data, this returns an empty string.
+	static std::string Decompress(const std::string &data);
+	
+	// Read the given file a piece at a time, decompressing it if it is
+	// compressed, and pass each piece of the data to the given function. Stop
+	// reading as soon as the function returns false. This is for when only
+	// the start of a large file is needed.
+	static void Read(const std::string &path, const std::function<bool(const char *data, size_t size)> &function);
+};
+
+
+
+#endif
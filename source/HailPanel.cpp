@@ -161,30 +161,38 @@ void HailPanel::Draw()
 {
 	DrawBackdrop();
 	
+	static const int HEADER = Information::StringSlot("header");
+	static const int SHOW_ASSIST = Information::ConditionSlot("show assist");
+	static const int CAN_BRIBE = Information::ConditionSlot("can bribe");
+	static const int CAN_ASSIST = Information::ConditionSlot("can assist");
+	static const int SHOW_DOMINATE = Information::ConditionSlot("show dominate");
+	static const int SHOW_RELINQUISH = Information::ConditionSlot("show relinquish");
+	static const int CAN_DOMINATE = Information::ConditionSlot("can dominate");
+	
 	Information info;
-	info.SetString("header", header);
+	info.SetString(HEADER, header);
 	if(ship)
 	{
-		info.SetCondition("show assist");
+		info.SetCondition(SHOW_ASSIST);
 		if(hasLanguage && !ship->IsDisabled())
 		{
 			if(ship->GetGovernment()->IsEnemy())
-				info.SetCondition("can bribe");
+				info.SetCondition(CAN_BRIBE);
 			else if(!ship->CanBeCarried() && ship->GetShipToAssist() != player.FlagshipPtr())
-				info.SetCondition("can assist");
+				info.SetCondition(CAN_ASSIST);
 		}
 	}
 	else
 	{
 		if(!GameData::GetPolitics().HasDominated(planet))
-			info.SetCondition("show dominate");
+			info.SetCondition(SHOW_DOMINATE);
 		else
-			info.SetCondition("show relinquish");
+			info.SetCondition(SHOW_RELINQUISH);
 		if(hasLanguage)
 		{
-			info.SetCondition("can dominate");
+			info.SetCondition(CAN_DOMINATE);
 			if(!planet->CanLand())
-				info.SetCondition("can bribe");
+				info.SetCondition(CAN_BRIBE);
 		}
 	}
 	
@@ -50,6 +50,20 @@ void HiringPanel::Draw()
 	// Draw a line in the same place as the trading and bank panels.
 	FillShader::Fill(Point(-60., 95.), Point(480., 1.), *GameData::Colors().Get("medium"));
 	
+	static const int FLAGSHIP_BUNKS = Information::StringSlot("flagship bunks");
+	static const int FLAGSHIP_REQUIRED = Information::StringSlot("flagship required");
+	static const int FLAGSHIP_EXTRA = Information::StringSlot("flagship extra");
+	static const int FLAGSHIP_UNUSED = Information::StringSlot("flagship unused");
+	static const int FLEET_BUNKS = Information::StringSlot("fleet bunks");
+	static const int FLEET_REQUIRED = Information::StringSlot("fleet required");
+	static const int FLEET_UNUSED = Information::StringSlot("fleet unused");
+	static const int PASSENGERS = Information::StringSlot("passengers");
+	static const int SALARY_REQUIRED = Information::StringSlot("salary required");
+	static const int SALARY_EXTRA = Information::StringSlot("salary extra");
+	static const int MODIFIER = Information::StringSlot("modifier");
+	static const int CAN_HIRE = Information::ConditionSlot("can hire");
+	static const int CAN_FIRE = Information::ConditionSlot("can fire");
+	
 	const Interface *hiring = GameData::Interfaces().Get("hiring");
 	Information info;
 	
@@ -57,10 +71,10 @@ void HiringPanel::Draw()
 	int flagshipRequired = flagship.RequiredCrew();
 	int flagshipExtra = flagship.Crew() - flagshipRequired;
 	int flagshipUnused = flagshipBunks - flagship.Crew();
-	info.SetString("flagship bunks", to_string(flagshipBunks));
-	info.SetString("flagship required", to_string(flagshipRequired));
-	info.SetString("flagship extra", to_string(flagshipExtra));
-	info.SetString("flagship unused", to_string(flagshipUnused));
+	info.SetString(FLAGSHIP_BUNKS, to_string(flagshipBunks));
+	info.SetString(FLAGSHIP_REQUIRED, to_string(flagshipRequired));
+	info.SetString(FLAGSHIP_EXTRA, to_string(flagshipExtra));
+	info.SetString(FLAGSHIP_UNUSED, to_string(flagshipUnused));
 	
 	// Sum up the statistics for all your ships. You still pay the crew of
 	// disabled or out-of-system ships, but any parked ships have no crew costs.
@@ -74,28 +88,28 @@ void HiringPanel::Draw()
 		}
 	int passengers = player.Cargo().Passengers();
 	int fleetUnused = fleetBunks - fleetRequired - flagshipExtra;
-	info.SetString("fleet bunks", to_string(fleetBunks));
-	info.SetString("fleet required", to_string(fleetRequired));
-	info.SetString("fleet unused", to_string(fleetUnused));
-	info.SetString("passengers", to_string(passengers));
+	info.SetString(FLEET_BUNKS, to_string(fleetBunks));
+	info.SetString(FLEET_REQUIRED, to_string(fleetRequired));
+	info.SetString(FLEET_UNUSED, to_string(fleetUnused));
+	info.SetString(PASSENGERS, to_string(passengers));
 	
 	static const int DAILY_SALARY = 100;
 	int salary = DAILY_SALARY * (fleetRequired - 1);
 	int extraSalary = DAILY_SALARY * flagshipExtra;
-	info.SetString("salary required", to_string(salary));
-	info.SetString("salary extra", to_string(extraSalary));
+	info.SetString(SALARY_REQUIRED, to_string(salary));
+	info.SetString(SALARY_EXTRA, to_string(extraSalary));
 	
 	int modifier = Modifier();
 	if(modifier > 1)
-		info.SetString("modifier", "x " + to_string(modifier));
+		info.SetString(MODIFIER, "x " + to_string(modifier));
 	
 	maxFire = max(flagshipExtra, 0);
 	maxHire = max(min(flagshipUnused, fleetUnused - passengers), 0);
 	
 	if(maxHire)
-		info.SetCondition("can hire");
+		info.SetCondition(CAN_HIRE);
 	if(maxFire)
-		info.SetCondition("can fire");
+		info.SetCondition(CAN_FIRE);
 	
 	hiring->Draw(info, this);
 }
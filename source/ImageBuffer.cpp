@@ -12,11 +12,12 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "ImageBuffer.h"
 
-#include "File.h"
+#include "MappedFile.h"
 
 #include <png.h>
 #include <jpeglib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 
@@ -26,6 +27,13 @@ namespace {
 	bool ReadPNG(const string &path, ImageBuffer &buffer, int frame);
 	bool ReadJPG(const string &path, ImageBuffer &buffer, int frame);
 	void Premultiply(ImageBuffer &buffer, int frame, int additive);
+	
+	// The position that libpng has read up to in a file.
+	struct PNGSource {
+		const MappedFile &file;
+		size_t pos;
+	};
+	void ReadPNGData(png_struct *png, png_byte *data, png_size_t length);
 }
 
 
@@ -188,9 +196,10 @@ namespace {
 	bool ReadPNG(const string &path, ImageBuffer &buffer, int frame)
 	{
 		// Open the file, and make sure it really is a PNG.
-		File file(path);
-		if(!file)
+		MappedFile file(path);
+		if(!file.Size())
 			return false;
+		PNGSource source = {file, 0};
 		
 		// Set up libpng.
 		png_struct *png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -210,7 +219,7 @@ namespace {
 			return false;
 		}
 		
-		png_init_io(png, file);
+		png_set_read_fn(png, &source, ReadPNGData);
 		png_set_sig_bytes(png, 0);
 		
 		png_read_info(png, info);
@@ -250,7 +259,7 @@ namespace {
 		
 		png_read_image(png, &rows.front());
 		
-		// Clean up. The file will be closed automatically.
+		// Clean up. The file will be unmapped automatically.
 		png_destroy_read_struct(&png, &info, nullptr);
 		
 		return true;
@@ -260,8 +269,8 @@ namespace {
 	
 	bool ReadJPG(const string &path, ImageBuffer &buffer, int frame)
 	{
-		File file(path);
-		if(!file)
+		MappedFile file(path);
+		if(!file.Size())
 			return false;
 		
 		jpeg_decompress_struct cinfo;
@@ -272,7 +281,8 @@ namespace {
 		jpeg_create_decompress(&cinfo);
 #pragma GCC diagnostic pop
 		
-		jpeg_stdio_src(&cinfo, file);
+		// Older versions of libjpeg take a non-const pointer, but never write to it.
+		jpeg_mem_src(&cinfo, reinterpret_cast<unsigned char *>(const_cast<char *>(file.Data())), file.Size());
 		jpeg_read_header(&cinfo, true);
 		cinfo.out_color_space = JCS_EXT_BGRA;
 		
@@ -330,4 +340,17 @@ namespace {
 			}
 		}
 	}
+	
+	
+	
+	// Feed libpng the next part of the file.
+	void ReadPNGData(png_struct *png, png_byte *data, png_size_t length)
+	{
+		PNGSource &source = *static_cast<PNGSource *>(png_get_io_ptr(png));
+		if(length > source.file.Size() - source.pos)
+			png_error(png, "Unexpected end of file.");
+		
+		copy(source.file.Data() + source.pos, source.file.Data() + source.pos + length, data);
+		source.pos += length;
+	}
 }
@@ -234,8 +234,10 @@ void ImageSet::Load()
 // the paths are saved in case the sprite needs to be loaded again.
 void ImageSet::Upload(Sprite *sprite)
 {
-	// Load the frames. This will clear the buffers and the mask vector.
-	sprite->AddFrames(buffer[0], false);
-	sprite->AddFrames(buffer[1], true);
+	// Load the frames. This will clear the buffers and the mask vector. Sprites
+	// that may be unloaded again later must not use a shared texture.
+	bool canShare = !IsDeferred(name);
+	sprite->AddFrames(buffer[0], false, canShare);
+	sprite->AddFrames(buffer[1], true, canShare);
 	sprite->AddMasks(masks);
 }
@@ -14,93 +14,252 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "Sprite.h"
 
+#include <map>
+#include <mutex>
+
 using namespace std;
 
+namespace {
+	// The slots that have been assigned to names so far. Interfaces may be
+	// loaded in a different thread than the one that fills in information, so
+	// access to the names must be synchronized.
+	class SlotNames {
+	public:
+		// Get the slot for the given name, assigning a new one if necessary.
+		int Get(const string &name)
+		{
+			lock_guard<mutex> lock(namesMutex);
+			return names.emplace(name, static_cast<int>(names.size())).first->second;
+		}
+		// Get the slot for the given name, or -1 if it has never been used.
+		int Find(const string &name) const
+		{
+			lock_guard<mutex> lock(namesMutex);
+			auto it = names.find(name);
+			return (it == names.end()) ? -1 : it->second;
+		}
+	
+	private:
+		mutable mutex namesMutex;
+		map<string, int> names;
+	};
+	
+	SlotNames spriteNames;
+	SlotNames stringNames;
+	SlotNames barNames;
+	SlotNames conditionNames;
+	
+	// Store a value in the given slot, filling any slots before it that have
+	// not been set yet with the default value.
+	template <class Type>
+	void Store(vector<Type> &values, int slot, const Type &value, const Type &defaultValue)
+	{
+		if(static_cast<size_t>(slot) >= values.size())
+			values.resize(slot + 1, defaultValue);
+		values[slot] = value;
+	}
+	
+	// Get the value in the given slot, or the default if it has not been set.
+	template <class Type>
+	const Type &Load(const vector<Type> &values, int slot, const Type &defaultValue)
+	{
+		return (slot < 0 || static_cast<size_t>(slot) >= values.size()) ? defaultValue : values[slot];
+	}
+	
+	const Sprite *EmptySprite()
+	{
+		static const Sprite empty;
+		return &empty;
+	}
+	
+	const Point UP(0., -1.);
+	const float NO_FRAME = 0.f;
+	const string EMPTY;
+	const double NO_VALUE = 0.;
+	const double ONE_SEGMENT = 1.;
+	const char UNSET = 0;
+}
+
+
+
+Information::Condition::Condition(const string &condition)
+{
+	if(condition.empty())
+		return;
+	
+	isNegated = (condition.front() == '!');
+	slot = conditionNames.Get(isNegated ? condition.substr(1) : condition);
+}
+
+
+
+int Information::SpriteSlot(const string &name)
+{
+	return spriteNames.Get(name);
+}
+
+
+
+int Information::StringSlot(const string &name)
+{
+	return stringNames.Get(name);
+}
+
+
+
+int Information::BarSlot(const string &name)
+{
+	return barNames.Get(name);
+}
+
+
+
+int Information::ConditionSlot(const string &name)
+{
+	return conditionNames.Get(name);
+}
+
 
 
 void Information::SetSprite(const string &name, const Sprite *sprite, const Point &unit, float frame)
 {
-	sprites[name] = sprite;
-	spriteUnits[name] = unit;
-	spriteFrames[name] = frame;
+	SetSprite(spriteNames.Get(name), sprite, unit, frame);
+}
+
+
+
+void Information::SetSprite(int slot, const Sprite *sprite, const Point &unit, float frame)
+{
+	Store(sprites, slot, sprite, EmptySprite());
+	Store(spriteUnits, slot, unit, UP);
+	Store(spriteFrames, slot, frame, NO_FRAME);
 }
 
 
 
 const Sprite *Information::GetSprite(const string &name) const
 {
-	static const Sprite empty;
-	
-	auto it = sprites.find(name);
-	return (it == sprites.end()) ? &empty : it->second;
+	return GetSprite(spriteNames.Find(name));
+}
+
+
+
+const Sprite *Information::GetSprite(int slot) const
+{
+	return Load(sprites, slot, EmptySprite());
 }
 
 
 
 const Point &Information::GetSpriteUnit(const string &name) const
 {
-	static const Point up(0., -1.);
-	
-	auto it = spriteUnits.find(name);
-	return (it == spriteUnits.end()) ? up : it->second;
+	return GetSpriteUnit(spriteNames.Find(name));
+}
+
+
+
+const Point &Information::GetSpriteUnit(int slot) const
+{
+	return Load(spriteUnits, slot, UP);
 }
 
 
 
 float Information::GetSpriteFrame(const string &name) const
 {
-	auto it = spriteFrames.find(name);
-	return (it == spriteFrames.end()) ? 0.f : it->second;
+	return GetSpriteFrame(spriteNames.Find(name));
+}
+
+
+
+float Information::GetSpriteFrame(int slot) const
+{
+	return Load(spriteFrames, slot, NO_FRAME);
 }
 
 
 
 void Information::SetString(const string &name, const string &value)
 {
-	strings[name] = value;
+	SetString(stringNames.Get(name), value);
+}
+
+
+
+void Information::SetString(int slot, const string &value)
+{
+	Store(strings, slot, value, EMPTY);
 }
 
 
 
 const string &Information::GetString(const string &name) const
 {
-	static const string empty;
-	
-	auto it = strings.find(name);
-	return (it == strings.end()) ? empty : it->second;
+	return GetString(stringNames.Find(name));
+}
+
+
+
+const string &Information::GetString(int slot) const
+{
+	return Load(strings, slot, EMPTY);
 }
 
 
 
 void Information::SetBar(const string &name, double value, double segments)
 {
-	bars[name] = value;
-	barSegments[name] = segments;
+	SetBar(barNames.Get(name), value, segments);
+}
+
+
+
+void Information::SetBar(int slot, double value, double segments)
+{
+	Store(bars, slot, value, NO_VALUE);
+	Store(barSegments, slot, segments, ONE_SEGMENT);
 }
 
 
 
 double Information::BarValue(const string &name) const
 {
-	auto it = bars.find(name);
-	
-	return (it == bars.end()) ? 0. : it->second;
+	return BarValue(barNames.Find(name));
+}
+
+
+
+double Information::BarValue(int slot) const
+{
+	return Load(bars, slot, NO_VALUE);
 }
 
 
 
 double Information::BarSegments(const string &name) const
 {
-	auto it = barSegments.find(name);
-	
-	return (it == barSegments.end()) ? 1. : it->second;
+	return BarSegments(barNames.Find(name));
 }
 
 
-	
+
+double Information::BarSegments(int slot) const
+{
+	return Load(barSegments, slot, ONE_SEGMENT);
+}
+
+
+
 void Information::SetCondition(const string &condition)
 {
-	conditions.insert(condition);
+	SetCondition(conditionNames.Get(condition));
+}
+
+
+
+void Information::SetCondition(int slot)
+{
+	Store(conditions, slot, static_cast<char>(1), UNSET);
 }
 
 
@@ -113,11 +272,21 @@ bool Information::HasCondition(const string &condition) const
 	if(condition.front() == '!')
 		return !HasCondition(condition.substr(1));
 	
-	return conditions.count(condition);
+	return Load(conditions, conditionNames.Find(condition), UNSET);
 }
 
 
+
+bool Information::HasCondition(const Condition &condition) const
+{
+	if(condition.slot < 0)
+		return true;
 	
+	return Load(conditions, condition.slot, UNSET) != condition.isNegated;
+}
+
+
+
 void Information::SetOutlineColor(const Color &color)
 {
 	outlineColor = color;
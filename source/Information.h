@@ -16,46 +16,84 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Color.h"
 #include "Point.h"
 
-#include <map>
-#include <set>
 #include <string>
+#include <vector>
 
 class Sprite;
 
 
 
 // Class representing information to be displayed in a user interface, independent
-// of how that information is laid out or shown.
+// of how that information is laid out or shown. Each piece of information is
+// stored in a "slot" that is assigned to its name the first time that name is
+// used, so an interface can look up the slots it needs when it is loaded and
+// then draw without doing any string comparisons.
 class Information {
 public:
+	// A condition whose slot has been looked up in advance. An empty condition
+	// is always true, and one that starts with "!" is true if the rest of it
+	// has not been set.
+	class Condition {
+	public:
+		Condition() = default;
+		explicit Condition(const std::string &condition);
+	
+	private:
+		int slot = -1;
+		bool isNegated = false;
+		
+		friend class Information;
+	};
+
+
+public:
+	// Get the slot for the information with the given name. Sprites, strings,
+	// and bars each have their own separate set of slots.
+	static int SpriteSlot(const std::string &name);
+	static int StringSlot(const std::string &name);
+	static int BarSlot(const std::string &name);
+	static int ConditionSlot(const std::string &name);
+	
 	void SetSprite(const std::string &name, const Sprite *sprite, const Point &unit = Point(0., -1.), float frame = 0.f);
+	void SetSprite(int slot, const Sprite *sprite, const Point &unit = Point(0., -1.), float frame = 0.f);
 	const Sprite *GetSprite(const std::string &name) const;
+	const Sprite *GetSprite(int slot) const;
 	const Point &GetSpriteUnit(const std::string &name) const;
+	const Point &GetSpriteUnit(int slot) const;
 	float GetSpriteFrame(const std::string &name) const;
+	float GetSpriteFrame(int slot) const;
 	
 	void SetString(const std::string &name, const std::string &value);
+	void SetString(int slot, const std::string &value);
 	const std::string &GetString(const std::string &name) const;
+	const std::string &GetString(int slot) const;
 	
 	void SetBar(const std::string &name, double value, double segments = 0.);
+	void SetBar(int slot, double value, double segments = 0.);
 	double BarValue(const std::string &name) const;
+	double BarValue(int slot) const;
 	double BarSegments(const std::string &name) const;
+	double BarSegments(int slot) const;
 	
 	void SetCondition(const std::string &condition);
+	void SetCondition(int slot);
 	bool HasCondition(const std::string &condition) const;
+	bool HasCondition(const Condition &condition) const;
 	
 	void SetOutlineColor(const Color &color);
 	const Color &GetOutlineColor() const;
-	
-	
+
+
 private:
-	std::map<std::string, const Sprite *> sprites;
-	std::map<std::string, Point> spriteUnits;
-	std::map<std::string, float> spriteFrames;
-	std::map<std::string, std::string> strings;
-	std::map<std::string, double> bars;
-	std::map<std::string, double> barSegments;
-	
-	std::set<std::string> conditions;
+	// Each of these is indexed by slot. A slot that is past the end of its
+	// vector has not been set, and its default value is used instead.
+	std::vector<const Sprite *> sprites;
+	std::vector<Point> spriteUnits;
+	std::vector<float> spriteFrames;
+	std::vector<std::string> strings;
+	std::vector<double> bars;
+	std::vector<double> barSegments;
+	std::vector<char> conditions;
 	
 	Color outlineColor;
 };
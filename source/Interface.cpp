@@ -326,8 +326,8 @@ void Interface::Element::Draw(const Information &info, Panel *panel) const
 // An empty string means it is always visible or active.
 void Interface::Element::SetConditions(const string &visible, const string &active)
 {
-	visibleIf = visible;
-	activeIf = active;
+	visibleIf = Information::Condition(visible);
+	activeIf = Information::Condition(active);
 }
 
 
@@ -387,7 +387,7 @@ Interface::ImageElement::ImageElement(const DataNode &node, const Point &globalA
 	if(node.Token(0) == "sprite")
 		sprite[Element::ACTIVE] = SpriteSet::Get(node.Token(1));
 	else
-		name = node.Token(1);
+		slot = Information::SpriteSlot(node.Token(1));
 	
 	// This function will call ParseLine() for any line it does not recognize.
 	Load(node, globalAnchor);
@@ -410,9 +410,9 @@ bool Interface::ImageElement::ParseLine(const DataNode &node)
 {
 	// The "inactive" and "hover" sprite only applies to non-dynamic images.
 	// The "colored" tag only applies to outlines.
-	if(node.Token(0) == "inactive" && node.Size() >= 2 && name.empty())
+	if(node.Token(0) == "inactive" && node.Size() >= 2 && slot < 0)
 		sprite[Element::INACTIVE] = SpriteSet::Get(node.Token(1));
-	else if(node.Token(0) == "hover" && node.Size() >= 2 && name.empty())
+	else if(node.Token(0) == "hover" && node.Size() >= 2 && slot < 0)
 		sprite[Element::HOVER] = SpriteSet::Get(node.Token(1));
 	else if(isOutline && node.Token(0) == "colored")
 		isColored = true;
@@ -452,11 +452,11 @@ void Interface::ImageElement::Draw(const Rectangle &rect, const Information &inf
 	if(!sprite || !sprite->Width() || !sprite->Height())
 		return;
 	
-	float frame = info.GetSpriteFrame(name);
+	float frame = info.GetSpriteFrame(slot);
 	if(isOutline)
 	{
 		Color color = (isColored ? info.GetOutlineColor() : Color(1.f, 1.f));
-		Point unit = info.GetSpriteUnit(name);
+		Point unit = info.GetSpriteUnit(slot);
 		OutlineShader::Draw(sprite, rect.Center(), rect.Dimensions(), color, unit, frame);
 	}
 	else
@@ -467,7 +467,7 @@ void Interface::ImageElement::Draw(const Rectangle &rect, const Information &inf
 
 const Sprite *Interface::ImageElement::GetSprite(const Information &info, int state) const
 {
-	return name.empty() ? sprite[state] : info.GetSprite(name);
+	return (slot < 0) ? sprite[state] : info.GetSprite(slot);
 }
 
 
@@ -489,6 +489,8 @@ Interface::TextElement::TextElement(const DataNode &node, const Point &globalAnc
 	}
 	else
 		str = node.Token(1);
+	if(isDynamic)
+		slot = Information::StringSlot(str);
 	
 	// This function will call ParseLine() for any line it does not recognize.
 	Load(node, globalAnchor);
@@ -585,9 +587,9 @@ void Interface::TextElement::Place(const Rectangle &bounds, Panel *panel) const
 
 
 
-string Interface::TextElement::GetString(const Information &info) const
+const string &Interface::TextElement::GetString(const Information &info) const
 {
-	return isDynamic ? info.GetString(str) : str;
+	return isDynamic ? info.GetString(slot) : str;
 }
 
 
@@ -601,7 +603,7 @@ Interface::BarElement::BarElement(const DataNode &node, const Point &globalAncho
 		return;
 	
 	// Get the name of the element and find out what type it is (bar or ring).
-	name = node.Token(1);
+	slot = Information::BarSlot(node.Token(1));
 	isRing = (node.Token(0) == "ring");
 	
 	// This function will call ParseLine() for any line it does not recognize.
@@ -634,8 +636,8 @@ bool Interface::BarElement::ParseLine(const DataNode &node)
 void Interface::BarElement::Draw(const Rectangle &rect, const Information &info, int state) const
 {
 	// Get the current settings for this bar or ring.
-	double value = info.BarValue(name);
-	double segments = info.BarSegments(name);
+	double value = info.BarValue(slot);
+	double segments = info.BarSegments(slot);
 	if(segments <= 1.)
 		segments = 0.;
 	
@@ -663,6 +665,7 @@ void Interface::BarElement::Draw(const Rectangle &rect, const Information &info,
 		double filled = segments ? (1. - empty * (segments - 1.)) / segments : 1.;
 		
 		// Draw segments until we've drawn the desired length.
+		LineShader::Bind();
 		double v = 0.;
 		while(v < value)
 		{
@@ -671,7 +674,8 @@ void Interface::BarElement::Draw(const Rectangle &rect, const Information &info,
 			Point to = start + min(v, value) * dimensions;
 			v += empty;
 			
-			LineShader::Draw(from, to, width, *color);
+			LineShader::Add(from, to, width, *color);
 		}
+		LineShader::Unbind();
 	}
 }
@@ -14,6 +14,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #define INTERFACE_H_
 
 #include "Color.h"
+#include "Information.h"
 #include "Point.h"
 #include "Rectangle.h"
 #include "text/truncate.hpp"
@@ -23,7 +24,6 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <vector>
 
 class DataNode;
-class Information;
 class Panel;
 class Sprite;
 
@@ -109,8 +109,8 @@ private:
 		AnchoredPoint to;
 		Point alignment;
 		Point padding;
-		std::string visibleIf;
-		std::string activeIf;
+		Information::Condition visibleIf;
+		Information::Condition activeIf;
 	};
 	
 	// This class handles "sprite", "image", and "outline" elements.
@@ -131,8 +131,8 @@ private:
 		const Sprite *GetSprite(const Information &info, int state) const;
 		
 	private:
-		// If a name is given, look up the sprite with that name and draw it.
-		std::string name;
+		// If a name is given, look up the sprite in its slot and draw it.
+		int slot = -1;
 		// Otherwise, draw a sprite. Which sprite is drawn depends on the current
 		// state of this element: inactive, active, or hover.
 		const Sprite *sprite[3] = {nullptr, nullptr, nullptr};
@@ -160,11 +160,13 @@ private:
 		virtual void Place(const Rectangle &bounds, Panel *panel) const override;
 		
 	private:
-		std::string GetString(const Information &info) const;
+		const std::string &GetString(const Information &info) const;
 	
 	private:
 		// The string may either be a name of a dynamic string, or static text.
 		std::string str;
+		// The slot of the dynamic string, if this is one.
+		int slot = -1;
 		// Color for inactive, active, and hover states.
 		const Color *color[3] = {nullptr, nullptr, nullptr};
 		int fontSize = 14;
@@ -186,7 +188,7 @@ private:
 		virtual void Draw(const Rectangle &rect, const Information &info, int state) const override;
 		
 	private:
-		std::string name;
+		int slot = -1;
 		const Color *color = nullptr;
 		float width = 2.f;
 		bool isRing = false;
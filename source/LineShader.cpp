@@ -18,19 +18,41 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Shader.h"
 
 #include <stdexcept>
+#include <vector>
 
 using namespace std;
 
 namespace {
 	Shader shader;
 	GLint scaleI;
-	GLint startI;
-	GLint lengthI;
-	GLint widthI;
-	GLint colorI;
 	
 	GLuint vao;
 	GLuint vbo;
+	
+	// Each line is drawn as two triangles. Each vertex holds the corner of the
+	// line it is at, followed by all the parameters of its line: start point,
+	// length vector, width vector, and color.
+	const int VERTEX_SIZE = 12;
+	const GLfloat CORNERS[] = {
+		0.f, -1.f,
+		1.f, -1.f,
+		0.f,  1.f,
+		1.f, -1.f,
+		0.f,  1.f,
+		1.f,  1.f
+	};
+	// The vertices of all the lines added since the last Bind().
+	vector<GLfloat> vertices;
+	
+	// Point the attribute with the given name at the given number of floats,
+	// starting at the given offset into each vertex.
+	void EnableAttribute(const char *name, int size, int offset)
+	{
+		GLint attrib = shader.Attrib(name);
+		glEnableVertexAttribArray(attrib);
+		glVertexAttribPointer(attrib, size, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),
+			reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+	}
 }
 
 
@@ -40,57 +62,51 @@ void LineShader::Init()
 	static const char *vertexCode =
 		"// vertex line shader\n"
 		"uniform vec2 scale;\n"
-		"uniform vec2 start;\n"
-		"uniform vec2 len;\n"
-		"uniform vec2 width;\n"
 		
 		"in vec2 vert;\n"
+		"in vec2 start;\n"
+		"in vec2 len;\n"
+		"in vec2 width;\n"
+		"in vec4 color;\n"
 		"out vec2 tpos;\n"
-		"out float tscale;\n"
+		"flat out float tscale;\n"
+		"flat out vec4 lineColor;\n"
 		
 		"void main() {\n"
 		"  tpos = vert;\n"
 		"  tscale = length(len);\n"
+		"  lineColor = color;\n"
 		"  gl_Position = vec4((start + vert.x * len + vert.y * width) * scale, 0, 1);\n"
 		"}\n";
 
 	static const char *fragmentCode =
 		"// fragment line shader\n"
-		"uniform vec4 color = vec4(1, 1, 1, 1);\n"
 		
 		"in vec2 tpos;\n"
-		"in float tscale;\n"
+		"flat in float tscale;\n"
+		"flat in vec4 lineColor;\n"
 		"out vec4 finalColor;\n"
 		
 		"void main() {\n"
 		"  float alpha = min(tscale - abs(tpos.x * (2 * tscale) - tscale), 1 - abs(tpos.y));\n"
-		"  finalColor = color * alpha;\n"
+		"  finalColor = lineColor * alpha;\n"
 		"}\n";
 	
 	shader = Shader(vertexCode, fragmentCode);
 	scaleI = shader.Uniform("scale");
-	startI = shader.Uniform("start");
-	lengthI = shader.Uniform("len");
-	widthI = shader.Uniform("width");
-	colorI = shader.Uniform("color");
 	
-	// Generate the vertex data for drawing sprites.
+	// Generate the buffer for uploading the line vertex data.
 	glGenVertexArrays(1, &vao);
 	glBindVertexArray(vao);
 	
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	
-	GLfloat vertexData[] = {
-		0.f, -1.f,
-		1.f, -1.f,
-		0.f,  1.f,
-		1.f,  1.f
-	};
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertexData), vertexData, GL_STATIC_DRAW);
-	
-	glEnableVertexAttribArray(shader.Attrib("vert"));
-	glVertexAttribPointer(shader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	EnableAttribute("vert", 2, 0);
+	EnableAttribute("start", 2, 2);
+	EnableAttribute("len", 2, 4);
+	EnableAttribute("width", 2, 6);
+	EnableAttribute("color", 4, 8);
 	
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -100,9 +116,52 @@ void LineShader::Init()
 
 
 void LineShader::Draw(const Point &from, const Point &to, float width, const Color &color)
+{
+	Bind();
+	
+	Add(from, to, width, color);
+	
+	Unbind();
+}
+
+
+
+// Start a batch of lines. Nothing is drawn until Unbind() is called.
+void LineShader::Bind()
 {
 	if(!shader.Object())
-		throw runtime_error("LineShader: Draw() called before Init().");
+		throw runtime_error("LineShader: Bind() called before Init().");
+	
+	vertices.clear();
+}
+
+
+
+void LineShader::Add(const Point &from, const Point &to, float width, const Color &color)
+{
+	Point v = to - from;
+	Point u = v.Unit() * width;
+	const float *rgba = color.Get();
+	const GLfloat line[VERTEX_SIZE - 2] = {
+		static_cast<float>(from.X()), static_cast<float>(from.Y()),
+		static_cast<float>(v.X()), static_cast<float>(v.Y()),
+		static_cast<float>(u.Y()), static_cast<float>(-u.X()),
+		rgba[0], rgba[1], rgba[2], rgba[3]
+	};
+	for(int i = 0; i < 6; ++i)
+	{
+		vertices.insert(vertices.end(), CORNERS + 2 * i, CORNERS + 2 * i + 2);
+		vertices.insert(vertices.end(), line, line + VERTEX_SIZE - 2);
+	}
+}
+
+
+
+// Draw all the lines added since Bind() with a single draw call.
+void LineShader::Unbind()
+{
+	if(vertices.empty())
+		return;
 	
 	glUseProgram(shader.Object());
 	glBindVertexArray(vao);
@@ -110,20 +169,12 @@ void LineShader::Draw(const Point &from, const Point &to, float width, const Col
 	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
 	glUniform2fv(scaleI, 1, scale);
 	
-	GLfloat start[2] = {static_cast<float>(from.X()), static_cast<float>(from.Y())};
-	glUniform2fv(startI, 1, start);
-	
-	Point v = to - from;
-	Point u = v.Unit() * width;
-	GLfloat length[2] = {static_cast<float>(v.X()), static_cast<float>(v.Y())};
-	glUniform2fv(lengthI, 1, length);
-	
-	GLfloat w[2] = {static_cast<float>(u.Y()), static_cast<float>(-u.X())};
-	glUniform2fv(widthI, 1, w);
-	
-	glUniform4fv(colorI, 1, color.Get());
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glDrawArrays(GL_TRIANGLES, 0, vertices.size() / VERTEX_SIZE);
+	vertices.clear();
 	
 	glBindVertexArray(0);
 	glUseProgram(0);
@@ -19,12 +19,17 @@ class Point;
 
 
 // Class to be used for drawing lines. The sides of a line are anti-aliased, but
-// the start and end of the line are not.
+// the start and end of the line are not. Lines added between Bind() and
+// Unbind() are all drawn at once, when Unbind() is called.
 class LineShader {
 public:
 	static void Init();
 	
 	static void Draw(const Point &from, const Point &to, float width, const Color &color);
+	
+	static void Bind();
+	static void Add(const Point &from, const Point &to, float width, const Color &color);
+	static void Unbind();
 };
 
 
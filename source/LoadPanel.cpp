@@ -32,6 +32,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "PlayerInfo.h"
 #include "Preferences.h"
 #include "Rectangle.h"
+#include "SaveQueue.h"
 #include "ShipyardPanel.h"
 #include "StarField.h"
 #include "StartConditionsPanel.h"
@@ -41,7 +42,12 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "gl_header.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <thread>
 
 using namespace std;
 
@@ -88,6 +94,50 @@ namespace {
 	// Only show tooltips if the mouse has hovered in one place for this amount
 	// of time.
 	const int HOVER_TIME = 60;
+	
+	// Previews of saved games, which are read on a background thread as soon
+	// as the list of files is known, so that the panel does not stall when the
+	// player flips through hundreds of snapshots. Each preview is stored along
+	// with the file's timestamp and size, so a file that has changed is read
+	// again. Once the panel is closed, the scan stops and the cache is emptied.
+	class PreviewCache {
+	public:
+		~PreviewCache();
+		
+		// Start reading the given files, and forget the previews of any files
+		// that are not in the list.
+		void Scan(const vector<string> &paths);
+		// Stop reading files, and forget all the previews.
+		void Stop();
+		// Get the preview of the given file. If the background thread has not
+		// gotten to it yet, or it has changed, it is read right away.
+		SavedGame Get(const string &path);
+		
+		// Thread entry point.
+		void operator()();
+		
+	private:
+		class Entry {
+		public:
+			time_t timestamp;
+			size_t size;
+			SavedGame preview;
+		};
+		
+	private:
+		map<string, Entry> previews;
+		vector<string> toRead;
+		// This changes whenever the cache is emptied, so that a file that was
+		// being read at the time is not added back in to it.
+		int generation = 0;
+		bool done = false;
+		
+		mutex cacheMutex;
+		condition_variable readCondition;
+		thread worker;
+	};
+	
+	PreviewCache previews;
 }
 
 
@@ -103,45 +153,67 @@ LoadPanel::LoadPanel(PlayerInfo &player, UI &gamePanels)
 	if(player.GetPlanet() && !player.IsDead() && !gamePanels.IsTop(&*gamePanels.Root())
 			&& gamePanels.CanSave())
 		player.Save();
+	// The list of saves and any snapshots must reflect what is on the disk.
+	SaveQueue::Finish();
 	UpdateLists();
 }
 
 
 
+LoadPanel::~LoadPanel()
+{
+	previews.Stop();
+}
+
+
+
 void LoadPanel::Draw()
 {
 	glClear(GL_COLOR_BUFFER_BIT);
 	GameData::Background().Draw(Point(), Point());
 	const Font &font = FontSet::Get(14);
 	
+	static const int PILOT = Information::StringSlot("pilot");
+	static const int SHIP_SPRITE = Information::SpriteSlot("ship sprite");
+	static const int SHIP = Information::StringSlot("ship");
+	static const int SYSTEM = Information::StringSlot("system");
+	static const int PLANET = Information::StringSlot("planet");
+	static const int CREDITS = Information::StringSlot("credits");
+	static const int DATE = Information::StringSlot("date");
+	static const int PLAYTIME = Information::StringSlot("playtime");
+	static const int PILOT_SELECTED = Information::ConditionSlot("pilot selected");
+	static const int PILOT_ALIVE = Information::ConditionSlot("pilot alive");
+	static const int SNAPSHOT_SELECTED = Information::ConditionSlot("snapshot selected");
+	static const int PILOT_LOADED = Information::ConditionSlot("pilot loaded");
+	
 	Information info;
 	if(loadedInfo.IsLoaded())
 	{
-		info.SetString("pilot", loadedInfo.Name());
+		info.SetString(PILOT, loadedInfo.Name());
 		if(loadedInfo.ShipSprite())
 		{
-			info.SetSprite("ship sprite", loadedInfo.ShipSprite());
-			info.SetString("ship", loadedInfo.ShipName());
+			info.SetSprite(SHIP_SPRITE, loadedInfo.ShipSprite());
+			info.SetString(SHIP, loadedInfo.ShipName());
 		}
 		if(!loadedInfo.GetSystem().empty())
-			info.SetString("system", loadedInfo.GetSystem());
+			info.SetString(SYSTEM, loadedInfo.GetSystem());
 		if(!loadedInfo.GetPlanet().empty())
-			info.SetString("planet", loadedInfo.GetPlanet());
-		info.SetString("credits", loadedInfo.Credits());
-		info.SetString("date", loadedInfo.GetDate());
-		info.SetString("playtime", loadedInfo.GetPlayTime());
+			info.SetString(PLANET, loadedInfo.GetPlanet());
+		info.SetString(CREDITS, loadedInfo.Credits());
+		info.SetString(DATE, loadedInfo.GetDate());
+		info.SetString(PLAYTIME, loadedInfo.GetPlayTime());
 	}
 	else
-		info.SetString("pilot", "No Pilot Loaded");
+		info.SetString(PILOT, "No Pilot Loaded");
 	
 	if(!selectedPilot.empty())
-		info.SetCondition("pilot selected");
+		info.SetCondition(PILOT_SELECTED);
 	if(!player.IsDead() && player.IsLoaded() && !selectedPilot.empty())
-		info.SetCondition("pilot alive");
+		info.SetCondition(PILOT_ALIVE);
 	if(selectedFile.find('~') != string::npos)
-		info.SetCondition("snapshot selected");
+		info.SetCondition(SNAPSHOT_SELECTED);
 	if(loadedInfo.IsLoaded())
-		info.SetCondition("pilot loaded");
+		info.SetCondition(PILOT_LOADED);
 	
 	GameData::Interfaces().Get("menu background")->Draw(info, this);
 	GameData::Interfaces().Get("load menu")->Draw(info, this);
@@ -299,7 +371,7 @@ bool LoadPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command, boo
 			}
 			selectedFile = it->first;
 		}
-		loadedInfo.Load(Files::Saves() + selectedFile);
+		UpdatePreview();
 	}
 	else if(key == SDLK_LEFT)
 		sideHasFocus = true;
@@ -354,7 +426,7 @@ bool LoadPanel::Click(int x, int y, int clicks)
 		return false;
 	
 	if(!selectedFile.empty())
-		loadedInfo.Load(Files::Saves() + selectedFile);
+		UpdatePreview();
 	
 	return true;
 }
@@ -425,6 +497,22 @@ void LoadPanel::UpdateLists()
 			}
 		);
 	
+	// Read the previews of the selected pilot's saves first, then all others,
+	// newest first.
+	vector<string> toScan;
+	auto addPilot = [&toScan](const vector<pair<string, time_t>> &list)
+	{
+		for(const auto &it : list)
+			toScan.push_back(Files::Saves() + it.first);
+	};
+	auto sit = files.find(selectedPilot);
+	if(sit != files.end())
+		addPilot(sit->second);
+	for(const auto &it : files)
+		if(it.first != selectedPilot)
+			addPilot(it.second);
+	previews.Scan(toScan);
+	
 	if(!files.empty())
 	{
 		if(selectedPilot.empty())
@@ -435,7 +523,7 @@ void LoadPanel::UpdateLists()
 			if(it != files.end())
 			{
 				selectedFile = it->second.front().first;
-				loadedInfo.Load(Files::Saves() + selectedFile);
+				UpdatePreview();
 			}
 		}
 	}
@@ -443,6 +531,13 @@ void LoadPanel::UpdateLists()
 
 
 
+void LoadPanel::UpdatePreview()
+{
+	loadedInfo = previews.Get(Files::Saves() + selectedFile);
+}
+
+
+
 // Snapshot name callback.
 void LoadPanel::SnapshotCallback(const string &name)
 {
@@ -478,7 +573,7 @@ void LoadPanel::WriteSnapshot(const string &sourceFile, const string &snapshotNa
 	{
 		UpdateLists();
 		selectedFile = Files::Name(snapshotName);
-		loadedInfo.Load(Files::Saves() + selectedFile);
+		UpdatePreview();
 	}
 	else
 		GetUI()->Push(new Dialog("Error: unable to create the file \"" + snapshotName + "\"."));
@@ -552,7 +647,111 @@ void LoadPanel::DeleteSave()
 	{
 		selectedFile = it->second.front().first;
 		selectedPilot = pilot;
-		loadedInfo.Load(Files::Saves() + selectedFile);
+		UpdatePreview();
 		sideHasFocus = false;
 	}
 }
+
+
+
+namespace {
+	PreviewCache::~PreviewCache()
+	{
+		{
+			lock_guard<mutex> lock(cacheMutex);
+			done = true;
+		}
+		readCondition.notify_all();
+		if(worker.joinable())
+			worker.join();
+	}
+	
+	
+	
+	void PreviewCache::Scan(const vector<string> &paths)
+	{
+		{
+			lock_guard<mutex> lock(cacheMutex);
+			set<string> wanted(paths.begin(), paths.end());
+			for(auto it = previews.begin(); it != previews.end(); )
+			{
+				if(!wanted.count(it->first))
+					it = previews.erase(it);
+				else
+					++it;
+			}
+			
+			// The files are read from the back of the list.
+			toRead.assign(paths.rbegin(), paths.rend());
+			if(!worker.joinable())
+				worker = thread(ref(*this));
+		}
+		readCondition.notify_one();
+	}
+	
+	
+	
+	void PreviewCache::Stop()
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		toRead.clear();
+		previews.clear();
+		++generation;
+	}
+	
+	
+	
+	SavedGame PreviewCache::Get(const string &path)
+	{
+		time_t timestamp = Files::Timestamp(path);
+		size_t size = Files::Size(path);
+		{
+			lock_guard<mutex> lock(cacheMutex);
+			auto it = previews.find(path);
+			if(it != previews.end() && it->second.timestamp == timestamp && it->second.size == size)
+				return it->second.preview;
+		}
+		
+		SavedGame preview(path);
+		lock_guard<mutex> lock(cacheMutex);
+		previews[path] = Entry{timestamp, size, preview};
+		return preview;
+	}
+	
+	
+	
+	void PreviewCache::operator()()
+	{
+		unique_lock<mutex> lock(cacheMutex);
+		while(true)
+		{
+			if(done)
+				return;
+			if(toRead.empty())
+			{
+				readCondition.wait(lock);
+				continue;
+			}
+			
+			string path = move(toRead.back());
+			toRead.pop_back();
+			int scanGeneration = generation;
+			
+			// Check and read the file without holding the lock, so the panel
+			// can keep looking up the previews that are already done.
+			lock.unlock();
+			time_t timestamp = Files::Timestamp(path);
+			size_t size = Files::Size(path);
+			lock.lock();
+			auto it = previews.find(path);
+			if(it != previews.end() && it->second.timestamp == timestamp && it->second.size == size)
+				continue;
+			
+			lock.unlock();
+			SavedGame preview(path);
+			lock.lock();
+			if(generation == scanGeneration)
+				previews[path] = Entry{timestamp, size, preview};
+		}
+	}
+}
@@ -35,6 +35,7 @@ class UI;
 class LoadPanel : public Panel {
 public:
 	LoadPanel(PlayerInfo &player, UI &gamePanels);
+	~LoadPanel();
 	
 	virtual void Draw() override;
 	
@@ -50,6 +51,8 @@ protected:
 	
 private:
 	void UpdateLists();
+	// Show the preview of the selected file.
+	void UpdatePreview();
 	
 	// Snapshot name callback.
 	void SnapshotCallback(const std::string &name);
@@ -14,7 +14,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "DataNode.h"
 #include "DataWriter.h"
-#include "DistanceMap.h"
+#include "DistanceTable.h"
 #include "GameData.h"
 #include "Government.h"
 #include "Planet.h"
@@ -24,7 +24,6 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "System.h"
 
 #include <algorithm>
-#include <mutex>
 
 using namespace std;
 
@@ -68,26 +67,32 @@ namespace {
 	// Check if the given system is within the given distance of the center.
 	int Distance(const System *center, const System *system, int maximum)
 	{
-		// This function should only ever be called from the main thread, but
-		// just to be sure, use mutex protection on the static locals.
-		static mutex distanceMutex;
-		lock_guard<mutex> lock(distanceMutex);
-		
-		static const System *previousCenter = center;
-		static DistanceMap distance(center, -1, maximum);
-		static int previousMaximum = maximum;
-		
-		if(center != previousCenter || maximum > previousMaximum)
-		{
-			previousCenter = center;
-			previousMaximum = maximum;
-			distance = DistanceMap(center, -1, maximum);
-		}
 		// If the distance is greater than the maximum, this is not a match.
-		int d = distance.Days(system);
+		int d = GameData::Distances().Days(center, system);
 		return (d > maximum) ? -1 : d;
 	}
 	
+	// Sort systems or planets into the same order as they are in GameData, so
+	// that picking one at random gives the same result as scanning the whole
+	// set would have.
+	void SortByName(vector<const System *> &systems)
+	{
+		sort(systems.begin(), systems.end(),
+			[](const System *a, const System *b) -> bool
+			{
+				return a->Name() < b->Name();
+			});
+	}
+	void SortByName(vector<const Planet *> &planets)
+	{
+		sort(planets.begin(), planets.end(),
+			[](const Planet *a, const Planet *b) -> bool
+			{
+				return a->TrueName() < b->TrueName();
+			});
+		planets.erase(unique(planets.begin(), planets.end()), planets.end());
+	}
+	
 	// Check that at least one neighbor of the hub system matches, for each of the neighbor filters.
 	// False if at least one filter fails to match, true if all filters find at least one match.
 	bool MatchesNeighborFilters(const list<LocationFilter> &neighborFilters, const System *hub, const System *origin)
@@ -440,15 +445,15 @@ LocationFilter LocationFilter::SetOrigin(const System *origin) const
 // Pick a random system that matches this filter, based on the given origin.
 const System *LocationFilter::PickSystem(const System *origin) const
 {
-	// Find a planet that satisfies the filter.
+	// Find a system that satisfies the filter.
 	vector<const System *> options;
-	for(const auto &it : GameData::Systems())
+	for(const System *system : Candidates(origin))
 	{
 		// Skip entries with incomplete data.
-		if(!it.second.IsValid())
+		if(!system->IsValid())
 			continue;
-		if(Matches(&it.second, origin))
-			options.push_back(&it.second);
+		if(Matches(system, origin))
+			options.push_back(system);
 	}
 	return options.empty() ? nullptr : options[Random::Int(options.size())];
 }
@@ -458,20 +463,40 @@ const System *LocationFilter::PickSystem(const System *origin) const
 // Pick a random planet that matches this filter, based on the given origin.
 const Planet *LocationFilter::PickPlanet(const System *origin, bool hasClearance, bool requireSpaceport) const
 {
+	// If the filter limits where the planet can be, only the planets in those
+	// systems need to be checked.
+	vector<const Planet *> candidates;
+	if(!planets.empty())
+	{
+		candidates.assign(planets.begin(), planets.end());
+		SortByName(candidates);
+	}
+	else if(!systems.empty() || center || (origin && originMaxDistance >= 0))
+	{
+		// A planet is matched based on the first system it is in.
+		for(const System *system : Candidates(origin))
+			for(const StellarObject &object : system->Objects())
+				if(object.GetPlanet() && object.GetPlanet()->GetSystem() == system)
+					candidates.push_back(object.GetPlanet());
+		SortByName(candidates);
+	}
+	else
+		for(const auto &it : GameData::Planets())
+			candidates.push_back(&it.second);
+	
 	// Find a planet that satisfies the filter.
 	vector<const Planet *> options;
-	for(const auto &it : GameData::Planets())
+	for(const Planet *planet : candidates)
 	{
-		const Planet &planet = it.second;
 		// Skip entries with incomplete data.
-		if(!planet.IsValid())
+		if(!planet->IsValid())
 			continue;
 		// Skip planets that do not offer special jobs or missions, unless they were explicitly listed as options.
-		if(planet.IsWormhole() || (requireSpaceport && !planet.HasSpaceport()) || (!hasClearance && !planet.CanLand()))
-			if(planets.empty() || !planets.count(&planet))
+		if(planet->IsWormhole() || (requireSpaceport && !planet->HasSpaceport()) || (!hasClearance && !planet->CanLand()))
+			if(planets.empty() || !planets.count(planet))
 				continue;
-		if(Matches(&planet, origin))
-			options.push_back(&planet);
+		if(Matches(planet, origin))
+			options.push_back(planet);
 	}
 	return options.empty() ? nullptr : options[Random::Int(options.size())];
 }
@@ -569,6 +594,29 @@ void LocationFilter::LoadChild(const DataNode &child)
 
 
 
+// Get the systems that this filter might match. If the filter names specific
+// systems or has a distance limit, the rest of the galaxy is not included.
+// The systems are in the same order as in GameData::Systems().
+vector<const System *> LocationFilter::Candidates(const System *origin) const
+{
+	vector<const System *> result;
+	if(!systems.empty())
+	{
+		result.assign(systems.begin(), systems.end());
+		SortByName(result);
+	}
+	else if(center)
+		result = GameData::Distances().Systems(center, centerMaxDistance);
+	else if(origin && originMaxDistance >= 0)
+		result = GameData::Distances().Systems(origin, originMaxDistance);
+	else
+		for(const auto &it : GameData::Systems())
+			result.push_back(&it.second);
+	return result;
+}
+
+
+
 bool LocationFilter::Matches(const System *system, const System *origin, bool didPlanet) const
 {
 	if(!system || !system->IsValid())
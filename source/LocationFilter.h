@@ -16,6 +16,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <list>
 #include <set>
 #include <string>
+#include <vector>
 
 class DataNode;
 class DataWriter;
@@ -70,6 +71,9 @@ private:
 	// only if the filter wasn't looking for planet characteristics or if the
 	// didPlanet argument is set (meaning we already checked those).
 	bool Matches(const System *system, const System *origin, bool didPlanet) const;
+	// Get the systems that this filter might match, without checking the
+	// whole galaxy if the filter only allows certain systems.
+	std::vector<const System *> Candidates(const System *origin) const;
 	
 	
 private:
@@ -43,6 +43,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "gl_header.h"
 
 #include <cmath>
+#include <iterator>
 #include <sstream>
 #include <string>
 
@@ -127,9 +128,11 @@ void MainPanel::Step()
 	
 	engine.Step(isActive);
 	
-	// Splice new events onto the eventQueue for (eventual) handling. No
+	// Move new events onto the eventQueue for (eventual) handling. No
 	// other classes use Engine::Events() after Engine::Step() completes.
-	eventQueue.splice(eventQueue.end(), engine.Events());
+	vector<ShipEvent> &newEvents = engine.Events();
+	eventQueue.insert(eventQueue.end(), make_move_iterator(newEvents.begin()), make_move_iterator(newEvents.end()));
+	newEvents.clear();
 	// Handle as many ShipEvents as possible (stopping if no longer active
 	// and updating the isActive flag).
 	StepEvents(isActive);
@@ -148,7 +151,7 @@ void MainPanel::Draw()
 	FrameTimer loadTimer;
 	glClear(GL_COLOR_BUFFER_BIT);
 	
-	engine.Draw();
+	engine.Draw(GetUI()->Interpolation());
 	
 	if(isDragging)
 	{
@@ -455,9 +458,10 @@ bool MainPanel::ShowHailPanel()
 // oldest and then process events until any create a new UI element.
 void MainPanel::StepEvents(bool &isActive)
 {
-	while(isActive && !eventQueue.empty())
+	size_t handled = 0;
+	while(isActive && handled < eventQueue.size())
 	{
-		const ShipEvent &event = eventQueue.front();
+		const ShipEvent &event = eventQueue[handled];
 		const Government *actor = event.ActorGovernment();
 		
 		// Pass this event to the player, to update conditions and make
@@ -536,8 +540,10 @@ void MainPanel::StepEvents(bool &isActive)
 			}
 		}
 		
-		// Remove the fully-handled event.
-		eventQueue.pop_front();
+		// Move past the fully-handled event.
+		++handled;
 		handledFront = false;
 	}
+	// Remove all the fully-handled events at once.
+	eventQueue.erase(eventQueue.begin(), eventQueue.begin() + handled);
 }
@@ -18,7 +18,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Command.h"
 #include "Engine.h"
 
-#include <list>
+#include <vector>
 
 class PlayerInfo;
 class ShipEvent;
@@ -68,7 +68,7 @@ private:
 	Engine engine;
 	
 	// These are the pending ShipEvents that have yet to be processed.
-	std::list<ShipEvent> eventQueue;
+	std::vector<ShipEvent> eventQueue;
 	bool handledFront = false;
 	
 	Command show;
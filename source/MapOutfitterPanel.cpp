@@ -32,6 +32,15 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 using namespace std;
 
+namespace {
+	// What outfits are for sale only changes when the player visits another
+	// system or an event changes what an outfitter sells, and what can be
+	// mined only grows, so the catalog is shared by every outfitter map.
+	int catalogVersion = -1;
+	size_t catalogHarvested = 0;
+	map<string, vector<const Outfit *>> sharedCatalog;
+}
+
 
 
 MapOutfitterPanel::MapOutfitterPanel(PlayerInfo &player)
@@ -233,24 +242,30 @@ void MapOutfitterPanel::DrawItems()
 
 void MapOutfitterPanel::Init()
 {
-	catalog.clear();
-	set<const Outfit *> seen;
-	for(auto &&it : GameData::Planets())
-		if(it.second.IsValid() && player.HasVisited(*it.second.GetSystem()))
-			for(const Outfit *outfit : it.second.Outfitter())
-				if(!seen.count(outfit))
-				{
-					catalog[outfit->Category()].push_back(outfit);
-					seen.insert(outfit);
-				}
-	for(const auto &it : player.Harvested())
-		if(!seen.count(it.second))
-		{
-			catalog[it.second->Category()].push_back(it.second);
-			seen.insert(it.second);
-		}
+	if(catalogVersion != player.MapVersion() || catalogHarvested != player.Harvested().size())
+	{
+		catalogVersion = player.MapVersion();
+		catalogHarvested = player.Harvested().size();
+		sharedCatalog.clear();
+		set<const Outfit *> seen;
+		for(auto &&it : GameData::Planets())
+			if(it.second.IsValid() && player.HasVisited(*it.second.GetSystem()))
+				for(const Outfit *outfit : it.second.Outfitter())
+					if(!seen.count(outfit))
+					{
+						sharedCatalog[outfit->Category()].push_back(outfit);
+						seen.insert(outfit);
+					}
+		for(const auto &it : player.Harvested())
+			if(!seen.count(it.second))
+			{
+				sharedCatalog[it.second->Category()].push_back(it.second);
+				seen.insert(it.second);
+			}
 	
-	for(auto &it : catalog)
-		sort(it.second.begin(), it.second.end(),
-			[](const Outfit *a, const Outfit *b) { return a->Name() < b->Name(); });
+		for(auto &it : sharedCatalog)
+			sort(it.second.begin(), it.second.end(),
+				[](const Outfit *a, const Outfit *b) { return a->Name() < b->Name(); });
+	}
+	catalog = sharedCatalog;
 }
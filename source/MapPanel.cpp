@@ -110,6 +110,8 @@ const float MapPanel::LINK_WIDTH = 1.2f;
 // Draw links only outside the system ring, which has radius MapPanel::OUTER.
 const float MapPanel::LINK_OFFSET = 7.f;
 
+MapPanel::Model MapPanel::model;
+
 
 
 MapPanel::MapPanel(PlayerInfo &player, int commodity, const System *special)
@@ -145,6 +147,7 @@ MapPanel::MapPanel(PlayerInfo &player, int commodity, const System *special)
 		playerJumpDistance = systemRange ? systemRange : playerRange;
 	
 	CenterOnSystem(selectedSystem, true);
+	UpdateLayout();
 }
 
 
@@ -219,16 +222,22 @@ void MapPanel::Draw()
 void MapPanel::DrawButtons(const string &condition)
 {
 	// Remember which buttons we're showing.
-	buttonCondition = condition;
+	if(buttonConditionSlot < 0 || buttonCondition != condition)
+	{
+		buttonCondition = condition;
+		buttonConditionSlot = Information::ConditionSlot(condition);
+	}
+	static const int MAX_ZOOM = Information::ConditionSlot("max zoom");
+	static const int MIN_ZOOM = Information::ConditionSlot("min zoom");
 	
 	// Draw the buttons to switch to other map modes.
 	Information info;
-	info.SetCondition(condition);
+	info.SetCondition(buttonConditionSlot);
 	const Interface *mapInterface = GameData::Interfaces().Get("map");
 	if(player.MapZoom() >= static_cast<int>(mapInterface->GetValue("max zoom")))
-		info.SetCondition("max zoom");
+		info.SetCondition(MAX_ZOOM);
 	if(player.MapZoom() <= static_cast<int>(mapInterface->GetValue("min zoom")))
-		info.SetCondition("min zoom");
+		info.SetCondition(MIN_ZOOM);
 	const Interface *mapButtonUi = GameData::Interfaces().Get("map buttons");
 	mapButtonUi->Draw(info, this);
 }
@@ -405,14 +414,9 @@ bool MapPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command, bool
 bool MapPanel::Click(int x, int y, int clicks)
 {
 	// Figure out if a system was clicked on.
-	Point click = Point(x, y) / Zoom() - center;
-	for(const auto &it : GameData::Systems())
-		if(it.second.IsValid() && click.Distance(it.second.Position()) < 10.
-				&& (player.HasSeen(it.second) || &it.second == specialSystem))
-		{
-			Select(&it.second);
-			break;
-		}
+	const System *system = SystemAt(Point(x, y) / Zoom() - center);
+	if(system)
+		Select(system);
 	
 	return true;
 }
@@ -710,16 +714,102 @@ void MapPanel::CenterOnSystem(const System *system, bool immediate)
 
 
 
-// Cache the map layout, so it doesn't have to be re-calculated every frame.
-// The node cache must be updated when the coloring mode changes.
+// Cache the map coloring, so it doesn't have to be re-calculated every frame.
+// The colors for each mode are shared by all map panels, and are only
+// recalculated if something that mode depends on has changed.
 void MapPanel::UpdateCache()
 {
 	// Remember which commodity the cached systems are colored by.
 	cachedCommodity = commodity;
-	nodes.clear();
+	cachedVersion = model.version;
+	
+	// The special coloring depends on what this panel has selected, so it is
+	// never shared with any other panel.
+	if(commodity == SHOW_SPECIAL)
+	{
+		colors.clear();
+		for(const Node &node : model.nodes)
+			colors.push_back(SystemColor(*node.system));
+		return;
+	}
+	
+	// Whether a system counts as inhabited depends on which planets the
+	// flagship is able to land on.
+	vector<char> access;
+	for(const Planet *planet : model.restricted)
+		access.push_back(planet->IsAccessible(player.Flagship()));
+	
+	Model::Coloring &coloring = model.colorings[commodity];
+	bool isCurrent = (coloring.version == model.version && coloring.access == access);
+	// Prices change every day.
+	if(commodity >= 0)
+		isCurrent &= (coloring.date == player.GetDate());
+	// Reputations, bribes and dominated planets may change at any time.
+	if(commodity == SHOW_REPUTATION)
+		isCurrent &= (coloring.politicsVersion == GameData::GetPolitics().Version());
+	if(!isCurrent)
+	{
+		coloring.version = model.version;
+		coloring.access.swap(access);
+		coloring.date = player.GetDate();
+		coloring.politicsVersion = GameData::GetPolitics().Version();
+		
+		// Color the circles for the systems based on the selected criterion,
+		// which may be government, services, or commodity prices.
+		coloring.colors.clear();
+		for(const Node &node : model.nodes)
+			coloring.colors.push_back(SystemColor(*node.system));
+	}
+	colors = coloring.colors;
+}
+
+
+
+// The layout must be recalculated if the player learns about more systems
+// while the map is open.
+void MapPanel::InvalidateCache()
+{
+	UpdateLayout();
+	cachedCommodity = -10;
+}
+
+
+
+// Find the known system, if any, at the given point in map coordinates.
+const System *MapPanel::SystemAt(const Point &point) const
+{
+	for(const Node &node : model.nodes)
+		if(point.Distance(node.position) < 10.)
+			return node.system;
+	
+	return nullptr;
+}
+
+
+
+// Find out which systems and links should be drawn, and how to label them.
+// This only depends on what the player knows about and where they are, so
+// it is skipped if none of that has changed since the last time.
+void MapPanel::UpdateLayout()
+{
+	set<const System *> seenSystems;
+	set<const System *> namedSystems;
+	player.KnownSystems(seenSystems, namedSystems);
+	if(model.mapVersion == player.MapVersion() && model.playerSystem == &playerSystem
+			&& model.specialSystem == specialSystem && model.seenSystems == seenSystems
+			&& model.namedSystems == namedSystems)
+		return;
+	
+	model.mapVersion = player.MapVersion();
+	model.playerSystem = &playerSystem;
+	model.specialSystem = specialSystem;
+	model.seenSystems.swap(seenSystems);
+	model.namedSystems.swap(namedSystems);
+	++model.version;
+	model.colorings.clear();
+	model.nodes.clear();
+	model.restricted.clear();
 	
-	// Draw the circles for the systems, colored based on the selected criterion,
-	// which may be government, services, or commodity prices.
 	const Color &closeNameColor = *GameData::Colors().Get("map name");
 	const Color &farNameColor = closeNameColor.Transparent(.5);
 	for(const auto &it : GameData::Systems())
@@ -729,111 +819,19 @@ void MapPanel::UpdateCache()
 		if(!system.IsValid())
 			continue;
 		// Ignore systems the player has never seen, unless they have a pending mission that lets them see it.
-		if(!player.HasSeen(system) && &system != specialSystem)
+		if(!model.seenSystems.count(&system) && &system != specialSystem)
 			continue;
 		
-		Color color = UninhabitedColor();
-		if(!player.HasVisited(system))
-			color = UnexploredColor();
-		else if(system.IsInhabited(player.Flagship()) || commodity == SHOW_SPECIAL || commodity == SHOW_VISITED)
-		{
-			if(commodity >= SHOW_SPECIAL)
-			{
-				double value = 0.;
-				bool colorSystem = true;
-				if(commodity >= 0)
-				{
-					const Trade::Commodity &com = GameData::Commodities()[commodity];
-					double price = system.Trade(com.name);
-					if(!price)
-						value = numeric_limits<double>::quiet_NaN();
-					else
-						value = (2. * (price - com.low)) / (com.high - com.low) - 1.;
-				}
-				else if(commodity == SHOW_SHIPYARD)
-				{
-					double size = 0;
-					for(const StellarObject &object : system.Objects())
-						if(object.HasSprite() && object.HasValidPlanet())
-							size += object.GetPlanet()->Shipyard().size();
-					value = size ? min(10., size) / 10. : -1.;
-				}
-				else if(commodity == SHOW_OUTFITTER)
-				{
-					double size = 0;
-					for(const StellarObject &object : system.Objects())
-						if(object.HasSprite() && object.HasValidPlanet())
-							size += object.GetPlanet()->Outfitter().size();
-					value = size ? min(60., size) / 60. : -1.;
-				}
-				else if(commodity == SHOW_VISITED)
-				{
-					bool all = true;
-					bool some = false;
-					colorSystem = false;
-					for(const StellarObject &object : system.Objects())
-						if(object.HasSprite() && object.HasValidPlanet() && !object.GetPlanet()->IsWormhole()
-							&& object.GetPlanet()->IsAccessible(player.Flagship()))
-						{
-							bool visited = player.HasVisited(*object.GetPlanet());
-							all &= visited;
-							some |= visited;
-							colorSystem = true;
-						}
-					value = -1 + some + all;
-				}
-				else
-					value = SystemValue(&system);
-				
-				if(colorSystem)
-					color = MapColor(value);
-			}
-			else if(commodity == SHOW_GOVERNMENT)
-			{
-				const Government *gov = system.GetGovernment();
-				color = GovernmentColor(gov);
-			}
-			else
-			{
-				double reputation = system.GetGovernment()->Reputation();
-				
-				// A system should show up as dominated if it contains at least
-				// one inhabited planet and all inhabited planets have been
-				// dominated. It should show up as restricted if you cannot land
-				// on any of the planets that have spaceports.
-				bool hasDominated = true;
-				bool isInhabited = false;
-				bool canLand = false;
-				bool hasSpaceport = false;
-				for(const StellarObject &object : system.Objects())
-					if(object.HasSprite() && object.HasValidPlanet())
-					{
-						const Planet *planet = object.GetPlanet();
-						hasSpaceport |= !planet->IsWormhole() && planet->HasSpaceport();
-						if(planet->IsWormhole() || !planet->IsAccessible(player.Flagship()))
-							continue;
-						canLand |= planet->CanLand() && planet->HasSpaceport();
-						isInhabited |= planet->IsInhabited();
-						hasDominated &= (!planet->IsInhabited()
-							|| GameData::GetPolitics().HasDominated(planet));
-					}
-				hasDominated &= (isInhabited && canLand);
-				// Some systems may count as "inhabited" but not contain any
-				// planets with spaceports. Color those as if they're
-				// uninhabited to make it clear that no fuel is available there.
-				if(hasSpaceport || hasDominated)
-					color = ReputationColor(reputation, canLand, hasDominated);
-			}
-		}
-		
-		nodes.emplace_back(system.Position(), color,
-			player.KnowsName(system) ? system.Name() : "",
+		model.nodes.emplace_back(&system, model.namedSystems.count(&system) ? system.Name() : "",
 			(&system == &playerSystem) ? closeNameColor : farNameColor,
 			player.HasVisited(system) ? system.GetGovernment() : nullptr);
+		for(const StellarObject &object : system.Objects())
+			if(object.HasValidPlanet() && !object.GetPlanet()->IsUnrestricted())
+				model.restricted.push_back(object.GetPlanet());
 	}
 	
 	// Now, update the cache of the links.
-	links.clear();
+	model.links.clear();
 	
 	// The link color depends on whether it's connected to the current system or not.
 	const Color &closeColor = *GameData::Colors().Get("map link");
@@ -841,11 +839,11 @@ void MapPanel::UpdateCache()
 	for(const auto &it : GameData::Systems())
 	{
 		const System *system = &it.second;
-		if(!system->IsValid() || !player.HasSeen(*system))
+		if(!system->IsValid() || !model.seenSystems.count(system))
 			continue;
 		
 		for(const System *link : system->Links())
-			if(link < system || !player.HasSeen(*link))
+			if(link < system || !model.seenSystems.count(link))
 			{
 				// Only draw links between two systems if one of the two is
 				// visited. Also, avoid drawing twice by only drawing in the
@@ -854,13 +852,115 @@ void MapPanel::UpdateCache()
 					continue;
 				
 				bool isClose = (system == &playerSystem || link == &playerSystem);
-				links.emplace_back(system->Position(), link->Position(), isClose ? closeColor : farColor);
+				model.links.emplace_back(system->Position(), link->Position(), isClose ? closeColor : farColor);
 			}
 	}
 }
 
 
 
+// Get the color of the given system under the current coloring mode.
+Color MapPanel::SystemColor(const System &system) const
+{
+	Color color = UninhabitedColor();
+	if(!player.HasVisited(system))
+		color = UnexploredColor();
+	else if(system.IsInhabited(player.Flagship()) || commodity == SHOW_SPECIAL || commodity == SHOW_VISITED)
+	{
+		if(commodity >= SHOW_SPECIAL)
+		{
+			double value = 0.;
+			bool colorSystem = true;
+			if(commodity >= 0)
+			{
+				const Trade::Commodity &com = GameData::Commodities()[commodity];
+				double price = system.Trade(com.name);
+				if(!price)
+					value = numeric_limits<double>::quiet_NaN();
+				else
+					value = (2. * (price - com.low)) / (com.high - com.low) - 1.;
+			}
+			else if(commodity == SHOW_SHIPYARD)
+			{
+				double size = 0;
+				for(const StellarObject &object : system.Objects())
+					if(object.HasSprite() && object.HasValidPlanet())
+						size += object.GetPlanet()->Shipyard().size();
+				value = size ? min(10., size) / 10. : -1.;
+			}
+			else if(commodity == SHOW_OUTFITTER)
+			{
+				double size = 0;
+				for(const StellarObject &object : system.Objects())
+					if(object.HasSprite() && object.HasValidPlanet())
+						size += object.GetPlanet()->Outfitter().size();
+				value = size ? min(60., size) / 60. : -1.;
+			}
+			else if(commodity == SHOW_VISITED)
+			{
+				bool all = true;
+				bool some = false;
+				colorSystem = false;
+				for(const StellarObject &object : system.Objects())
+					if(object.HasSprite() && object.HasValidPlanet() && !object.GetPlanet()->IsWormhole()
+						&& object.GetPlanet()->IsAccessible(player.Flagship()))
+					{
+						bool visited = player.HasVisited(*object.GetPlanet());
+						all &= visited;
+						some |= visited;
+						colorSystem = true;
+					}
+				value = -1 + some + all;
+			}
+			else
+				value = SystemValue(&system);
+			
+			if(colorSystem)
+				color = MapColor(value);
+		}
+		else if(commodity == SHOW_GOVERNMENT)
+		{
+			const Government *gov = system.GetGovernment();
+			color = GovernmentColor(gov);
+		}
+		else
+		{
+			double reputation = system.GetGovernment()->Reputation();
+			
+			// A system should show up as dominated if it contains at least
+			// one inhabited planet and all inhabited planets have been
+			// dominated. It should show up as restricted if you cannot land
+			// on any of the planets that have spaceports.
+			bool hasDominated = true;
+			bool isInhabited = false;
+			bool canLand = false;
+			bool hasSpaceport = false;
+			for(const StellarObject &object : system.Objects())
+				if(object.HasSprite() && object.HasValidPlanet())
+				{
+					const Planet *planet = object.GetPlanet();
+					hasSpaceport |= !planet->IsWormhole() && planet->HasSpaceport();
+					if(planet->IsWormhole() || !planet->IsAccessible(player.Flagship()))
+						continue;
+					canLand |= planet->CanLand() && planet->HasSpaceport();
+					isInhabited |= planet->IsInhabited();
+					hasDominated &= (!planet->IsInhabited()
+						|| GameData::GetPolitics().HasDominated(planet));
+				}
+			hasDominated &= (isInhabited && canLand);
+			// Some systems may count as "inhabited" but not contain any
+			// planets with spaceports. Color those as if they're
+			// uninhabited to make it clear that no fuel is available there.
+			if(hasSpaceport || hasDominated)
+				color = ReputationColor(reputation, canLand, hasDominated);
+		}
+	}
+	
+	return color;
+}
+
+
+
 void MapPanel::DrawTravelPlan()
 {
 	const Set<Color> &colors = GameData::Colors();
@@ -1049,23 +1149,28 @@ void MapPanel::DrawWormholes()
 void MapPanel::DrawLinks()
 {
 	double zoom = Zoom();
-	for(const Link &link : links)
+	LineShader::Bind();
+	for(const Link &link : model.links)
 	{
+		if(!IsOnScreen(link.start, link.end, 0.))
+			continue;
+		
 		Point from = zoom * (link.start + center);
 		Point to = zoom * (link.end + center);
 		Point unit = (from - to).Unit() * LINK_OFFSET;
 		from -= unit;
 		to += unit;
 		
-		LineShader::Draw(from, to, LINK_WIDTH, link.color);
+		LineShader::Add(from, to, LINK_WIDTH, link.color);
 	}
+	LineShader::Unbind();
 }
 
 
 
 void MapPanel::DrawSystems()
 {
-	if(commodity != cachedCommodity)
+	if(commodity != cachedCommodity || cachedVersion != model.version)
 		UpdateCache();
 	
 	// If coloring by government, we need to keep track of which ones are the
@@ -1076,10 +1181,13 @@ void MapPanel::DrawSystems()
 	
 	// Draw the circles for the systems.
 	double zoom = Zoom();
-	for(const Node &node : nodes)
+	RingShader::Bind();
+	for(size_t i = 0; i < model.nodes.size(); ++i)
 	{
+		const Node &node = model.nodes[i];
 		Point pos = zoom * (node.position + center);
-		RingShader::Draw(pos, OUTER, INNER, node.color);
+		if(IsOnScreen(node.position, node.position, OUTER))
+			RingShader::Add(pos, OUTER, INNER, colors[i]);
 		
 		if(commodity == SHOW_GOVERNMENT && node.government && node.government->GetName() != "Uninhabited")
 		{
@@ -1094,6 +1202,7 @@ void MapPanel::DrawSystems()
 				it->second = min(it->second, distance);
 		}
 	}
+	RingShader::Unbind();
 }
 
 
@@ -1109,8 +1218,18 @@ void MapPanel::DrawNames()
 	bool useBigFont = (zoom > 2.);
 	const Font &font = FontSet::Get(useBigFont ? 18 : 14);
 	Point offset(useBigFont ? 8. : 6., -.5 * font.Height());
-	for(const Node &node : nodes)
-		font.Draw(node.name, zoom * (node.position + center) + offset, node.nameColor);
+	for(const Node &node : model.nodes)
+	{
+		// Skip names that are entirely off screen. Only the names near the
+		// left edge need to be measured to find that out.
+		Point pos = zoom * (node.position + center) + offset;
+		if(pos.X() > Screen::Right() || pos.Y() > Screen::Bottom() || pos.Y() + font.Height() < Screen::Top())
+			continue;
+		if(pos.X() < Screen::Left() && pos.X() + font.Width(node.name) < Screen::Left())
+			continue;
+		
+		font.Draw(node.name, pos, node.nameColor);
+	}
 }
 
 
@@ -1232,3 +1351,23 @@ void MapPanel::DrawPointer(Point position, Angle &angle, const Color &color, boo
 		PointerShader::Draw(position, angle.Unit(), 14.f + bigger, 19.f + 2 * bigger, -4.f, black);
 	PointerShader::Draw(position, angle.Unit(), 8.f + bigger, 15.f + 2 * bigger, -6.f, color);
 }
+
+
+
+// Check whether any part of the rectangle with the given corners (in map
+// coordinates), expanded by the given margin (in screen pixels), is on screen.
+bool MapPanel::IsOnScreen(const Point &from, const Point &to, double margin) const
+{
+	double zoom = Zoom();
+	Point a = zoom * (from + center);
+	Point b = zoom * (to + center);
+	return (max(a.X(), b.X()) + margin >= Screen::Left() && min(a.X(), b.X()) - margin <= Screen::Right()
+		&& max(a.Y(), b.Y()) + margin >= Screen::Top() && min(a.Y(), b.Y()) - margin <= Screen::Bottom());
+}
+
+
+
+MapPanel::Node::Node(const System *system, const string &name, const Color &nameColor, const Government *government)
+	: system(system), position(system->Position()), name(name), nameColor(nameColor), government(government)
+{
+}
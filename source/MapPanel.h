@@ -16,11 +16,13 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Panel.h"
 
 #include "Color.h"
+#include "Date.h"
 #include "DistanceMap.h"
 #include "Point.h"
 #include "text/WrappedText.h"
 
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -120,6 +122,7 @@ protected:
 	int commodity;
 	int step = 0;
 	std::string buttonCondition;
+	int buttonConditionSlot = -1;
 	
 	// Distance from the screen center to the nearest owned system,
 	// for use in determining which governments are in the legend.
@@ -130,9 +133,14 @@ protected:
 	// to account for panels on the screen).
 	void CenterOnSystem(const System *system, bool immediate = false);
 	
-	// Cache the map layout, so it doesn't have to be re-calculated every frame.
+	// Cache the map coloring, so it doesn't have to be re-calculated every frame.
 	// The cache must be updated when the coloring mode changes.
 	void UpdateCache();
+	// Check whether the player has learned about more systems (e.g. by
+	// accepting a mission) while the map is open.
+	void InvalidateCache();
+	// Find the known system, if any, at the given point in map coordinates.
+	const System *SystemAt(const Point &point) const;
 	
 	// For tooltips:
 	int hoverCount = 0;
@@ -155,23 +163,32 @@ private:
 	void DrawPointer(const System *system, Angle &angle, const Color &color, bool bigger = false);
 	static void DrawPointer(Point position, Angle &angle, const Color &color, bool drawBack = true, bool bigger = false);
 	
+	// Find out which systems and links the player knows about, unless nothing
+	// that they depend on has changed.
+	void UpdateLayout();
+	Color SystemColor(const System &system) const;
+	// Check whether any part of the given area of the map is on screen.
+	bool IsOnScreen(const Point &from, const Point &to, double margin) const;
+	
 	
 private:
-	// This is the coloring mode currently used in the cache.
+	// This is the coloring mode currently used in the cache, and the version
+	// of the shared systems and links that it colors.
 	int cachedCommodity = -10;
+	int cachedVersion = -1;
+	// The color of each of the shared nodes, in that mode.
+	std::vector<Color> colors;
 	
 	class Node {
 	public:
-		Node(const Point &position, const Color &color, const std::string &name, const Color &nameColor, const Government *government)
-			: position(position), color(color), name(name), nameColor(nameColor), government(government) {}
+		Node(const System *system, const std::string &name, const Color &nameColor, const Government *government);
 		
+		const System *system;
 		Point position;
-		Color color;
 		std::string name;
 		Color nameColor;
 		const Government *government;
 	};
-	std::vector<Node> nodes;
 	
 	class Link {
 	public:
@@ -182,7 +199,44 @@ private:
 		Point end;
 		Color color;
 	};
-	std::vector<Link> links;
+	
+	// The systems and links that the player knows about, and their colors
+	// in each mode, are shared by every map panel. Each part remembers what it
+	// was calculated from, so that it is only recalculated after one of those
+	// things has changed rather than each time a map panel is opened.
+	class Model {
+	public:
+		class Coloring {
+		public:
+			// The model version these colors belong to, and which of the
+			// restricted planets the flagship could land on. The date and
+			// the politics version are only checked by the modes that use
+			// commodity prices or reputations.
+			int version = -1;
+			std::vector<char> access;
+			Date date;
+			int politicsVersion = -1;
+			std::vector<Color> colors;
+		};
+	
+	public:
+		// What the nodes and links were found from.
+		int mapVersion = 0;
+		const System *playerSystem = nullptr;
+		const System *specialSystem = nullptr;
+		std::set<const System *> seenSystems;
+		std::set<const System *> namedSystems;
+		
+		// This changes every time the nodes and links are found again.
+		int version = 0;
+		std::vector<Node> nodes;
+		std::vector<Link> links;
+		// The planets in those systems that not every ship can land on.
+		std::vector<const Planet *> restricted;
+		
+		std::map<int, Coloring> colorings;
+	};
+	static Model model;
 };
 
 
@@ -31,6 +31,14 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 using namespace std;
 
+namespace {
+	// What ships are for sale only changes when the player visits another
+	// system or an event changes what a shipyard sells, so the catalog is
+	// shared by every shipyard map.
+	int catalogVersion = -1;
+	map<string, vector<const Ship *>> sharedCatalog;
+}
+
 
 
 MapShipyardPanel::MapShipyardPanel(PlayerInfo &player)
@@ -210,18 +218,23 @@ void MapShipyardPanel::DrawItems()
 
 void MapShipyardPanel::Init()
 {
-	catalog.clear();
-	set<const Ship *> seen;
-	for(const auto &it : GameData::Planets())
-		if(it.second.IsValid() && player.HasVisited(*it.second.GetSystem()))
-			for(const Ship *ship : it.second.Shipyard())
-				if(!seen.count(ship))
-				{
-					catalog[ship->Attributes().Category()].push_back(ship);
-					seen.insert(ship);
-				}
+	if(catalogVersion != player.MapVersion())
+	{
+		catalogVersion = player.MapVersion();
+		sharedCatalog.clear();
+		set<const Ship *> seen;
+		for(const auto &it : GameData::Planets())
+			if(it.second.IsValid() && player.HasVisited(*it.second.GetSystem()))
+				for(const Ship *ship : it.second.Shipyard())
+					if(!seen.count(ship))
+					{
+						sharedCatalog[ship->Attributes().Category()].push_back(ship);
+						seen.insert(ship);
+					}
 	
-	for(auto &it : catalog)
-		sort(it.second.begin(), it.second.end(),
-			[](const Ship *a, const Ship *b) { return a->ModelName() < b->ModelName(); });
+		for(auto &it : sharedCatalog)
+			sort(it.second.begin(), it.second.end(),
+				[](const Ship *a, const Ship *b) { return a->ModelName() < b->ModelName(); });
+	}
+	catalog = sharedCatalog;
 }
@@ -0,0 +1,81 @@
+/* MappedFile.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "MappedFile.h"
+
+#include "Files.h"
+
+#if !defined _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+
+MappedFile::MappedFile(const string &path)
+{
+#if !defined _WIN32
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return;
+	
+	struct stat buf;
+	bool hasSize = !fstat(fd, &buf);
+	if(hasSize && buf.st_size > 0)
+	{
+		void *address = mmap(nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(address != MAP_FAILED)
+		{
+			data = static_cast<const char *>(address);
+			size = buf.st_size;
+			isMapped = true;
+		}
+	}
+	// The mapping stays valid after the file is closed.
+	close(fd);
+	// Empty files cannot be mapped, but there is nothing to read from them.
+	if(isMapped || (hasSize && !buf.st_size))
+		return;
+#endif
+	
+	buffer = Files::Read(path);
+	data = buffer.data();
+	size = buffer.size();
+}
+
+
+
+MappedFile::~MappedFile()
+{
+#if !defined _WIN32
+	if(isMapped)
+		munmap(const_cast<char *>(data), size);
+#endif
+}
+
+
+
+const char *MappedFile::Data() const
+{
+	return data;
+}
+
+
+
+size_t MappedFile::Size() const
+{
+	return size;
+}
@@ -0,0 +1,49 @@
+/* MappedFile.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+
+
+// RAII wrapper for read-only access to the whole contents of a file. Where the
+// operating system supports it, the file is memory-mapped, so its contents are
+// shared with the page cache (and with any other process reading the same file)
+// instead of being copied into a buffer. Otherwise, the file is read normally.
+// The data is not null-terminated.
+class MappedFile {
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::string &path);
+	MappedFile(const MappedFile &) = delete;
+	~MappedFile();
+	
+	MappedFile &operator=(const MappedFile &) = delete;
+	
+	const char *Data() const;
+	std::size_t Size() const;
+	
+	
+private:
+	const char *data = nullptr;
+	std::size_t size = 0;
+	bool isMapped = false;
+	// If the file could not be mapped, its contents are stored here instead.
+	std::string buffer;
+};
+
+
+
+#endif
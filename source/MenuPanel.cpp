@@ -88,35 +88,46 @@ void MenuPanel::Draw()
 	GameData::Background().Draw(Point(), Point());
 	const Font &font = FontSet::Get(14);
 	
+	static const int PILOT_LOADED = Information::ConditionSlot("pilot loaded");
+	static const int PILOT = Information::StringSlot("pilot");
+	static const int SHIP_SPRITE = Information::SpriteSlot("ship sprite");
+	static const int SHIP = Information::StringSlot("ship");
+	static const int SYSTEM = Information::StringSlot("system");
+	static const int PLANET = Information::StringSlot("planet");
+	static const int CREDITS = Information::StringSlot("credits");
+	static const int DATE = Information::StringSlot("date");
+	static const int PLAYTIME = Information::StringSlot("playtime");
+	static const int NO_PILOT_LOADED = Information::ConditionSlot("no pilot loaded");
+	
 	Information info;
 	if(player.IsLoaded() && !player.IsDead())
 	{
-		info.SetCondition("pilot loaded");
-		info.SetString("pilot", player.FirstName() + " " + player.LastName());
+		info.SetCondition(PILOT_LOADED);
+		info.SetString(PILOT, player.FirstName() + " " + player.LastName());
 		if(player.Flagship())
 		{
 			const Ship &flagship = *player.Flagship();
-			info.SetSprite("ship sprite", flagship.GetSprite());
-			info.SetString("ship", flagship.Name());
+			info.SetSprite(SHIP_SPRITE, flagship.GetSprite());
+			info.SetString(SHIP, flagship.Name());
 		}
 		if(player.GetSystem())
-			info.SetString("system", player.GetSystem()->Name());
+			info.SetString(SYSTEM, player.GetSystem()->Name());
 		if(player.GetPlanet())
-			info.SetString("planet", player.GetPlanet()->Name());
-		info.SetString("credits", Format::Credits(player.Accounts().Credits()));
-		info.SetString("date", player.GetDate().ToString());
-		info.SetString("playtime", Format::PlayTime(player.GetPlayTime()));
+			info.SetString(PLANET, player.GetPlanet()->Name());
+		info.SetString(CREDITS, Format::Credits(player.Accounts().Credits()));
+		info.SetString(DATE, player.GetDate().ToString());
+		info.SetString(PLAYTIME, Format::PlayTime(player.GetPlayTime()));
 	}
 	else if(player.IsLoaded())
 	{
-		info.SetCondition("no pilot loaded");
-		info.SetString("pilot", player.FirstName() + " " + player.LastName());
-		info.SetString("ship", "You have died.");
+		info.SetCondition(NO_PILOT_LOADED);
+		info.SetString(PILOT, player.FirstName() + " " + player.LastName());
+		info.SetString(SHIP, "You have died.");
 	}
 	else
 	{
-		info.SetCondition("no pilot loaded");
-		info.SetString("pilot", "No Pilot Loaded");
+		info.SetCondition(NO_PILOT_LOADED);
+		info.SetString(PILOT, "No Pilot Loaded");
 	}
 	
 	GameData::Interfaces().Get("menu background")->Draw(info, this);
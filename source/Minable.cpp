@@ -150,7 +150,7 @@ bool Minable::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			// a distribution with occasional very good payoffs.
 			for(int amount = Random::Binomial(it.second, .25); amount > 0; amount -= Flotsam::TONS_PER_BOX)
 			{
-				flotsam.emplace_back(new Flotsam(it.first, min(amount, Flotsam::TONS_PER_BOX)));
+				flotsam.push_back(Flotsam::Create(it.first, min(amount, Flotsam::TONS_PER_BOX)));
 				flotsam.back()->Place(*this);
 			}
 		}
@@ -290,7 +290,7 @@ void Mission::Load(const DataNode &node)
 			child.PrintTrace("Skipping unrecognized attribute:");
 	}
 	
-	if(displayName.empty())
+	if(displayName.IsEmpty())
 		displayName = name;
 	if((isMinor || hasPriority) && location == LANDING)
 		node.PrintTrace("Warning: \"minor\" or \"priority\" tags have no effect on \"landing\" missions:");
@@ -305,11 +305,11 @@ void Mission::Save(DataWriter &out, const string &tag) const
 	out.Write(tag, name);
 	out.BeginChild();
 	{
-		out.Write("name", displayName);
-		if(!description.empty())
-			out.Write("description", description);
-		if(!blocked.empty())
-			out.Write("blocked", blocked);
+		out.Write("name", displayName.Text());
+		if(!description.IsEmpty())
+			out.Write("description", description.Text());
+		if(!blocked.IsEmpty())
+			out.Write("blocked", blocked.Text());
 		if(deadline)
 			out.Write("deadline", deadline.Day(), deadline.Month(), deadline.Year());
 		if(cargoSize)
@@ -336,9 +336,9 @@ void Mission::Save(DataWriter &out, const string &tag) const
 			out.Write("boarding");
 		if(location == JOB)
 			out.Write("job");
-		if(!clearance.empty())
+		if(!clearance.IsEmpty())
 		{
-			out.Write("clearance", clearance);
+			out.Write("clearance", clearance.Text());
 			clearanceFilter.Save(out);
 		}
 		if(!hasFullClearance)
@@ -410,14 +410,14 @@ void Mission::Save(DataWriter &out, const string &tag) const
 // Basic mission information.
 const string &Mission::Name() const
 {
-	return displayName;
+	return displayName.Text();
 }
 
 
 
 const string &Mission::Description() const
 {
-	return description;
+	return description.Text();
 }
 
 
@@ -610,7 +610,7 @@ bool Mission::CheckDeadline(const Date &today)
 // Check if you have special clearance to land on your destination.
 bool Mission::HasClearance(const Planet *planet) const
 {
-	if(clearance.empty())
+	if(clearance.IsEmpty())
 		return false;
 	if(planet == destination || stopovers.count(planet) || visitedStopovers.count(planet))
 		return true;
@@ -623,7 +623,7 @@ bool Mission::HasClearance(const Planet *planet) const
 // this is "auto", you don't have to hail them to get landing permission.
 const string &Mission::ClearanceMessage() const
 {
-	return clearance;
+	return clearance.Text();
 }
 
 
@@ -799,7 +799,7 @@ void Mission::Fail()
 // so that you do not display the same message multiple times.
 string Mission::BlockedMessage(const PlayerInfo &player)
 {
-	if(blocked.empty())
+	if(blocked.IsEmpty())
 		return "";
 	
 	int extraCrew = 0;
@@ -839,8 +839,8 @@ string Mission::BlockedMessage(const PlayerInfo &player)
 		out << (cargoNeeded == 1 ? "another ton" : to_string(cargoNeeded) + " more tons") << " of cargo space";
 	subs["<capacity>"] = out.str();
 	
-	string message = Format::Replace(blocked, subs);
-	blocked.clear();
+	string message = blocked.Replace(subs);
+	blocked = TextTemplate();
 	return message;
 }
 
@@ -1023,7 +1023,7 @@ void Mission::Do(const ShipEvent &event, PlayerInfo &player, UI *ui)
 		{
 			hasFailed = true;
 			if(isVisible)
-				Messages::Add(message + "Mission failed: \"" + displayName + "\".");
+				Messages::Add(message + "Mission failed: \"" + displayName.Text() + "\".");
 		}
 	}
 	
@@ -1113,7 +1113,7 @@ Mission Mission::Instantiate(const PlayerInfo &player, const shared_ptr<Ship> &b
 	for(const LocationFilter &filter : stopoverFilters)
 	{
 		// Unlike destinations, we can allow stopovers on planets that don't have a spaceport.
-		const Planet *planet = filter.PickPlanet(source, !clearance.empty(), false);
+		const Planet *planet = filter.PickPlanet(source, !clearance.IsEmpty(), false);
 		if(!planet)
 			return result;
 		result.stopovers.insert(planet);
@@ -1126,7 +1126,7 @@ Mission Mission::Instantiate(const PlayerInfo &player, const shared_ptr<Ship> &b
 	result.destination = destination;
 	if(!result.destination && !destinationFilter.IsEmpty())
 	{
-		result.destination = destinationFilter.PickPlanet(source, !clearance.empty());
+		result.destination = destinationFilter.PickPlanet(source, !clearance.IsEmpty());
 		if(!result.destination)
 			return result;
 	}
@@ -1342,10 +1342,10 @@ Mission Mission::Instantiate(const PlayerInfo &player, const shared_ptr<Ship> &b
 		result.genericOnEnter.emplace_back(action.Instantiate(subs, source, jumps, payload));
 	
 	// Perform substitution in the name and description.
-	result.displayName = Format::Replace(displayName, subs);
-	result.description = Format::Replace(description, subs);
-	result.clearance = Format::Replace(clearance, subs);
-	result.blocked = Format::Replace(blocked, subs);
+	result.displayName = displayName.Replace(subs);
+	result.description = description.Replace(subs);
+	result.clearance = clearance.Replace(subs);
+	result.blocked = blocked.Replace(subs);
 	result.clearanceFilter = clearanceFilter;
 	result.hasFullClearance = hasFullClearance;
 	
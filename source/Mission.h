@@ -18,6 +18,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "LocationFilter.h"
 #include "MissionAction.h"
 #include "NPC.h"
+#include "text/TextTemplate.h"
 
 #include <list>
 #include <map>
@@ -174,9 +175,10 @@ private:
 	
 private:
 	std::string name;
-	std::string displayName;
-	std::string description;
-	std::string blocked;
+	// Text that has substitutions filled in when the mission is instantiated.
+	TextTemplate displayName;
+	TextTemplate description;
+	TextTemplate blocked;
 	Location location = SPACEPORT;
 	
 	bool hasFailed = false;
@@ -187,7 +189,7 @@ private:
 	Date deadline;
 	int deadlineBase = 0;
 	int deadlineMultiplier = 0;
-	std::string clearance;
+	TextTemplate clearance;
 	LocationFilter clearanceFilter;
 	bool hasFullClearance = true;
 	
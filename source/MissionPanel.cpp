@@ -384,15 +384,7 @@ bool MissionPanel::Click(int x, int y, int clicks)
 	}
 	
 	// Figure out if a system was clicked on.
-	Point click = Point(x, y) / Zoom() - center;
-	const System *system = nullptr;
-	for(const auto &it : GameData::Systems())
-		if(it.second.IsValid() && click.Distance(it.second.Position()) < 10.
-				&& (player.HasSeen(it.second) || &it.second == specialSystem))
-		{
-			system = &it.second;
-			break;
-		}
+	const System *system = SystemAt(Point(x, y) / Zoom() - center);
 	if(system)
 	{
 		Select(system);
@@ -697,19 +689,25 @@ Point MissionPanel::DrawList(const list<Mission> &list, Point pos) const
 
 void MissionPanel::DrawMissionInfo()
 {
+	static const int CAN_ACCEPT = Information::ConditionSlot("can accept");
+	static const int CAN_ABORT = Information::ConditionSlot("can abort");
+	static const int CARGO_FREE = Information::StringSlot("cargo free");
+	static const int BUNKS_FREE = Information::StringSlot("bunks free");
+	static const int TODAY = Information::StringSlot("today");
+	
 	Information info;
 	
 	// The "accept / abort" button text and activation depends on what mission,
 	// if any, is selected, and whether missions are available.
 	if(CanAccept())
-		info.SetCondition("can accept");
+		info.SetCondition(CAN_ACCEPT);
 	else if(acceptedIt != accepted.end())
-		info.SetCondition("can abort");
+		info.SetCondition(CAN_ABORT);
 	
-	info.SetString("cargo free", to_string(player.Cargo().Free()) + " tons");
-	info.SetString("bunks free", to_string(player.Cargo().BunksFree()) + " bunks");
+	info.SetString(CARGO_FREE, to_string(player.Cargo().Free()) + " tons");
+	info.SetString(BUNKS_FREE, to_string(player.Cargo().BunksFree()) + " bunks");
 	
-	info.SetString("today", player.GetDate().ToString());
+	info.SetString(TODAY, player.GetDate().ToString());
 	
 	GameData::Interfaces().Get("mission")->Draw(info, this);
 	
@@ -762,6 +760,7 @@ void MissionPanel::Accept()
 	
 	++availableIt;
 	player.AcceptJob(toAccept, GetUI());
+	InvalidateCache();
 	if(availableIt == available.end() && !available.empty())
 		--availableIt;
 	
@@ -819,6 +818,7 @@ void MissionPanel::AbortMission()
 		const Mission &toAbort = *acceptedIt;
 		++acceptedIt;
 		player.RemoveMission(Mission::ABORT, toAbort, GetUI());
+		InvalidateCache();
 		if(acceptedIt == accepted.end() && !accepted.empty())
 			--acceptedIt;
 		if(acceptedIt != accepted.end() && !acceptedIt->IsVisible())
@@ -29,6 +29,7 @@ namespace {
 	GLint frameI;
 	GLint frameCountI;
 	GLint colorI;
+	GLint rectI;
 	
 	GLuint vao;
 	GLuint vbo;
@@ -71,12 +72,18 @@ void OutlineShader::Init()
 		"uniform float frameCount = 0;\n"
 		"uniform vec4 color = vec4(1, 1, 1, 1);\n"
 		"uniform vec2 off;\n"
+		"uniform vec4 rect = vec4(0, 0, 1, 1);\n"
 		"const vec4 weight = vec4(.4, .4, .4, 1.);\n"
 		
 		"in vec2 fragTexCoord;\n"
 		
 		"out vec4 finalColor;\n"
 		
+		// Map the sprite's texture coordinates to its area of a shared texture.
+		"vec2 SpriteCoord(vec2 coord) {\n"
+		"  return mix(rect.xy, rect.zw, clamp(coord, 0., 1.));\n"
+		"}\n"
+		
 		"float Sobel(float layer) {\n"
 		"  float sum = 0;\n"
 		"  for(int dy = -1; dy <= 1; ++dy)\n"
@@ -84,16 +91,16 @@ void OutlineShader::Init()
 		"    for(int dx = -1; dx <= 1; ++dx)\n"
 		"    {\n"
 		"      vec2 center = fragTexCoord + .618034 * off * vec2(dx, dy);\n"
-		"      float nw = dot(texture(tex, vec3(center + vec2(-off.x, -off.y), layer)), weight);\n"
-		"      float ne = dot(texture(tex, vec3(center + vec2(off.x, -off.y), layer)), weight);\n"
-		"      float sw = dot(texture(tex, vec3(center + vec2(-off.x, off.y), layer)), weight);\n"
-		"      float se = dot(texture(tex, vec3(center + vec2(off.x, off.y), layer)), weight);\n"
+		"      float nw = dot(texture(tex, vec3(SpriteCoord(center + vec2(-off.x, -off.y)), layer)), weight);\n"
+		"      float ne = dot(texture(tex, vec3(SpriteCoord(center + vec2(off.x, -off.y)), layer)), weight);\n"
+		"      float sw = dot(texture(tex, vec3(SpriteCoord(center + vec2(-off.x, off.y)), layer)), weight);\n"
+		"      float se = dot(texture(tex, vec3(SpriteCoord(center + vec2(off.x, off.y)), layer)), weight);\n"
 		"      float h = nw + sw - ne - se + 2 * (\n"
-		"        dot(texture(tex, vec3(center + vec2(-off.x, 0), layer)), weight)\n"
-		"          - dot(texture(tex, vec3(center + vec2(off.x, 0), layer)), weight));\n"
+		"        dot(texture(tex, vec3(SpriteCoord(center + vec2(-off.x, 0)), layer)), weight)\n"
+		"          - dot(texture(tex, vec3(SpriteCoord(center + vec2(off.x, 0)), layer)), weight));\n"
 		"      float v = nw + ne - sw - se + 2 * (\n"
-		"        dot(texture(tex, vec3(center + vec2(0, -off.y), layer)), weight)\n"
-		"          - dot(texture(tex, vec3(center + vec2(0, off.y), layer)), weight));\n"
+		"        dot(texture(tex, vec3(SpriteCoord(center + vec2(0, -off.y)), layer)), weight)\n"
+		"          - dot(texture(tex, vec3(SpriteCoord(center + vec2(0, off.y)), layer)), weight));\n"
 		"      sum += h * h + v * v;\n"
 		"    }\n"
 		"  }\n"
@@ -116,6 +123,7 @@ void OutlineShader::Init()
 	frameI = shader.Uniform("frame");
 	frameCountI = shader.Uniform("frameCount");
 	colorI = shader.Uniform("color");
+	rectI = shader.Uniform("rect");
 	
 	glUseProgram(shader.Object());
 	glUniform1i(shader.Uniform("tex"), 0);
@@ -183,7 +191,9 @@ void OutlineShader::Draw(const Sprite *sprite, const Point &pos, const Point &si
 	
 	glUniform4fv(colorI, 1, color.Get());
 	
-	glBindTexture(GL_TEXTURE_2D_ARRAY, sprite->Texture(unit.Length() * Screen::Zoom() > 50.));
+	bool isHighDPI = (unit.Length() * Screen::Zoom() > 50.);
+	glUniform4fv(rectI, 1, sprite->TextureRect(isHighDPI));
+	glBindTexture(GL_TEXTURE_2D_ARRAY, sprite->Texture(isHighDPI));
 	
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 	
@@ -0,0 +1,169 @@
+/* ParticleSystem.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "ParticleSystem.h"
+
+#include "BatchDrawList.h"
+#include "Random.h"
+#include "Sprite.h"
+#include "Visual.h"
+
+using namespace std;
+
+namespace {
+	// Flags for how a particle's animation loops.
+	const uint8_t REPEAT = 1;
+	const uint8_t REWIND = 2;
+}
+
+
+
+// Take over the state of the given visuals, leaving the vector empty. The
+// step is the animation step on which they will first be drawn.
+void ParticleSystem::Append(vector<Visual> &added, int step)
+{
+	for(const Visual &visual : added)
+	{
+		// A visual with no sprite has no effect once its sound has been played.
+		if(!visual.HasSprite())
+			continue;
+		
+		x.push_back(visual.position.X());
+		y.push_back(visual.position.Y());
+		dx.push_back(visual.velocity.X());
+		dy.push_back(visual.velocity.Y());
+		angle.push_back(visual.angle);
+		spin.push_back(visual.spin);
+		lifetime.push_back(visual.lifetime);
+		
+		// Resolve the animation's starting point now, instead of on the first
+		// step that it is drawn. This is the same calculation Body::SetStep()
+		// does, except that any pause is folded into the offset.
+		float frames = visual.sprite->Frames();
+		float length = (visual.rewind ? 2.f * (frames - 1.f) : frames) + visual.delay;
+		float offset = visual.frameOffset - visual.frameRate * visual.pause;
+		if(frames > 1.f)
+		{
+			if(visual.randomize)
+				offset += static_cast<float>(Random::Real()) * length;
+			else if(visual.startAtZero)
+				offset -= visual.frameRate * (step - visual.pause);
+		}
+		sprite.push_back(visual.sprite);
+		frameRate.push_back(visual.frameRate);
+		frameOffset.push_back(offset);
+		cycle.push_back(length);
+		loop.push_back((visual.repeat ? REPEAT : 0) | (visual.rewind ? REWIND : 0));
+	}
+	added.clear();
+}
+
+
+
+// Remove all the particles.
+void ParticleSystem::Clear()
+{
+	Resize(0);
+}
+
+
+
+// Step every particle forward, and remove the ones whose lifetime is over.
+void ParticleSystem::Move()
+{
+	// Each of these loops only touches one or two arrays, so the compiler is
+	// free to vectorize them. A particle whose lifetime has run out also gets
+	// moved, but it is removed before it can be drawn.
+	size_t count = lifetime.size();
+	for(size_t i = 0; i < count; ++i)
+		x[i] += dx[i];
+	for(size_t i = 0; i < count; ++i)
+		y[i] += dy[i];
+	for(size_t i = 0; i < count; ++i)
+		angle[i] += spin[i];
+	
+	int expired = 0;
+	for(size_t i = 0; i < count; ++i)
+		expired |= (--lifetime[i] < 0);
+	if(expired)
+		Remove();
+}
+
+
+
+// Add every particle to the given draw list, animated to the given step.
+void ParticleSystem::Draw(BatchDrawList &draw, int step) const
+{
+	size_t count = lifetime.size();
+	for(size_t i = 0; i < count; ++i)
+	{
+		float frame = Body::WrapFrame(frameRate[i] * step + frameOffset[i],
+			sprite[i]->Frames(), cycle[i], loop[i] & REPEAT, loop[i] & REWIND);
+		draw.AddParticle(sprite[i], Point(x[i], y[i]), Point(dx[i], dy[i]), angle[i], frame);
+	}
+}
+
+
+
+size_t ParticleSystem::Size() const
+{
+	return lifetime.size();
+}
+
+
+
+// Erase all the particles whose lifetime has run out, preserving the order
+// of the remaining ones.
+void ParticleSystem::Remove()
+{
+	size_t out = 0;
+	for(size_t in = 0; in < lifetime.size(); ++in)
+	{
+		if(lifetime[in] < 0)
+			continue;
+		if(out != in)
+		{
+			x[out] = x[in];
+			y[out] = y[in];
+			dx[out] = dx[in];
+			dy[out] = dy[in];
+			angle[out] = angle[in];
+			spin[out] = spin[in];
+			lifetime[out] = lifetime[in];
+			sprite[out] = sprite[in];
+			frameRate[out] = frameRate[in];
+			frameOffset[out] = frameOffset[in];
+			cycle[out] = cycle[in];
+			loop[out] = loop[in];
+		}
+		++out;
+	}
+	Resize(out);
+}
+
+
+
+void ParticleSystem::Resize(size_t size)
+{
+	x.resize(size);
+	y.resize(size);
+	dx.resize(size);
+	dy.resize(size);
+	angle.resize(size);
+	spin.resize(size);
+	lifetime.resize(size);
+	sprite.resize(size);
+	frameRate.resize(size);
+	frameOffset.resize(size);
+	cycle.resize(size);
+	loop.resize(size);
+}
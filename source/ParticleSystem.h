@@ -0,0 +1,78 @@
+/* ParticleSystem.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef PARTICLE_SYSTEM_H_
+#define PARTICLE_SYSTEM_H_
+
+#include "Angle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BatchDrawList;
+class Sprite;
+class Visual;
+
+
+
+// Class holding all the visual effects in the current system. Visuals are only
+// ever moved, aged, and drawn, so rather than storing them as individual Body
+// objects, each of their attributes is stored in its own array. That way the
+// per-step update is a few tight loops over contiguous data.
+class ParticleSystem {
+public:
+	// Take over the state of the given visuals, leaving the vector empty. The
+	// step is the animation step on which they will first be drawn.
+	void Append(std::vector<Visual> &added, int step);
+	// Remove all the particles.
+	void Clear();
+	
+	// Step every particle forward, and remove the ones whose lifetime is over.
+	void Move();
+	// Add every particle to the given draw list, animated to the given step.
+	void Draw(BatchDrawList &draw, int step) const;
+	
+	size_t Size() const;
+
+
+private:
+	// Erase all the particles whose lifetime has run out, preserving the order
+	// of the remaining ones.
+	void Remove();
+	void Resize(size_t size);
+
+
+private:
+	// Position and velocity, in world coordinates.
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> dx;
+	std::vector<double> dy;
+	std::vector<Angle> angle;
+	std::vector<Angle> spin;
+	// How many more steps each particle will be moved before it is removed.
+	std::vector<int> lifetime;
+	
+	// Animation parameters. The frame shown at any given step is:
+	// (step * frameRate + frameOffset), wrapped by the cycle length according
+	// to the particle's loop flags.
+	std::vector<const Sprite *> sprite;
+	std::vector<float> frameRate;
+	std::vector<float> frameOffset;
+	std::vector<float> cycle;
+	std::vector<uint8_t> loop;
+};
+
+
+
+#endif
@@ -95,37 +95,46 @@ void PlanetPanel::Draw()
 	if(player.IsDead())
 		return;
 	
+	static const int LAND = Information::SpriteSlot("land");
+	static const int HAS_SHIP = Information::ConditionSlot("has ship");
+	static const int HAS_BANK = Information::ConditionSlot("has bank");
+	static const int IS_INHABITED = Information::ConditionSlot("is inhabited");
+	static const int HAS_TRADE = Information::ConditionSlot("has trade");
+	static const int HAS_SPACEPORT = Information::ConditionSlot("has spaceport");
+	static const int HAS_SHIPYARD = Information::ConditionSlot("has shipyard");
+	static const int HAS_OUTFITTER = Information::ConditionSlot("has outfitter");
+	
 	Information info;
-	info.SetSprite("land", planet.Landscape());
+	info.SetSprite(LAND, planet.Landscape());
 	
 	const Ship *flagship = player.Flagship();
 	if(flagship && flagship->CanBeFlagship())
-		info.SetCondition("has ship");
+		info.SetCondition(HAS_SHIP);
 	
 	if(planet.CanUseServices())
 	{
 		if(planet.IsInhabited())
 		{
-			info.SetCondition("has bank");
+			info.SetCondition(HAS_BANK);
 			if(flagship)
 			{
-				info.SetCondition("is inhabited");
+				info.SetCondition(IS_INHABITED);
 				if(system.HasTrade())
-					info.SetCondition("has trade");
+					info.SetCondition(HAS_TRADE);
 			}
 		}
 		
 		if(flagship && planet.HasSpaceport())
-			info.SetCondition("has spaceport");
+			info.SetCondition(HAS_SPACEPORT);
 		
 		if(planet.HasShipyard())
-			info.SetCondition("has shipyard");
+			info.SetCondition(HAS_SHIPYARD);
 		
 		if(planet.HasOutfitter())
 			for(const auto &it : player.Ships())
 				if(it->GetSystem() == &system && !it->IsDisabled())
 				{
-					info.SetCondition("has outfitter");
+					info.SetCondition(HAS_OUTFITTER);
 					break;
 				}
 	}
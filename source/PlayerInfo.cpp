@@ -31,6 +31,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Preferences.h"
 #include "Random.h"
 #include "SavedGame.h"
+#include "SaveQueue.h"
 #include "Ship.h"
 #include "ShipEvent.h"
 #include "StartConditions.h"
@@ -45,9 +46,21 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 using namespace std;
 
+namespace {
+	// Every change to what the map shows gets a new number, even across
+	// different pilots, so something cached for one pilot's map can never be
+	// mistaken for being up to date for another.
+	int NextMapVersion()
+	{
+		static int version = 0;
+		return ++version;
+	}
+}
+
 
 
 // Completely clear all loaded information, to prepare for loading a file or
@@ -117,8 +130,10 @@ void PlayerInfo::New(const StartConditions &start)
 // Load player information from a saved game file.
 void PlayerInfo::Load(const string &path)
 {
-	// Make sure any previously loaded data is cleared.
+	// Make sure any previously loaded data is cleared, and that the file being
+	// loaded is not still waiting to be written.
 	Clear();
+	SaveQueue::Finish();
 	
 	filePath = path;
 	// Strip anything after the "~" from snapshots, so that the file we save
@@ -341,6 +356,9 @@ void PlayerInfo::Save() const
 	
 	if(filePath.rfind(".txt") == filePath.length() - 4)
 	{
+		// An earlier save may still be waiting to be written. Let it finish so
+		// that the backups are rotated based on what is really on the disk.
+		SaveQueue::Finish();
 		// Only update the backups if this save will have a newer date.
 		SavedGame saved(filePath);
 		if(saved.GetDate() != date.ToString())
@@ -385,6 +403,7 @@ void PlayerInfo::AddChanges(list<DataNode> &changes)
 		changedSystems |= (change.Token(0) == "unlink");
 		GameData::Change(change);
 	}
+	mapVersion = NextMapVersion();
 	if(changedSystems)
 	{
 		// Recalculate what systems have been seen.
@@ -1906,9 +1925,42 @@ bool PlayerInfo::KnowsName(const System &system) const
 }
 
 
+
+// Find every system for which HasSeen() or KnowsName() would be true.
+void PlayerInfo::KnownSystems(set<const System *> &seenSystems, set<const System *> &namedSystems) const
+{
+	namedSystems = visitedSystems;
+	auto nameDestination = [&namedSystems](const Mission &mission)
+	{
+		const vector<const System *> &systems = mission.Destination()->WormholeSystems();
+		namedSystems.insert(systems.begin(), systems.end());
+	};
+	for(const Mission &mission : availableJobs)
+		nameDestination(mission);
+	for(const Mission &mission : missions)
+		if(mission.IsVisible())
+			nameDestination(mission);
+	
+	seenSystems = seen;
+	seenSystems.insert(namedSystems.begin(), namedSystems.end());
+	auto seeStops = [&seenSystems](const Mission &mission)
+	{
+		if(!mission.IsVisible())
+			return;
+		seenSystems.insert(mission.Waypoints().begin(), mission.Waypoints().end());
+		for(const Planet *planet : mission.Stopovers())
+			seenSystems.insert(planet->WormholeSystems().begin(), planet->WormholeSystems().end());
+	};
+	for_each(availableJobs.begin(), availableJobs.end(), seeStops);
+	for_each(missions.begin(), missions.end(), seeStops);
+}
+
+
+
 // Mark the given system as visited, and mark all its neighbors as seen.
 void PlayerInfo::Visit(const System &system)
 {
+	mapVersion = NextMapVersion();
 	visitedSystems.insert(&system);
 	seen.insert(&system);
 	for(const System *neighbor : system.VisibleNeighbors())
@@ -1921,6 +1973,7 @@ void PlayerInfo::Visit(const System &system)
 // Mark the given planet as visited.
 void PlayerInfo::Visit(const Planet &planet)
 {
+	mapVersion = NextMapVersion();
 	visitedPlanets.insert(&planet);
 }
 
@@ -1929,6 +1982,7 @@ void PlayerInfo::Visit(const Planet &planet)
 // Mark a system as unvisited, even if visited previously.
 void PlayerInfo::Unvisit(const System &system)
 {
+	mapVersion = NextMapVersion();
 	visitedSystems.erase(&system);
 	for(const StellarObject &object : system.Objects())
 		if(object.GetPlanet())
@@ -1939,11 +1993,21 @@ void PlayerInfo::Unvisit(const System &system)
 
 void PlayerInfo::Unvisit(const Planet &planet)
 {
+	mapVersion = NextMapVersion();
 	visitedPlanets.erase(&planet);
 }
 
 
 
+// Get a number that changes whenever the player visits or unvisits a system
+// or planet, or an event changes the galaxy.
+int PlayerInfo::MapVersion() const
+{
+	return mapVersion;
+}
+
+
+
 // Check if the player has a hyperspace route set.
 bool PlayerInfo::HasTravelPlan() const
 {
@@ -2725,9 +2789,11 @@ void PlayerInfo::Autosave() const
 
 
 
+// Compose the save file on this thread, but leave writing it to disk to the
+// SaveQueue's background thread.
 void PlayerInfo::Save(const string &path) const
 {
-	DataWriter out(path);
+	DataWriter out;
 	
 	
 	// Basic player information and persistent UI settings:
@@ -2977,6 +3043,11 @@ void PlayerInfo::Save(const string &path) const
 	out.Write();
 	out.WriteComment("How you began:");
 	startData.Save(out);
+	
+	// The pilot can be saved compressed. DataFile recognizes either format
+	// when the file is read back in. The compression is done by the thread
+	// that writes the file.
+	SaveQueue::Add(path, out.SaveToString(), Preferences::Has("Compress saved games"));
 }
 
 
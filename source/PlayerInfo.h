@@ -212,12 +212,18 @@ public:
 	bool HasVisited(const System &system) const;
 	bool HasVisited(const Planet &planet) const;
 	bool KnowsName(const System &system) const;
+	// Find every system for which HasSeen() or KnowsName() would be true. This
+	// is much faster than checking each system in the galaxy one at a time.
+	void KnownSystems(std::set<const System *> &seenSystems, std::set<const System *> &namedSystems) const;
 	// Marking a system as visited also "sees" its neighbors.
 	void Visit(const System &system);
 	void Visit(const Planet &planet);
 	// Mark a system and its planets as unvisited, even if visited previously.
 	void Unvisit(const System &system);
 	void Unvisit(const Planet &planet);
+	// Get a number that changes whenever the player visits or unvisits a system
+	// or planet, or an event changes the galaxy.
+	int MapVersion() const;
 	
 	// Access the player's travel plan.
 	bool HasTravelPlan() const;
@@ -343,6 +349,7 @@ private:
 	std::set<const System *> seen;
 	std::set<const System *> visitedSystems;
 	std::set<const Planet *> visitedPlanets;
+	int mapVersion = 0;
 	std::vector<const System *> travelPlan;
 	const Planet *travelDestination = nullptr;
 	
@@ -122,9 +122,18 @@ void PlayerInfoPanel::Draw()
 	// Dim everything behind this panel.
 	DrawBackdrop();
 	
+	static const int PLAYER_TAB = Information::ConditionSlot("player tab");
+	static const int SHOW_PARK_ALL = Information::ConditionSlot("show park all");
+	static const int SHOW_UNPARK_ALL = Information::ConditionSlot("show unpark all");
+	static const int CAN_PARK = Information::ConditionSlot("can park");
+	static const int SHOW_PARK = Information::ConditionSlot("show park");
+	static const int SHOW_UNPARK = Information::ConditionSlot("show unpark");
+	static const int THREE_BUTTONS = Information::ConditionSlot("three buttons");
+	static const int ENABLE_LOGBOOK = Information::ConditionSlot("enable logbook");
+	
 	// Fill in the information for how this interface should be drawn.
 	Information interfaceInfo;
-	interfaceInfo.SetCondition("player tab");
+	interfaceInfo.SetCondition(PLAYER_TAB);
 	if(canEdit && player.Ships().size() > 1)
 	{
 		bool allParked = true;
@@ -137,7 +146,7 @@ void PlayerInfoPanel::Draw()
 				hasOtherShips = true;
 			}
 		if(hasOtherShips)
-			interfaceInfo.SetCondition(allParked ? "show unpark all" : "show park all");
+			interfaceInfo.SetCondition(allParked ? SHOW_UNPARK_ALL : SHOW_PARK_ALL);
 		
 		// If ships are selected, decide whether the park or unpark button
 		// should be shown.
@@ -156,14 +165,14 @@ void PlayerInfoPanel::Draw()
 			}
 			if(parkable)
 			{
-				interfaceInfo.SetCondition("can park");
-				interfaceInfo.SetCondition(allParked ? "show unpark" : "show park");
+				interfaceInfo.SetCondition(CAN_PARK);
+				interfaceInfo.SetCondition(allParked ? SHOW_UNPARK : SHOW_PARK);
 			}
 		}
 	}
-	interfaceInfo.SetCondition("three buttons");
+	interfaceInfo.SetCondition(THREE_BUTTONS);
 	if(player.HasLogs())
-		interfaceInfo.SetCondition("enable logbook");
+		interfaceInfo.SetCondition(ENABLE_LOGBOOK);
 	
 	// Draw the interface.
 	const Interface *infoPanelUi = GameData::Interfaces().Get("info panel");
@@ -18,20 +18,38 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Shader.h"
 
 #include <stdexcept>
+#include <vector>
 
 using namespace std;
 
 namespace {
 	Shader shader;
 	GLint scaleI;
-	GLint centerI;
-	GLint angleI;
-	GLint sizeI;
-	GLint offsetI;
-	GLint colorI;
 	
 	GLuint vao;
 	GLuint vbo;
+	
+	// Each pointer is a single triangle. Each vertex holds the corner of the
+	// triangle it is at, followed by all the parameters of its pointer: center,
+	// direction, width and height, offset, and color.
+	const int VERTEX_SIZE = 13;
+	const GLfloat CORNERS[] = {
+		0.f, 0.f,
+		0.f, 1.f,
+		1.f, 0.f,
+	};
+	// The vertices of all the pointers added since the last Bind().
+	vector<GLfloat> vertices;
+	
+	// Point the attribute with the given name at the given number of floats,
+	// starting at the given offset into each vertex.
+	void EnableAttribute(const char *name, int size, int offset)
+	{
+		GLint attrib = shader.Attrib(name);
+		glEnableVertexAttribArray(attrib);
+		glVertexAttribPointer(attrib, size, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),
+			reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+	}
 }
 
 
@@ -41,15 +59,20 @@ void PointerShader::Init()
 	static const char *vertexCode =
 		"// vertex pointer shader\n"
 		"uniform vec2 scale;\n"
-		"uniform vec2 center;\n"
-		"uniform vec2 angle;\n"
-		"uniform vec2 size;\n"
-		"uniform float offset;\n"
 		
 		"in vec2 vert;\n"
+		"in vec2 center;\n"
+		"in vec2 angle;\n"
+		"in vec2 size;\n"
+		"in float offset;\n"
+		"in vec4 color;\n"
 		"out vec2 coord;\n"
+		"flat out float pointerWidth;\n"
+		"flat out vec4 pointerColor;\n"
 		
 		"void main() {\n"
+		"  pointerWidth = size.x;\n"
+		"  pointerColor = color;\n"
 		"  coord = vert * size.x;\n"
 		"  vec2 base = center + angle * (offset - size.y * (vert.x + vert.y));\n"
 		"  vec2 wing = vec2(angle.y, -angle.x) * (size.x * .5 * (vert.x - vert.y));\n"
@@ -58,45 +81,37 @@ void PointerShader::Init()
 
 	static const char *fragmentCode =
 		"// fragment pointer shader\n"
-		"uniform vec4 color = vec4(1, 1, 1, 1);\n"
-		"uniform vec2 size;\n"
 		
 		"in vec2 coord;\n"
+		"flat in float pointerWidth;\n"
+		"flat in vec4 pointerColor;\n"
 		"out vec4 finalColor;\n"
 		
 		"void main() {\n"
-		"  float height = (coord.x + coord.y) / size.x;\n"
+		"  float height = (coord.x + coord.y) / pointerWidth;\n"
 		"  float taper = height * height * height;\n"
-		"  taper *= taper * .5 * size.x;\n"
+		"  taper *= taper * .5 * pointerWidth;\n"
 		"  float alpha = clamp(.8 * min(coord.x, coord.y) - taper, 0, 1);\n"
 		"  alpha *= clamp(1.8 * (1. - height), 0, 1);\n"
-		"  finalColor = color * alpha;\n"
+		"  finalColor = pointerColor * alpha;\n"
 		"}\n";
 	
 	shader = Shader(vertexCode, fragmentCode);
 	scaleI = shader.Uniform("scale");
-	centerI = shader.Uniform("center");
-	angleI = shader.Uniform("angle");
-	sizeI = shader.Uniform("size");
-	offsetI = shader.Uniform("offset");
-	colorI = shader.Uniform("color");
 	
-	// Generate the vertex data for drawing sprites.
+	// Generate the buffer for uploading the pointer vertex data.
 	glGenVertexArrays(1, &vao);
 	glBindVertexArray(vao);
 	
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	
-	GLfloat vertexData[] = {
-		0.f, 0.f,
-		0.f, 1.f,
-		1.f, 0.f,
-	};
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertexData), vertexData, GL_STATIC_DRAW);
-	
-	glEnableVertexAttribArray(shader.Attrib("vert"));
-	glVertexAttribPointer(shader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	EnableAttribute("vert", 2, 0);
+	EnableAttribute("center", 2, 2);
+	EnableAttribute("angle", 2, 4);
+	EnableAttribute("size", 2, 6);
+	EnableAttribute("offset", 1, 8);
+	EnableAttribute("color", 4, 9);
 	
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -115,43 +130,56 @@ void PointerShader::Draw(const Point &center, const Point &angle, float width, f
 }
 
 
-	
+
+// Start a batch of pointers. Nothing is drawn until Unbind() is called.
 void PointerShader::Bind()
 {
 	if(!shader.Object())
 		throw runtime_error("PointerShader: Bind() called before Init().");
 	
-	glUseProgram(shader.Object());
-	glBindVertexArray(vao);
-	
-	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
-	glUniform2fv(scaleI, 1, scale);
+	vertices.clear();
 }
 
 
 
 void PointerShader::Add(const Point &center, const Point &angle, float width, float height, float offset, const Color &color)
 {
-	GLfloat c[2] = {static_cast<float>(center.X()), static_cast<float>(center.Y())};
-	glUniform2fv(centerI, 1, c);
-	
-	GLfloat a[2] = {static_cast<float>(angle.X()), static_cast<float>(angle.Y())};
-	glUniform2fv(angleI, 1, a);
-	
-	GLfloat size[2] = {width, height};
-	glUniform2fv(sizeI, 1, size);
-	
-	glUniform1f(offsetI, offset);
-	
-	glUniform4fv(colorI, 1, color.Get());
-	
-	glDrawArrays(GL_TRIANGLES, 0, 3);
+	const float *rgba = color.Get();
+	const GLfloat pointer[VERTEX_SIZE - 2] = {
+		static_cast<float>(center.X()), static_cast<float>(center.Y()),
+		static_cast<float>(angle.X()), static_cast<float>(angle.Y()),
+		width, height,
+		offset,
+		rgba[0], rgba[1], rgba[2], rgba[3]
+	};
+	for(int i = 0; i < 3; ++i)
+	{
+		vertices.insert(vertices.end(), CORNERS + 2 * i, CORNERS + 2 * i + 2);
+		vertices.insert(vertices.end(), pointer, pointer + VERTEX_SIZE - 2);
+	}
 }
 
 
 
+// Draw all the pointers added since Bind() with a single draw call.
 void PointerShader::Unbind()
 {
+	if(vertices.empty())
+		return;
+	
+	glUseProgram(shader.Object());
+	glBindVertexArray(vao);
+	
+	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
+	glUniform2fv(scaleI, 1, scale);
+	
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	
+	glDrawArrays(GL_TRIANGLES, 0, vertices.size() / VERTEX_SIZE);
+	vertices.clear();
+	
 	glBindVertexArray(0);
 	glUseProgram(0);
 }
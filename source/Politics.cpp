@@ -31,6 +31,7 @@ using namespace std;
 // Reset to the initial political state defined in the game data.
 void Politics::Reset()
 {
+	++version;
 	reputationWith.clear();
 	dominatedPlanets.clear();
 	ResetDaily();
@@ -79,6 +80,8 @@ bool Politics::IsEnemy(const Government *first, const Government *second) const
 // reputation.
 void Politics::Offend(const Government *gov, int eventType, int count)
 {
+	++version;
+	
 	if(gov->IsPlayer())
 		return;
 	
@@ -119,6 +122,7 @@ void Politics::Offend(const Government *gov, int eventType, int count)
 // Bribe the given government to be friendly to you for one day.
 void Politics::Bribe(const Government *gov)
 {
+	++version;
 	bribed.insert(gov);
 	provoked.erase(gov);
 	fined.insert(gov);
@@ -180,6 +184,7 @@ bool Politics::CanUseServices(const Planet *planet) const
 // Bribe a planet to let the player's ships land there.
 void Politics::BribePlanet(const Planet *planet, bool fullAccess)
 {
+	++version;
 	bribedPlanets[planet] = fullAccess;
 }
 
@@ -187,6 +192,8 @@ void Politics::BribePlanet(const Planet *planet, bool fullAccess)
 
 void Politics::DominatePlanet(const Planet *planet, bool dominate)
 {
+	++version;
+	
 	if(dominate)
 		dominatedPlanets.insert(planet);
 	else
@@ -310,6 +317,7 @@ double Politics::Reputation(const Government *gov) const
 
 void Politics::AddReputation(const Government *gov, double value)
 {
+	++version;
 	reputationWith[gov] += value;
 }
 
@@ -317,6 +325,7 @@ void Politics::AddReputation(const Government *gov, double value)
 
 void Politics::SetReputation(const Government *gov, double value)
 {
+	++version;
 	reputationWith[gov] = value;
 }
 
@@ -325,8 +334,18 @@ void Politics::SetReputation(const Government *gov, double value)
 // Reset any temporary provocation (typically because a day has passed).
 void Politics::ResetDaily()
 {
+	++version;
 	provoked.clear();
 	bribed.clear();
 	bribedPlanets.clear();
 	fined.clear();
 }
+
+
+
+// Get a number that changes whenever the player's standing with any
+// government or planet changes.
+int Politics::Version() const
+{
+	return version;
+}
@@ -65,6 +65,10 @@ public:
 	// Reset any temporary effects (typically because a day has passed).
 	void ResetDaily();
 	
+	// Get a number that changes whenever the player's standing with any
+	// government or planet changes.
+	int Version() const;
+	
 	
 private:
 	// attitude[target][other] stores how much an action toward the given target
@@ -78,6 +82,8 @@ private:
 	std::map<const Planet *, bool> bribedPlanets;
 	std::set<const Planet *> dominatedPlanets;
 	std::set<const Government *> fined;
+	
+	int version = 0;
 };
 
 
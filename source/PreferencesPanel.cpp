@@ -78,8 +78,10 @@ void PreferencesPanel::Draw()
 	glClear(GL_COLOR_BUFFER_BIT);
 	GameData::Background().Draw(Point(), Point());
 	
+	static const int VOLUME = Information::BarSlot("volume");
+	
 	Information info;
-	info.SetBar("volume", Audio::Volume());
+	info.SetBar(VOLUME, Audio::Volume());
 	GameData::Interfaces().Get("menu background")->Draw(info, this);
 	string pageName = (page == 'c' ? "controls" : page == 's' ? "settings" : "plugins");
 	GameData::Interfaces().Get(pageName)->Draw(info, this);
@@ -457,6 +459,7 @@ void PreferencesPanel::DrawSettings()
 		"",
 		"Other",
 		"Clickable radar display",
+		"Compress saved games",
 		"Hide unexplored map regions",
 		REACTIVATE_HELP,
 		"Interrupt fast-forward",
@@ -99,7 +99,8 @@ Projectile::Projectile(Point position, const Weapon *weapon)
 
 
 // This returns false if it is time to delete this projectile.
-void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
+void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles,
+	const vector<shared_ptr<Ship>> &targetable)
 {
 	if(--lifetime <= 0)
 	{
@@ -123,12 +124,14 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 			visuals.emplace_back(*it.first, position, velocity, angle);
 	
 	// If the target has left the system, stop following it. Also stop if the
-	// target has been captured by a different government.
+	// target has been captured by a different government. The list of ships
+	// that can be targeted keeps all of them alive, so if the target is in it,
+	// the cached pointer to it is still valid.
 	const Ship *target = cachedTarget;
 	if(target)
 	{
-		target = TargetPtr().get();
-		if(!target || !target->IsTargetable() || target->GetGovernment() != targetGovernment)
+		if(!binary_search(targetable.begin(), targetable.end(), targetShip, owner_less<shared_ptr<Ship>>())
+				|| target->GetGovernment() != targetGovernment)
 		{
 			targetShip.reset();
 			cachedTarget = nullptr;
@@ -50,8 +50,13 @@ public:
 	const Government *GetGovernment() const;
 	*/
 	
-	// Move the projectile. It may create effects or submunitions.
-	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &projectiles);
+	// Move the projectile. It may create effects or submunitions. The given
+	// ships are the ones that can be tracked in this step, sorted with
+	// std::owner_less; this projectile loses its target if it is not one of
+	// them. This only changes this projectile, so different projectiles can be
+	// moved in parallel.
+	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &projectiles,
+		const std::vector<std::shared_ptr<Ship>> &targetable);
 	// This projectile hit something. Create the explosion, if any. This also
 	// marks the projectile as needing deletion.
 	void Explode(std::vector<Visual> &visuals, double intersection, Point hitVelocity = Point());
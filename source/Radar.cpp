@@ -84,6 +84,7 @@ void Radar::AddViewportBoundary(const Point &vertex)
 void Radar::Draw(const Point &center, double scale, double radius, double pointerRadius) const
 {
 	// Draw any desired line vectors.
+	LineShader::Bind();
 	for(const Line &line : lines)
 	{
 		Point start = line.base * scale;
@@ -104,8 +105,9 @@ void Radar::Draw(const Point &center, double scale, double radius, double pointe
 		else if(endExcess > 0)
 			v -= endExcess * v.Unit();
 		
-		LineShader::Draw(start + center, start + v + center, 1.f, line.color);
+		LineShader::Add(start + center, start + v + center, 1.f, line.color);
 	}
+	LineShader::Unbind();
 	
 	// Draw StellarObjects and ships.
 	RingShader::Bind();
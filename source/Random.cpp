@@ -15,7 +15,9 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <random>
 
 #ifndef __linux__
+#include <map>
 #include <mutex>
+#include <thread>
 #endif
 
 using namespace std;
@@ -27,10 +29,50 @@ namespace {
 	mt19937_64 gen;
 	uniform_int_distribution<uint32_t> uniform;
 	uniform_real_distribution<double> real;
+	// The generator of each thread that is using a Random::Stream.
+	map<thread::id, mt19937_64 *> streams;
+	
+	// Get the generator to use on this thread. The caller must hold the mutex.
+	mt19937_64 &Generator()
+	{
+		if(streams.empty())
+			return gen;
+		auto it = streams.find(this_thread::get_id());
+		return (it == streams.end() ? gen : *it->second);
+	}
+	
+	// Make the given generator the one used by this thread, returning the one
+	// that was used before.
+	mt19937_64 *SetStream(mt19937_64 *stream)
+	{
+		lock_guard<mutex> lock(workaroundMutex);
+		mt19937_64 *&current = streams[this_thread::get_id()];
+		mt19937_64 *previous = current;
+		current = stream;
+		if(!stream)
+			streams.erase(this_thread::get_id());
+		return previous;
+	}
 #else
 	thread_local mt19937_64 gen;
 	thread_local uniform_int_distribution<uint32_t> uniform;
 	thread_local uniform_real_distribution<double> real;
+	thread_local mt19937_64 *stream = nullptr;
+	
+	// Get the generator to use on this thread.
+	mt19937_64 &Generator()
+	{
+		return (stream ? *stream : gen);
+	}
+	
+	// Make the given generator the one used by this thread, returning the one
+	// that was used before.
+	mt19937_64 *SetStream(mt19937_64 *newStream)
+	{
+		mt19937_64 *previous = stream;
+		stream = newStream;
+		return previous;
+	}
 #endif
 }
 
@@ -43,7 +85,7 @@ void Random::Seed(uint64_t seed)
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	gen.seed(seed);
+	Generator().seed(seed);
 }
 
 
@@ -53,7 +95,7 @@ uint32_t Random::Int()
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	return uniform(gen);
+	return uniform(Generator());
 }
 
 
@@ -63,7 +105,7 @@ uint32_t Random::Int(uint32_t modulus)
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	return uniform(gen) % modulus;
+	return uniform(Generator()) % modulus;
 }
 
 
@@ -73,7 +115,7 @@ double Random::Real()
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	return real(gen);
+	return real(Generator());
 }
 
 
@@ -86,7 +128,7 @@ uint32_t Random::Polya(uint32_t k, double p)
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	return polya(gen);
+	return polya(Generator());
 }
 
 
@@ -98,7 +140,7 @@ uint32_t Random::Binomial(uint32_t t, double p)
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	return binomial(gen);
+	return binomial(Generator());
 }
 
 
@@ -110,5 +152,21 @@ double Random::Normal()
 #ifndef __linux__
 	lock_guard<mutex> lock(workaroundMutex);
 #endif
-	return normal(gen);
+	return normal(Generator());
+}
+
+
+
+// Use a generator of this stream's own on this thread until it is destroyed.
+Random::Stream::Stream(uint64_t seed)
+	: gen(seed)
+{
+	previous = SetStream(&gen);
+}
+
+
+
+Random::Stream::~Stream()
+{
+	SetStream(previous);
 }
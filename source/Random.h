@@ -14,6 +14,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #define RANDOM_H_
 
 #include <cstdint>
+#include <random>
 
 
 
@@ -41,6 +42,27 @@ public:
 	static uint32_t Binomial(uint32_t t, double p = .5);
 	// Get a normally distributed number (mean = 0, sigma= 1).
 	static double Normal();
+	
+	
+public:
+	// While an object of this class exists, all the random numbers generated
+	// on the thread that created it come from a generator of its own, seeded
+	// with the given value. Parallel loops use this so that the numbers each
+	// part of the loop gets do not depend on which thread runs it or on what
+	// the other threads are doing.
+	class Stream {
+	public:
+		explicit Stream(uint64_t seed);
+		~Stream();
+		
+		Stream(const Stream &) = delete;
+		Stream &operator=(const Stream &) = delete;
+		
+	private:
+		std::mt19937_64 gen;
+		// The stream that was in use on this thread before this one, if any.
+		std::mt19937_64 *previous = nullptr;
+	};
 };
 
 
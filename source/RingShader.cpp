@@ -19,22 +19,41 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Shader.h"
 
 #include <stdexcept>
+#include <vector>
 
 using namespace std;
 
 namespace {
 	Shader shader;
 	GLint scaleI;
-	GLint positionI;
-	GLint radiusI;
-	GLint widthI;
-	GLint angleI;
-	GLint startAngleI;
-	GLint dashI;
-	GLint colorI;
 	
 	GLuint vao;
 	GLuint vbo;
+	
+	// Each ring is drawn as two triangles. Each vertex holds the corner of the
+	// square it is in, followed by all the parameters of its ring: position,
+	// radius and width, arc angle, start angle, and dash size, and color.
+	const int VERTEX_SIZE = 13;
+	const GLfloat CORNERS[] = {
+		-1.f, -1.f,
+		-1.f,  1.f,
+		 1.f, -1.f,
+		-1.f,  1.f,
+		 1.f, -1.f,
+		 1.f,  1.f
+	};
+	// The vertices of all the rings added since the last Bind().
+	vector<GLfloat> vertices;
+	
+	// Point the attribute with the given name at the given number of floats,
+	// starting at the given offset into each vertex.
+	void EnableAttribute(const char *name, int size, int offset)
+	{
+		GLint attrib = shader.Attrib(name);
+		glEnableVertexAttribArray(attrib);
+		glVertexAttribPointer(attrib, size, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),
+			reinterpret_cast<const GLvoid *>(offset * sizeof(GLfloat)));
+	}
 }
 
 
@@ -44,33 +63,41 @@ void RingShader::Init()
 	static const char *vertexCode =
 		"// vertex ring shader\n"
 		"uniform vec2 scale;\n"
-		"uniform vec2 position;\n"
-		"uniform float radius;\n"
-		"uniform float width;\n"
 		
 		"in vec2 vert;\n"
+		"in vec2 position;\n"
+		"in vec2 size;\n"
+		"in vec3 arc;\n"
+		"in vec4 color;\n"
 		"out vec2 coord;\n"
+		"flat out vec2 ringSize;\n"
+		"flat out vec3 ringArc;\n"
+		"flat out vec4 ringColor;\n"
 		
 		"void main() {\n"
-		"  coord = (radius + width) * vert;\n"
+		"  ringSize = size;\n"
+		"  ringArc = arc;\n"
+		"  ringColor = color;\n"
+		"  coord = (size.x + size.y) * vert;\n"
 		"  gl_Position = vec4((coord + position) * scale, 0, 1);\n"
 		"}\n";
 
 	static const char *fragmentCode =
 		"// fragment ring shader\n"
-		"uniform vec4 color = vec4(1, 1, 1, 1);\n"
-		"uniform float radius;\n"
-		"uniform float width;\n"
-		"uniform float angle;\n"
-		"uniform float startAngle;\n"
-		"uniform float dash;\n"
 		"const float pi = 3.1415926535897932384626433832795;\n"
 		
 		"in vec2 coord;\n"
+		"flat in vec2 ringSize;\n"
+		"flat in vec3 ringArc;\n"
+		"flat in vec4 ringColor;\n"
 		"out vec4 finalColor;\n"
 		
 		"void main() {\n"
-		"  float arc = mod(atan(coord.x, coord.y) + pi + startAngle, 2 * pi);\n"
+		"  float radius = ringSize.x;\n"
+		"  float width = ringSize.y;\n"
+		"  float angle = ringArc.x;\n"
+		"  float dash = ringArc.z;\n"
+		"  float arc = mod(atan(coord.x, coord.y) + pi + ringArc.y, 2 * pi);\n"
 		"  float arcFalloff = 1 - min(2 * pi - arc, arc - angle) * radius;\n"
 		"  if(dash != 0)\n"
 		"  {\n"
@@ -80,36 +107,24 @@ void RingShader::Init()
 		"  float len = length(coord);\n"
 		"  float lenFalloff = width - abs(len - radius);\n"
 		"  float alpha = clamp(min(arcFalloff, lenFalloff), 0, 1);\n"
-		"  finalColor = color * alpha;\n"
+		"  finalColor = ringColor * alpha;\n"
 		"}\n";
 	
 	shader = Shader(vertexCode, fragmentCode);
 	scaleI = shader.Uniform("scale");
-	positionI = shader.Uniform("position");
-	radiusI = shader.Uniform("radius");
-	widthI = shader.Uniform("width");
-	angleI = shader.Uniform("angle");
-	startAngleI = shader.Uniform("startAngle");
-	dashI = shader.Uniform("dash");
-	colorI = shader.Uniform("color");
-	
-	// Generate the vertex data for drawing sprites.
+	
+	// Generate the buffer for uploading the ring vertex data.
 	glGenVertexArrays(1, &vao);
 	glBindVertexArray(vao);
 	
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	
-	GLfloat vertexData[] = {
-		-1.f, -1.f,
-		-1.f,  1.f,
-		 1.f, -1.f,
-		 1.f,  1.f
-	};
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertexData), vertexData, GL_STATIC_DRAW);
-	
-	glEnableVertexAttribArray(shader.Attrib("vert"));
-	glVertexAttribPointer(shader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	EnableAttribute("vert", 2, 0);
+	EnableAttribute("position", 2, 2);
+	EnableAttribute("size", 2, 4);
+	EnableAttribute("arc", 3, 6);
+	EnableAttribute("color", 4, 9);
 	
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -137,16 +152,13 @@ void RingShader::Draw(const Point &pos, float radius, float width, float fractio
 
 
 
+// Start a batch of rings. Nothing is drawn until Unbind() is called.
 void RingShader::Bind()
 {
 	if(!shader.Object())
 		throw runtime_error("RingShader: Bind() called before Init().");
 	
-	glUseProgram(shader.Object());
-	glBindVertexArray(vao);
-	
-	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
-	glUniform2fv(scaleI, 1, scale);
+	vertices.clear();
 }
 
 
@@ -161,24 +173,43 @@ void RingShader::Add(const Point &pos, float out, float in, const Color &color)
 
 void RingShader::Add(const Point &pos, float radius, float width, float fraction, const Color &color, float dash, float startAngle)
 {
-	GLfloat position[2] = {static_cast<float>(pos.X()), static_cast<float>(pos.Y())};
-	glUniform2fv(positionI, 1, position);
-	
-	glUniform1f(radiusI, radius);
-	glUniform1f(widthI, width);
-	glUniform1f(angleI, fraction * 2. * PI);
-	glUniform1f(startAngleI, startAngle * TO_RAD);
-	glUniform1f(dashI, dash ? 2. * PI / dash : 0.);
-	
-	glUniform4fv(colorI, 1, color.Get());
-	
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	const float *rgba = color.Get();
+	const GLfloat ring[VERTEX_SIZE - 2] = {
+		static_cast<float>(pos.X()), static_cast<float>(pos.Y()),
+		radius, width,
+		static_cast<float>(fraction * 2. * PI),
+		static_cast<float>(startAngle * TO_RAD),
+		static_cast<float>(dash ? 2. * PI / dash : 0.),
+		rgba[0], rgba[1], rgba[2], rgba[3]
+	};
+	for(int i = 0; i < 6; ++i)
+	{
+		vertices.insert(vertices.end(), CORNERS + 2 * i, CORNERS + 2 * i + 2);
+		vertices.insert(vertices.end(), ring, ring + VERTEX_SIZE - 2);
+	}
 }
 
 
 
+// Draw all the rings added since Bind() with a single draw call.
 void RingShader::Unbind()
 {
+	if(vertices.empty())
+		return;
+	
+	glUseProgram(shader.Object());
+	glBindVertexArray(vao);
+	
+	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
+	glUniform2fv(scaleI, 1, scale);
+	
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	
+	glDrawArrays(GL_TRIANGLES, 0, vertices.size() / VERTEX_SIZE);
+	vertices.clear();
+	
 	glBindVertexArray(0);
 	glUseProgram(0);
 }
@@ -19,7 +19,8 @@ class Point;
 
 
 // Class representing a shader that draws round "dots," either filled in or with
-// transparent centers (i.e. circles or rings).
+// transparent centers (i.e. circles or rings). Rings added between Bind() and
+// Unbind() are all drawn at once, when Unbind() is called.
 class RingShader {
 public:
 	static void Init();
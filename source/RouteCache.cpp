@@ -0,0 +1,57 @@
+/* RouteCache.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "RouteCache.h"
+
+#include "GameData.h"
+#include "Planet.h"
+#include "Ship.h"
+
+using namespace std;
+
+
+
+// Get the routes that the given ship would take to reach the destination.
+// The ship's current system does not need to be the same for all users.
+const DistanceMap &RouteCache::Get(const Ship &ship, const System *destination)
+{
+	if(!hasWormholes)
+	{
+		for(const auto &it : GameData::Planets())
+			if(it.second.IsWormhole() && !it.second.IsUnrestricted())
+				restrictedWormholes.push_back(&it.second);
+		hasWormholes = true;
+	}
+	
+	// Use the same fuel values that the DistanceMap will use.
+	int hyperspaceFuel = ship.HyperdriveFuel();
+	int jumpFuel = ship.JumpDriveFuel();
+	Key key(destination, hyperspaceFuel, jumpFuel, ship.JumpRange(), vector<const Planet *>());
+	for(const Planet *wormhole : restrictedWormholes)
+		if(!wormhole->IsAccessible(&ship))
+			get<4>(key).push_back(wormhole);
+	
+	auto it = routes.find(key);
+	if(it == routes.end())
+		it = routes.emplace(move(key), DistanceMap(destination, ship)).first;
+	return it->second;
+}
+
+
+
+// Forget all the routes, e.g. because the galaxy has changed.
+void RouteCache::Clear()
+{
+	routes.clear();
+	restrictedWormholes.clear();
+	hasWormholes = false;
+}
@@ -0,0 +1,56 @@
+/* RouteCache.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef ROUTE_CACHE_H_
+#define ROUTE_CACHE_H_
+
+#include "DistanceMap.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+class Planet;
+class Ship;
+class System;
+
+
+
+// This class keeps track of the routes that NPC ships have planned, so that
+// ships with the same destination and the same drives (e.g. all the ships in
+// a fleet) do not each have to search the map for it. The cache must be
+// cleared whenever the hyperspace links might have changed.
+class RouteCache {
+public:
+	// Get the routes that the given ship would take to reach the destination.
+	// The ship's current system does not need to be the same for all users.
+	const DistanceMap &Get(const Ship &ship, const System *destination);
+	// Forget all the routes, e.g. because the galaxy has changed.
+	void Clear();
+	
+	
+private:
+	// Routes are shared by all ships with the same destination, hyperdrive
+	// fuel, jump drive fuel, jump range, and set of wormholes they cannot use.
+	using Key = std::tuple<const System *, int, int, double, std::vector<const Planet *>>;
+	
+	
+private:
+	std::map<Key, DistanceMap> routes;
+	// The wormholes that only some ships can travel through.
+	std::vector<const Planet *> restrictedWormholes;
+	bool hasWormholes = false;
+};
+
+
+
+#endif
@@ -0,0 +1,188 @@
+/* SaveQueue.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "SaveQueue.h"
+
+#include "Files.h"
+#include "Gzip.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+namespace {
+	// The worker thread and the files it has yet to write. The thread is only
+	// started once something is saved, and is joined when the program exits.
+	class Writer {
+	public:
+		~Writer();
+		
+		void Add(const string &path, string &&data, bool compress);
+		void Finish();
+		vector<string> TakeFailures();
+		
+		// Thread entry point.
+		void operator()();
+		
+	private:
+		class File {
+		public:
+			File(const string &path, string &&data, bool compress);
+			
+			string path;
+			string data;
+			bool compress;
+		};
+		
+	private:
+		queue<File> toWrite;
+		// The number of files that have been queued but not yet written,
+		// including the one that is being written right now.
+		int pending = 0;
+		bool done = false;
+		vector<string> failures;
+		
+		mutex writeMutex;
+		condition_variable writeCondition;
+		condition_variable finishCondition;
+		thread worker;
+	};
+	
+	Writer writer;
+}
+
+
+
+// Queue up the given text to be written to the given path.
+void SaveQueue::Add(const string &path, string &&data, bool compress)
+{
+	writer.Add(path, move(data), compress);
+}
+
+
+
+// Wait until everything that has been queued up is written.
+void SaveQueue::Finish()
+{
+	writer.Finish();
+}
+
+
+
+// Get the paths of any files that could not be written.
+vector<string> SaveQueue::TakeFailures()
+{
+	return writer.TakeFailures();
+}
+
+
+
+namespace {
+	Writer::~Writer()
+	{
+		{
+			lock_guard<mutex> lock(writeMutex);
+			done = true;
+		}
+		writeCondition.notify_all();
+		// The thread writes anything still in the queue before it quits.
+		if(worker.joinable())
+			worker.join();
+	}
+	
+	
+	
+	Writer::File::File(const string &path, string &&data, bool compress)
+		: path(path), data(move(data)), compress(compress)
+	{
+	}
+	
+	
+	
+	void Writer::Add(const string &path, string &&data, bool compress)
+	{
+		{
+			lock_guard<mutex> lock(writeMutex);
+			if(!worker.joinable())
+				worker = thread(ref(*this));
+			toWrite.emplace(path, move(data), compress);
+			++pending;
+		}
+		writeCondition.notify_one();
+	}
+	
+	
+	
+	void Writer::Finish()
+	{
+		unique_lock<mutex> lock(writeMutex);
+		while(pending)
+			finishCondition.wait(lock);
+	}
+	
+	
+	
+	vector<string> Writer::TakeFailures()
+	{
+		lock_guard<mutex> lock(writeMutex);
+		vector<string> result;
+		result.swap(failures);
+		return result;
+	}
+	
+	
+	
+	void Writer::operator()()
+	{
+		unique_lock<mutex> lock(writeMutex);
+		while(true)
+		{
+			if(toWrite.empty())
+			{
+				if(done)
+					return;
+				writeCondition.wait(lock);
+				continue;
+			}
+			
+			File file = move(toWrite.front());
+			toWrite.pop();
+			
+			// Compress and write the file without holding the lock, so the main
+			// thread can keep adding to the queue.
+			lock.unlock();
+			if(file.compress)
+			{
+				// If compression fails for any reason, save the text as it is,
+				// rather than replacing the file with nothing.
+				string compressed = Gzip::Compress(file.data);
+				if(compressed.empty())
+					Files::LogError("Warning: unable to compress \"" + file.path + "\"; saving it uncompressed.");
+				else
+					file.data.swap(compressed);
+			}
+			bool success = Files::WriteAtomic(file.path, file.data);
+			if(!success)
+				Files::LogError("Error: unable to save \"" + file.path + "\".");
+			lock.lock();
+			
+			if(!success)
+				failures.push_back(file.path);
+			--pending;
+			finishCondition.notify_all();
+		}
+	}
+}
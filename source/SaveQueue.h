@@ -0,0 +1,41 @@
+/* SaveQueue.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef SAVE_QUEUE_H_
+#define SAVE_QUEUE_H_
+
+#include <string>
+#include <vector>
+
+
+
+// Class for writing saved games to disk on a background thread, so that saving
+// a large pilot does not make the game stutter. The text of the save is composed
+// on the main thread and handed over here; each file is then compressed if
+// requested and written with Files::WriteAtomic(), in the order they were added.
+class SaveQueue {
+public:
+	// Queue up the given text to be written to the given path. If it should be
+	// compressed, that is done by the writer thread too.
+	static void Add(const std::string &path, std::string &&data, bool compress = false);
+	// Wait until everything that has been queued up is written. This must be
+	// done before reading any saved game that might still be in the queue.
+	static void Finish();
+	
+	// Get the paths of any files that could not be written since the last time
+	// this was called.
+	static std::vector<std::string> TakeFailures();
+};
+
+
+
+#endif
@@ -16,10 +16,135 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "DataNode.h"
 #include "Date.h"
 #include "text/Format.h"
+#include "Gzip.h"
 #include "SpriteSet.h"
 
+#include <algorithm>
+#include <sstream>
+
 using namespace std;
 
+namespace {
+	// Get the first token of a line that is not indented.
+	string FirstToken(const string &data, size_t pos, size_t end)
+	{
+		if(pos < end && (data[pos] == '"' || data[pos] == '`'))
+		{
+			size_t close = data.find(data[pos], pos + 1);
+			return data.substr(pos + 1, min(close, end) - pos - 1);
+		}
+		size_t stop = pos;
+		while(stop < end && data[stop] > ' ')
+			++stop;
+		return data.substr(pos, stop - pos);
+	}
+	
+	// Pick out only the parts of a saved game that are shown in the preview.
+	// All of them are near the start of the file except for the "account"
+	// node, which comes right after the ships; the contents of every ship but
+	// the first are skipped without being parsed, and the file is not read at
+	// all past the end of the account node.
+	class HeaderExtractor {
+	public:
+		// Add the next piece of the file. This returns false once the end of
+		// the header has been reached, so the rest need not be read.
+		bool Add(const char *data, size_t size);
+		// Get the header, after all of it has been added.
+		const string &Header();
+		
+	private:
+		// Handle the line in the given range of the buffered text. This returns
+		// false if the line is past the end of the header.
+		bool AddLine(size_t pos, size_t end);
+		
+	private:
+		// Text that has been added but not handled yet.
+		string buffer;
+		string header;
+		bool keep = false;
+		bool inShip = false;
+		bool hasShip = false;
+		size_t childIndent = 0;
+		bool hasAccount = false;
+		bool isDone = false;
+	};
+	
+	
+	
+	bool HeaderExtractor::Add(const char *data, size_t size)
+	{
+		if(isDone)
+			return false;
+		
+		// Anything left over from the previous piece is the start of a line
+		// that had not ended yet, so it has no newlines in it.
+		size_t end = buffer.size();
+		buffer.append(data, size);
+		size_t start = 0;
+		while((end = buffer.find('\n', end)) != string::npos)
+		{
+			if(!AddLine(start, end))
+			{
+				isDone = true;
+				buffer.clear();
+				return false;
+			}
+			start = end + 1;
+			end = start;
+		}
+		buffer.erase(0, start);
+		return true;
+	}
+	
+	
+	
+	const string &HeaderExtractor::Header()
+	{
+		// The last line of the file may not end in a newline.
+		if(!isDone && !buffer.empty())
+			AddLine(0, buffer.size());
+		buffer.clear();
+		isDone = true;
+		return header;
+	}
+	
+	
+	
+	bool HeaderExtractor::AddLine(size_t pos, size_t end)
+	{
+		const string &data = buffer;
+		bool isIndented = (pos < end && (data[pos] == '\t' || data[pos] == ' '));
+		if(!isIndented && end > pos && data[pos] != '#' && data[pos] != '\r')
+		{
+			if(hasAccount)
+				return false;
+			const string token = FirstToken(data, pos, end);
+			inShip = (token == "ship" && !hasShip);
+			childIndent = 0;
+			keep = inShip || token == "pilot" || token == "date" || token == "system"
+				|| token == "planet" || token == "playtime" || token == "account";
+			hasAccount |= (token == "account");
+		}
+		else if(inShip && isIndented && !hasShip)
+		{
+			// Only the first ship that has a sprite is shown. Only look at
+			// the ship's direct children, which are indented the least.
+			size_t start = data.find_first_not_of(" \t", pos);
+			if(!childIndent || start - pos == childIndent)
+			{
+				childIndent = start - pos;
+				hasShip = (start < end && FirstToken(data, start, end) == "sprite");
+			}
+		}
+		if(keep)
+		{
+			header.append(data, pos, end - pos);
+			header += '\n';
+		}
+		return true;
+	}
+}
+
 
 
 SavedGame::SavedGame(const string &path)
@@ -32,7 +157,13 @@ SavedGame::SavedGame(const string &path)
 void SavedGame::Load(const string &path)
 {
 	Clear();
-	DataFile file(path);
+	HeaderExtractor extractor;
+	Gzip::Read(path, [&extractor](const char *data, size_t size) -> bool
+	{
+		return extractor.Add(data, size);
+	});
+	istringstream in(extractor.Header());
+	DataFile file(in);
 	if(file.begin() != file.end())
 		this->path = path;
 	
@@ -57,14 +188,14 @@ void SavedGame::Load(const string &path)
 					break;
 				}
 		}
-		else if(node.Token(0) == "ship" && !shipSprite)
+		else if(node.Token(0) == "ship" && shipSprite.empty())
 		{
 			for(const DataNode &child : node)
 			{
 				if(child.Token(0) == "name" && child.Size() >= 2)
 					shipName = child.Token(1);
 				else if(child.Token(0) == "sprite" && child.Size() >= 2)
-					shipSprite = SpriteSet::Get(child.Token(1));
+					shipSprite = child.Token(1);
 			}
 		}
 	}
@@ -98,7 +229,7 @@ void SavedGame::Clear()
 	planet.clear();
 	playTime = "0s";
 	
-	shipSprite = nullptr;
+	shipSprite.clear();
 	shipName.clear();
 }
 
@@ -146,9 +277,11 @@ const string &SavedGame::GetPlayTime() const
 
 
 
+// The sprite is looked up here rather than in Load(), because the SpriteSet
+// may only be used on the main thread.
 const Sprite *SavedGame::ShipSprite() const
 {
-	return shipSprite;
+	return shipSprite.empty() ? nullptr : SpriteSet::Get(shipSprite);
 }
 
 
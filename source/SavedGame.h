@@ -23,7 +23,9 @@ class Sprite;
 // information necessary from the file to display it in the "Load Game" panel,
 // without doing all the complicated parsing that PlayerInfo does. This is so
 // that we only need to have one PlayerInfo instance, and there does not need
-// to be logic for copying one PlayerInfo into another.
+// to be logic for copying one PlayerInfo into another. The rest of the file is
+// skipped over without being parsed at all, and nothing here touches any global
+// state, so saved games can be read on a background thread.
 class SavedGame {
 public:
 	SavedGame() = default;
@@ -57,7 +59,7 @@ private:
 	std::string planet;
 	std::string playTime;
 	
-	const Sprite *shipSprite = nullptr;
+	std::string shipSprite;
 	std::string shipName;
 };
 
@@ -13,26 +13,38 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef SET_H_
 #define SET_H_
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 
 
 // Template representing a set of named objects of a given type, where you can
 // query it for a pointer to any object and it will return one, whether or not that
 // object has been loaded yet. (This allows cyclic pointers.)
+// The objects are stored in a map, so pointers to them remain valid and
+// iteration is in sorted order, but lookups by name go through an
+// open-addressing hash index.
 template<class Type>
 class Set {
 public:
+	Set() = default;
+	Set(const Set &other);
+	Set(Set &&other) = default;
+	Set &operator=(const Set &other);
+	Set &operator=(Set &&other) = default;
+	
 	// Allow non-const access to the owner of this set; it can hand off only
 	// const references to avoid anyone else modifying the objects.
-	Type *Get(const std::string &name) { return &data[name]; }
-	const Type *Get(const std::string &name) const { return &data[name]; }
+	Type *Get(const std::string &name) { return &Insert(name)->second; }
+	const Type *Get(const std::string &name) const { return &Insert(name)->second; }
 	// If an item already exists in this set, get it. Otherwise, return a null
 	// pointer rather than creating the item.
 	const Type *Find(const std::string &name) const;
 	
-	bool Has(const std::string &name) const { return data.count(name); }
+	bool Has(const std::string &name) const { return Index(name) >= 0; }
 	
 	typename std::map<std::string, Type>::iterator begin() { return data.begin(); }
 	typename std::map<std::string, Type>::const_iterator begin() const { return data.begin(); }
@@ -45,17 +57,80 @@ public:
 	void Revert(const Set<Type> &other);
 	
 	
+private:
+	using Iterator = typename std::map<std::string, Type>::iterator;
+	// A slot in the hash index. The full hash is cached so that most probes
+	// that do not match can be rejected without comparing strings.
+	struct Slot {
+		size_t hash = 0;
+		int index = -1;
+	};
+	
+	
+private:
+	// Get the position in the list of entries of the item with the given name,
+	// or -1 if it does not exist.
+	int Index(const std::string &name) const;
+	// Find the item with the given name, creating it if necessary.
+	Iterator Insert(const std::string &name) const;
+	// Find the slot that holds the given name, or the empty slot where it
+	// should be inserted.
+	Slot &Probe(const std::string &name, size_t hash) const;
+	// Recreate the list of entries and the hash index from the map.
+	void Reindex();
+	// Double the size of the hash index.
+	void Grow() const;
+	
+	
 private:
 	mutable std::map<std::string, Type> data;
+	// The map entries, in the order they were added. The hash index refers to
+	// entries by their position in this list.
+	mutable std::vector<Iterator> entries;
+	// Open-addressing hash index into the entries. Its size is always zero or
+	// a power of two, and it is kept at most half full.
+	mutable std::vector<Slot> slots;
 };
 
 
 
+template <class Type>
+Set<Type>::Set(const Set &other)
+	: data(other.data)
+{
+	Reindex();
+}
+
+
+
+template <class Type>
+Set<Type> &Set<Type>::operator=(const Set &other)
+{
+	if(this != &other)
+	{
+		data = other.data;
+		Reindex();
+	}
+	return *this;
+}
+
+
+
 template <class Type>
 const Type *Set<Type>::Find(const std::string &name) const
 {
-	auto it = data.find(name);
-	return (it == data.end() ? nullptr : &it->second);
+	int index = Index(name);
+	return (index < 0 ? nullptr : &entries[index]->second);
+}
+
+
+
+template <class Type>
+int Set<Type>::Index(const std::string &name) const
+{
+	if(slots.empty())
+		return -1;
+	return Probe(name, std::hash<std::string>()(name)).index;
 }
 
 
@@ -82,6 +157,86 @@ void Set<Type>::Revert(const Set<Type> &other)
 		// There should never be a case when an entry in the set we are
 		// reverting to has a name that is not also in this set.
 	}
+	// Some entries may have been erased, so the index must be rebuilt.
+	Reindex();
+}
+
+
+
+template <class Type>
+typename Set<Type>::Iterator Set<Type>::Insert(const std::string &name) const
+{
+	size_t hash = std::hash<std::string>()(name);
+	if(!slots.empty())
+	{
+		const Slot &slot = Probe(name, hash);
+		if(slot.index >= 0)
+			return entries[slot.index];
+	}
+	
+	// This is a new name. Keep the index at most half full.
+	if(2 * (entries.size() + 1) > slots.size())
+		Grow();
+	Slot &slot = Probe(name, hash);
+	slot.hash = hash;
+	slot.index = entries.size();
+	entries.push_back(data.emplace(name, Type()).first);
+	return entries.back();
+}
+
+
+
+template <class Type>
+typename Set<Type>::Slot &Set<Type>::Probe(const std::string &name, size_t hash) const
+{
+	const size_t mask = slots.size() - 1;
+	for(size_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		Slot &slot = slots[i];
+		if(slot.index < 0 || (slot.hash == hash && entries[slot.index]->first == name))
+			return slot;
+	}
+}
+
+
+
+template <class Type>
+void Set<Type>::Reindex()
+{
+	entries.clear();
+	slots.clear();
+	for(auto it = data.begin(); it != data.end(); ++it)
+		entries.push_back(it);
+	
+	size_t capacity = 16;
+	while(capacity < 2 * entries.size())
+		capacity *= 2;
+	slots.resize(capacity);
+	for(size_t i = 0; i < entries.size(); ++i)
+	{
+		size_t hash = std::hash<std::string>()(entries[i]->first);
+		Slot &slot = Probe(entries[i]->first, hash);
+		slot.hash = hash;
+		slot.index = i;
+	}
+}
+
+
+
+template <class Type>
+void Set<Type>::Grow() const
+{
+	std::vector<Slot> old(slots.size() ? 2 * slots.size() : 16);
+	old.swap(slots);
+	const size_t mask = slots.size() - 1;
+	for(const Slot &it : old)
+		if(it.index >= 0)
+		{
+			size_t i = it.hash & mask;
+			while(slots[i].index >= 0)
+				i = (i + 1) & mask;
+			slots[i] = it;
+		}
 }
 
 
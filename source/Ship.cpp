@@ -40,6 +40,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <sstream>
 
@@ -58,6 +59,16 @@ namespace {
 	
 	const double SCAN_TIME = 60.;
 	
+	// Hyperspace travel takes this many steps, during which the ship
+	// accelerates (or decelerates) at this rate. A ship arriving by hyperdrive
+	// starts decelerating this far beyond the distance needed to stop.
+	const int HYPER_C = 100;
+	const double HYPER_A = 2.;
+	const double HYPER_D = 1000.;
+	
+	// Whether DoGeneration() should verify each ship's cached stats.
+	bool checkDerivedStats = false;
+	
 	// Helper function to transfer energy to a given stat if it is less than the
 	// given maximum value.
 	void DoRepair(double &stat, double &available, double maximum)
@@ -154,6 +165,13 @@ const set<string> Ship::BAY_TYPES = {
 
 
 
+void Ship::SetCheckDerivedStats(bool check)
+{
+	checkDerivedStats = check;
+}
+
+
+
 // Construct and Load() at the same time.
 Ship::Ship(const DataNode &node)
 {
@@ -713,6 +731,7 @@ void Ship::FinishLoading(bool isNewInstance)
 		warning += "Defaulting " + string(attributes.Get("drag") ? "invalid" : "missing") + " \"drag\" attribute to 100.0\n";
 		attributes.Set("drag", 100.);
 	}
+	UpdateDerivedStats();
 	if(!warning.empty())
 	{
 		// This check is mostly useful for variants and stock ships, which have
@@ -1249,6 +1268,20 @@ bool Ship::HasDeployOrder() const
 
 
 
+int Ship::AISlot() const
+{
+	return aiSlot;
+}
+
+
+
+void Ship::SetAISlot(int slot)
+{
+	aiSlot = slot;
+}
+
+
+
 void Ship::SetDeployOrder(bool shouldDeploy)
 {
 	this->shouldDeploy = shouldDeploy;
@@ -1321,6 +1354,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	// long that it should be "forgotten." Also eliminate ships that have no
 	// system set because they just entered a fighter bay.
 	forget += !isInSystem;
+	pendingMove = PendingMove::NONE;
 	isThrusting = false;
 	isReversing = false;
 	isSteering = false;
@@ -1331,7 +1365,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		return;
 	}
 	isInSystem = false;
-	if(!fuel || !(attributes.Get("hyperdrive") || attributes.Get("jump drive")))
+	if(!fuel || !(stats.hyperdrive || stats.jumpDrive))
 		hyperspaceSystem = nullptr;
 	
 	// Adjust the error in the pilot's targeting.
@@ -1367,16 +1401,16 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		if(!cloak)
 			cloakDisruption = max(0., cloakDisruption - 1.);
 		
-		double cloakingSpeed = attributes.Get("cloak");
+		double cloakingSpeed = stats.cloak;
 		bool canCloak = (!isDisabled && cloakingSpeed > 0. && !cloakDisruption
-			&& fuel >= attributes.Get("cloaking fuel")
-			&& energy >= attributes.Get("cloaking energy"));
+			&& fuel >= stats.cloakingFuel
+			&& energy >= stats.cloakingEnergy);
 		if(commands.Has(Command::CLOAK) && canCloak)
 		{
 			cloak = min(1., cloak + cloakingSpeed);
-			fuel -= attributes.Get("cloaking fuel");
-			energy -= attributes.Get("cloaking energy");
-			heat += attributes.Get("cloaking heat");
+			fuel -= stats.cloakingFuel;
+			energy -= stats.cloakingEnergy;
+			heat += stats.cloakingHeat;
 		}
 		else if(cloakingSpeed)
 		{
@@ -1493,9 +1527,6 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		// Enter hyperspace.
 		int direction = hyperspaceSystem ? 1 : -1;
 		hyperspaceCount += direction;
-		static const int HYPER_C = 100;
-		static const double HYPER_A = 2.;
-		static const double HYPER_D = 1000.;
 		if(hyperspaceSystem)
 			fuel -= hyperspaceFuelCost / HYPER_C;
 		
@@ -1516,104 +1547,9 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			}
 		}
 		
-		if(hyperspaceCount == HYPER_C)
-		{
-			currentSystem = hyperspaceSystem;
-			hyperspaceSystem = nullptr;
-			targetSystem = nullptr;
-			// Check if the target planet is in the destination system or not.
-			const Planet *planet = (targetPlanet ? targetPlanet->GetPlanet() : nullptr);
-			if(!planet || planet->IsWormhole() || !planet->IsInSystem(currentSystem))
-				targetPlanet = nullptr;
-			// Check if your parent has a target planet in this system.
-			shared_ptr<Ship> parent = GetParent();
-			if(!targetPlanet && parent && parent->targetPlanet)
-			{
-				planet = parent->targetPlanet->GetPlanet();
-				if(planet && !planet->IsWormhole() && planet->IsInSystem(currentSystem))
-					targetPlanet = parent->targetPlanet;
-			}
-			direction = -1;
-			
-			// If you have a target planet in the destination system, exit
-			// hyperpace aimed at it. Otherwise, target the first planet that
-			// has a spaceport.
-			Point target;
-			// Except when you arrive at an extra distance from the target,
-			// in that case always use the system-center as target.
-			double extraArrivalDistance = isUsingJumpDrive ? currentSystem->ExtraJumpArrivalDistance() : currentSystem->ExtraHyperArrivalDistance();
-			
-			if(extraArrivalDistance == 0)
-			{
-				if(targetPlanet)
-					target = targetPlanet->Position();
-				else
-				{
-					for(const StellarObject &object : currentSystem->Objects())
-						if(object.HasSprite() && object.HasValidPlanet()
-								&& object.GetPlanet()->HasSpaceport())
-						{
-							target = object.Position();
-							break;
-						}
-				}
-			}
-			
-			if(isUsingJumpDrive)
-			{
-				position = target + Angle::Random().Unit() * (300. * (Random::Real() + 1.) + extraArrivalDistance);
-				return;
-			}
-			
-			// Have all ships exit hyperspace at the same distance so that
-			// your escorts always stay with you.
-			double distance = (HYPER_C * HYPER_C) * .5 * HYPER_A + HYPER_D;
-			distance += extraArrivalDistance;
-			position = (target - distance * angle.Unit());
-			position += hyperspaceOffset;
-			// Make sure your velocity is in exactly the direction you are
-			// traveling in, so that when you decelerate there will not be a
-			// sudden shift in direction at the end.
-			velocity = velocity.Length() * angle.Unit();
-		}
-		if(!isUsingJumpDrive)
-		{
-			velocity += (HYPER_A * direction) * angle.Unit();
-			if(!hyperspaceSystem)
-			{
-				// Exit hyperspace far enough from the planet to be able to land.
-				// This does not take drag into account, so it is always an over-
-				// estimate of how long it will take to stop.
-				// We start decelerating after rotating about 150 degrees (that
-				// is, about acos(.8) from the proper angle). So:
-				// Stopping distance = .5*a*(v/a)^2 + (150/turn)*v.
-				// Exit distance = HYPER_D + .25 * v^2 = stopping distance.
-				double exitV = max(HYPER_A, MaxVelocity());
-				double a = (.5 / Acceleration() - .25);
-				double b = 150. / TurnRate();
-				double discriminant = b * b - 4. * a * -HYPER_D;
-				if(discriminant > 0.)
-				{
-					double altV = (-b + sqrt(discriminant)) / (2. * a);
-					if(altV > 0. && altV < exitV)
-						exitV = altV;
-				}
-				if(velocity.Length() <= exitV)
-				{
-					velocity = angle.Unit() * exitV;
-					hyperspaceCount = 0;
-				}
-			}
-		}
-		position += velocity;
-		if(GetParent() && GetParent()->currentSystem == currentSystem)
-		{
-			hyperspaceOffset = position - GetParent()->position;
-			double length = hyperspaceOffset.Length();
-			if(length > 1000.)
-				hyperspaceOffset *= 1000. / length;
-		}
-		
+		// Exiting hyperspace depends on where this ship's parent is, so it is
+		// left for FinishMove().
+		pendingMove = PendingMove::HYPERSPACE;
 		return;
 	}
 	else if(landingPlanet || zoom < 1.f)
@@ -1658,7 +1594,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			}
 		}
 		// Only refuel if this planet has a spaceport.
-		else if(fuel >= attributes.Get("fuel capacity")
+		else if(fuel >= stats.fuelCapacity
 				|| !landingPlanet || !landingPlanet->HasSpaceport())
 		{
 			zoom = min(1.f, zoom + .02f);
@@ -1666,7 +1602,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			landingPlanet = nullptr;
 		}
 		else
-			fuel = min(fuel + 1., attributes.Get("fuel capacity"));
+			fuel = min(fuel + 1., stats.fuelCapacity);
 		
 		// Move the ship at the velocity it had when it began landing, but
 		// scaled based on how small it is now.
@@ -1684,7 +1620,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	else if(commands.Has(Command::JUMP) && IsReadyToJump())
 	{
 		hyperspaceSystem = GetTargetSystem();
-		isUsingJumpDrive = !attributes.Get("hyperdrive") || !currentSystem->Links().count(hyperspaceSystem);
+		isUsingJumpDrive = !stats.hyperdrive || !currentSystem->Links().count(hyperspaceSystem);
 		hyperspaceFuelCost = JumpFuel(hyperspaceSystem);
 	}
 	
@@ -1710,15 +1646,15 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	// This ship is not landing or entering hyperspace. So, move it. If it is
 	// disabled, all it can do is slow down to a stop.
 	double mass = Mass();
-	bool isUsingAfterburner = false;
+	isUsingAfterburner = false;
 	if(isDisabled)
-		velocity *= 1. - attributes.Get("drag") / mass;
+		velocity *= 1. - stats.drag / mass;
 	else if(!pilotError)
 	{
 		if(commands.Turn())
 		{
 			// Check if we are able to turn.
-			double cost = attributes.Get("turning energy");
+			double cost = stats.turningEnergy;
 			if(energy < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * energy / (cost * fabs(commands.Turn())));
 			
@@ -1731,7 +1667,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// of the turning energy and produce a fraction of the heat.
 				double scale = fabs(commands.Turn());
 				energy -= scale * cost;
-				heat += scale * attributes.Get("turning heat");
+				heat += scale * stats.turningHeat;
 				angle += commands.Turn() * TurnRate() * slowMultiplier;
 			}
 		}
@@ -1740,8 +1676,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		if(thrustCommand)
 		{
 			// Check if we are able to apply this thrust.
-			double cost = attributes.Get((thrustCommand > 0.) ?
-				"thrusting energy" : "reverse thrusting energy");
+			double cost = (thrustCommand > 0.) ? stats.thrustingEnergy : stats.reverseThrustingEnergy;
 			if(energy < cost)
 				thrustCommand *= energy / cost;
 			
@@ -1750,13 +1685,13 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// If a reverse thrust is commanded and the capability does not
 				// exist, ignore it (do not even slow under drag).
 				isThrusting = (thrustCommand > 0.);
-				isReversing = !isThrusting && attributes.Get("reverse thrust");
-				thrust = attributes.Get(isThrusting ? "thrust" : "reverse thrust");
+				isReversing = !isThrusting && stats.reverseThrust;
+				thrust = isThrusting ? stats.thrust : stats.reverseThrust;
 				if(thrust)
 				{
 					double scale = fabs(thrustCommand);
 					energy -= scale * cost;
-					heat += scale * attributes.Get(isThrusting ? "thrusting heat" : "reverse thrusting heat");
+					heat += scale * (isThrusting ? stats.thrustingHeat : stats.reverseThrustingHeat);
 					acceleration += angle.Unit() * (thrustCommand * thrust / mass);
 				}
 			}
@@ -1765,12 +1700,12 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				&& !CannotAct();
 		if(applyAfterburner)
 		{
-			thrust = attributes.Get("afterburner thrust");
-			double fuelCost = attributes.Get("afterburner fuel");
-			double energyCost = attributes.Get("afterburner energy");
+			thrust = stats.afterburnerThrust;
+			double fuelCost = stats.afterburnerFuel;
+			double energyCost = stats.afterburnerEnergy;
 			if(thrust && fuel >= fuelCost && energy >= energyCost)
 			{
-				heat += attributes.Get("afterburner heat");
+				heat += stats.afterburnerHeat;
 				fuel -= fuelCost;
 				energy -= energyCost;
 				acceleration += angle.Unit() * thrust / mass;
@@ -1783,7 +1718,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	if(acceleration)
 	{
 		acceleration *= slowMultiplier;
-		Point dragAcceleration = acceleration - velocity * (attributes.Get("drag") / mass);
+		Point dragAcceleration = acceleration - velocity * (stats.drag / mass);
 		// Make sure dragAcceleration has nonzero length, to avoid divide by zero.
 		if(dragAcceleration)
 		{
@@ -1812,89 +1747,206 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		acceleration = Point();
 	}
 	
-	// Boarding:
-	shared_ptr<const Ship> target = GetTargetShip();
-	// If this is a fighter or drone and it is not assisting someone at the
-	// moment, its boarding target should be its parent ship.
-	if(CanBeCarried() && !(target && target == GetShipToAssist()))
-		target = GetParent();
-	if(target && !isDisabled)
-	{
-		Point dp = (target->position - position);
-		double distance = dp.Length();
-		Point dv = (target->velocity - velocity);
-		double speed = dv.Length();
-		isBoarding = (distance < 50. && speed < 1. && commands.Has(Command::BOARD));
-		if(isBoarding && !CanBeCarried())
-		{
-			if(!target->IsDisabled() && government->IsEnemy(target->government))
-				isBoarding = false;
-			else if(target->IsDestroyed() || target->IsLanding() || target->IsHyperspacing()
-					|| target->GetSystem() != GetSystem())
-				isBoarding = false;
-		}
-		if(isBoarding && !pilotError)
-		{
-			Angle facing = angle;
-			bool left = target->Unit().Cross(facing.Unit()) < 0.;
-			double turn = left - !left;
+	// Approaching a boarding target and the final movement are left for
+	// FinishMove(), because they depend on where the target is.
+	pendingMove = PendingMove::FLIGHT;
+}
+
+
+
+// Finish moving this ship, after Move() has been called for all ships.
+void Ship::FinishMove(vector<Visual> &visuals)
+{
+	PendingMove pending = pendingMove;
+	pendingMove = PendingMove::NONE;
+	
+	if(pending == PendingMove::HYPERSPACE)
+	{
+		int direction = hyperspaceSystem ? 1 : -1;
+		if(hyperspaceCount == HYPER_C)
+		{
+			currentSystem = hyperspaceSystem;
+			hyperspaceSystem = nullptr;
+			targetSystem = nullptr;
+			// Check if the target planet is in the destination system or not.
+			const Planet *planet = (targetPlanet ? targetPlanet->GetPlanet() : nullptr);
+			if(!planet || planet->IsWormhole() || !planet->IsInSystem(currentSystem))
+				targetPlanet = nullptr;
+			// Check if your parent has a target planet in this system.
+			shared_ptr<Ship> parent = GetParent();
+			if(!targetPlanet && parent && parent->targetPlanet)
+			{
+				planet = parent->targetPlanet->GetPlanet();
+				if(planet && !planet->IsWormhole() && planet->IsInSystem(currentSystem))
+					targetPlanet = parent->targetPlanet;
+			}
+			direction = -1;
 			
-			// Check if the ship will still be pointing to the same side of the target
-			// angle if it turns by this amount.
-			facing += TurnRate() * turn;
-			bool stillLeft = target->Unit().Cross(facing.Unit()) < 0.;
-			if(left != stillLeft)
-				turn = 0.;
-			angle += TurnRate() * turn;
+			// If you have a target planet in the destination system, exit
+			// hyperpace aimed at it. Otherwise, target the first planet that
+			// has a spaceport.
+			Point target;
+			// Except when you arrive at an extra distance from the target,
+			// in that case always use the system-center as target.
+			double extraArrivalDistance = isUsingJumpDrive ? currentSystem->ExtraJumpArrivalDistance() : currentSystem->ExtraHyperArrivalDistance();
 			
-			velocity += dv.Unit() * .1;
-			position += dp.Unit() * .5;
+			if(extraArrivalDistance == 0)
+			{
+				if(targetPlanet)
+					target = targetPlanet->Position();
+				else
+				{
+					for(const StellarObject &object : currentSystem->Objects())
+						if(object.HasSprite() && object.HasValidPlanet()
+								&& object.GetPlanet()->HasSpaceport())
+						{
+							target = object.Position();
+							break;
+						}
+				}
+			}
 			
-			if(distance < 10. && speed < 1. && (CanBeCarried() || !turn))
+			if(isUsingJumpDrive)
 			{
-				if(cloak)
+				position = target + Angle::Random().Unit() * (300. * (Random::Real() + 1.) + extraArrivalDistance);
+				return;
+			}
+			
+			// Have all ships exit hyperspace at the same distance so that
+			// your escorts always stay with you.
+			double distance = (HYPER_C * HYPER_C) * .5 * HYPER_A + HYPER_D;
+			distance += extraArrivalDistance;
+			position = (target - distance * angle.Unit());
+			position += hyperspaceOffset;
+			// Make sure your velocity is in exactly the direction you are
+			// traveling in, so that when you decelerate there will not be a
+			// sudden shift in direction at the end.
+			velocity = velocity.Length() * angle.Unit();
+		}
+		if(!isUsingJumpDrive)
+		{
+			velocity += (HYPER_A * direction) * angle.Unit();
+			if(!hyperspaceSystem)
+			{
+				// Exit hyperspace far enough from the planet to be able to land.
+				// This does not take drag into account, so it is always an over-
+				// estimate of how long it will take to stop.
+				// We start decelerating after rotating about 150 degrees (that
+				// is, about acos(.8) from the proper angle). So:
+				// Stopping distance = .5*a*(v/a)^2 + (150/turn)*v.
+				// Exit distance = HYPER_D + .25 * v^2 = stopping distance.
+				double exitV = max(HYPER_A, MaxVelocity());
+				double a = (.5 / Acceleration() - .25);
+				double b = 150. / TurnRate();
+				double discriminant = b * b - 4. * a * -HYPER_D;
+				if(discriminant > 0.)
 				{
-					// Allow the player to get all the way to the end of the
-					// boarding sequence (including locking on to the ship) but
-					// not to actually board, if they are cloaked.
-					if(isYours)
-						Messages::Add("You cannot board a ship while cloaked.");
+					double altV = (-b + sqrt(discriminant)) / (2. * a);
+					if(altV > 0. && altV < exitV)
+						exitV = altV;
 				}
-				else
+				if(velocity.Length() <= exitV)
 				{
+					velocity = angle.Unit() * exitV;
+					hyperspaceCount = 0;
+				}
+			}
+		}
+		position += velocity;
+		if(GetParent() && GetParent()->currentSystem == currentSystem)
+		{
+			hyperspaceOffset = position - GetParent()->position;
+			double length = hyperspaceOffset.Length();
+			if(length > 1000.)
+				hyperspaceOffset *= 1000. / length;
+		}
+	}
+	else if(pending == PendingMove::FLIGHT)
+	{
+		// Boarding:
+		shared_ptr<const Ship> target = GetTargetShip();
+		// If this is a fighter or drone and it is not assisting someone at the
+		// moment, its boarding target should be its parent ship.
+		if(CanBeCarried() && !(target && target == GetShipToAssist()))
+			target = GetParent();
+		if(target && !isDisabled)
+		{
+			Point dp = (target->position - position);
+			double distance = dp.Length();
+			Point dv = (target->velocity - velocity);
+			double speed = dv.Length();
+			isBoarding = (distance < 50. && speed < 1. && commands.Has(Command::BOARD));
+			if(isBoarding && !CanBeCarried())
+			{
+				if(!target->IsDisabled() && government->IsEnemy(target->government))
+					isBoarding = false;
+				else if(target->IsDestroyed() || target->IsLanding() || target->IsHyperspacing()
+						|| target->GetSystem() != GetSystem())
 					isBoarding = false;
-					bool isEnemy = government->IsEnemy(target->government);
-					if(isEnemy && Random::Real() < target->Attributes().Get("self destruct"))
+			}
+			if(isBoarding && !pilotError)
+			{
+				Angle facing = angle;
+				bool left = target->Unit().Cross(facing.Unit()) < 0.;
+				double turn = left - !left;
+				
+				// Check if the ship will still be pointing to the same side of the target
+				// angle if it turns by this amount.
+				facing += TurnRate() * turn;
+				bool stillLeft = target->Unit().Cross(facing.Unit()) < 0.;
+				if(left != stillLeft)
+					turn = 0.;
+				angle += TurnRate() * turn;
+				
+				velocity += dv.Unit() * .1;
+				position += dp.Unit() * .5;
+				
+				if(distance < 10. && speed < 1. && (CanBeCarried() || !turn))
+				{
+					if(cloak)
 					{
-						Messages::Add("The " + target->ModelName() + " \"" + target->Name()
-							+ "\" has activated its self-destruct mechanism.");
-						GetTargetShip()->SelfDestruct();
+						// Allow the player to get all the way to the end of the
+						// boarding sequence (including locking on to the ship) but
+						// not to actually board, if they are cloaked.
+						if(isYours)
+							Messages::Add("You cannot board a ship while cloaked.");
 					}
 					else
-						hasBoarded = true;
+					{
+						isBoarding = false;
+						bool isEnemy = government->IsEnemy(target->government);
+						if(isEnemy && Random::Real() < target->Attributes().Get("self destruct"))
+						{
+							Messages::Add("The " + target->ModelName() + " \"" + target->Name()
+								+ "\" has activated its self-destruct mechanism.");
+							GetTargetShip()->SelfDestruct();
+						}
+						else
+							hasBoarded = true;
+					}
 				}
 			}
 		}
+		
+		// Clear your target if it is destroyed. This is only important for NPCs,
+		// because ordinary ships cease to exist once they are destroyed.
+		target = GetTargetShip();
+		if(target && target->IsDestroyed() && target->explosionCount >= target->explosionTotal)
+			targetShip.reset();
+		
+		// Finally, move the ship and create any movement visuals.
+		position += velocity;
+		if(isUsingAfterburner && !Attributes().AfterburnerEffects().empty())
+			for(const EnginePoint &point : enginePoints)
+			{
+				Point pos = angle.Rotate(point) * Zoom() + position;
+				// Stream the afterburner effects outward in the direction the engines are facing.
+				Point effectVelocity = velocity - 6. * angle.Unit();
+				for(auto &&it : Attributes().AfterburnerEffects())
+					for(int i = 0; i < it.second; ++i)
+						visuals.emplace_back(*it.first, pos, effectVelocity, angle);
+			}
 	}
-	
-	// Clear your target if it is destroyed. This is only important for NPCs,
-	// because ordinary ships cease to exist once they are destroyed.
-	target = GetTargetShip();
-	if(target && target->IsDestroyed() && target->explosionCount >= target->explosionTotal)
-		targetShip.reset();
-	
-	// Finally, move the ship and create any movement visuals.
-	position += velocity;
-	if(isUsingAfterburner && !Attributes().AfterburnerEffects().empty())
-		for(const EnginePoint &point : enginePoints)
-		{
-			Point pos = angle.Rotate(point) * Zoom() + position;
-			// Stream the afterburner effects outward in the direction the engines are facing.
-			Point effectVelocity = velocity - 6. * angle.Unit();
-			for(auto &&it : Attributes().AfterburnerEffects())
-				for(int i = 0; i < it.second; ++i)
-					visuals.emplace_back(*it.first, pos, effectVelocity, angle);
-		}
 }
 
 
@@ -1902,6 +1954,9 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 // Generate energy, heat, etc. (This is called by Move().)
 void Ship::DoGeneration()
 {
+	if(checkDerivedStats)
+		CheckDerivedStats();
+	
 	// First, allow any carried ships to do their own generation.
 	for(const Bay &bay : bays)
 		if(bay.ship)
@@ -1918,21 +1973,19 @@ void Ship::DoGeneration()
 		// 4. Shields of carried fighters
 		// 5. Transfer of excess energy and fuel to carried fighters.
 		
-		const double hullAvailable = attributes.Get("hull repair rate") * (1. + attributes.Get("hull repair multiplier"));
-		const double hullEnergy = (attributes.Get("hull energy") * (1. + attributes.Get("hull energy multiplier"))) / hullAvailable;
-		const double hullFuel = (attributes.Get("hull fuel") * (1. + attributes.Get("hull fuel multiplier"))) / hullAvailable;
-		const double hullHeat = (attributes.Get("hull heat") * (1. + attributes.Get("hull heat multiplier"))) / hullAvailable;
-		double hullRemaining = hullAvailable;
+		const double hullEnergy = stats.hullEnergy;
+		const double hullFuel = stats.hullFuel;
+		const double hullHeat = stats.hullHeat;
+		double hullRemaining = stats.hullAvailable;
 		if(!hullDelay)
-			DoRepair(hull, hullRemaining, attributes.Get("hull"), energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
+			DoRepair(hull, hullRemaining, stats.hull, energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
 		
-		const double shieldsAvailable = attributes.Get("shield generation") * (1. + attributes.Get("shield generation multiplier"));
-		const double shieldsEnergy = (attributes.Get("shield energy") * (1. + attributes.Get("shield energy multiplier"))) / shieldsAvailable;
-		const double shieldsFuel = (attributes.Get("shield fuel") * (1. + attributes.Get("shield fuel multiplier"))) / shieldsAvailable;
-		const double shieldsHeat = (attributes.Get("shield heat") * (1. + attributes.Get("shield heat multiplier"))) / shieldsAvailable;
-		double shieldsRemaining = shieldsAvailable;
+		const double shieldsEnergy = stats.shieldsEnergy;
+		const double shieldsFuel = stats.shieldsFuel;
+		const double shieldsHeat = stats.shieldsHeat;
+		double shieldsRemaining = stats.shieldsAvailable;
 		if(!shieldDelay)
-			DoRepair(shields, shieldsRemaining, attributes.Get("shields"), energy, shieldsEnergy, fuel, shieldsFuel, heat, shieldsHeat);
+			DoRepair(shields, shieldsRemaining, stats.shields, energy, shieldsEnergy, fuel, shieldsFuel, heat, shieldsHeat);
 		
 		if(!bays.empty())
 		{
@@ -1956,20 +2009,20 @@ void Ship::DoGeneration()
 			{
 				Ship &ship = *it.second;
 				if(!hullDelay)
-					DoRepair(ship.hull, hullRemaining, ship.attributes.Get("hull"), energy, hullEnergy, heat, hullHeat, fuel, hullFuel);
+					DoRepair(ship.hull, hullRemaining, ship.stats.hull, energy, hullEnergy, heat, hullHeat, fuel, hullFuel);
 				if(!shieldDelay)
-					DoRepair(ship.shields, shieldsRemaining, ship.attributes.Get("shields"), energy, shieldsEnergy, heat, shieldsHeat, fuel, shieldsFuel);
+					DoRepair(ship.shields, shieldsRemaining, ship.stats.shields, energy, shieldsEnergy, heat, shieldsHeat, fuel, shieldsFuel);
 			}
 			
 			// Now that there is no more need to use energy for hull and shield
 			// repair, if there is still excess energy, transfer it.
-			double energyRemaining = min(0., energy - attributes.Get("energy capacity"));
-			double fuelRemaining = min(0., fuel - attributes.Get("fuel capacity"));
+			double energyRemaining = min(0., energy - stats.energyCapacity);
+			double fuelRemaining = min(0., fuel - stats.fuelCapacity);
 			for(const pair<double, Ship *> &it : carried)
 			{
 				Ship &ship = *it.second;
-				DoRepair(ship.energy, energyRemaining, ship.attributes.Get("energy capacity"));
-				DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get("fuel capacity"));
+				DoRepair(ship.energy, energyRemaining, ship.stats.energyCapacity);
+				DoRepair(ship.fuel, fuelRemaining, ship.stats.fuelCapacity);
 			}
 		}
 		// Decrease the shield and hull delays by 1 now that shield generation
@@ -1982,28 +2035,28 @@ void Ship::DoGeneration()
 	// TODO: Mothership gives status resistance to carried ships?
 	if(ionization)
 	{
-		double ionResistance = attributes.Get("ion resistance");
-		double ionEnergy = attributes.Get("ion resistance energy") / ionResistance;
-		double ionFuel = attributes.Get("ion resistance fuel") / ionResistance;
-		double ionHeat = attributes.Get("ion resistance heat") / ionResistance;
+		double ionResistance = stats.ionResistance;
+		double ionEnergy = stats.ionEnergy;
+		double ionFuel = stats.ionFuel;
+		double ionHeat = stats.ionHeat;
 		DoStatusEffect(isDisabled, ionization, ionResistance, energy, ionEnergy, fuel, ionFuel, heat, ionHeat);
 	}
 	
 	if(disruption)
 	{
-		double disruptionResistance = attributes.Get("disruption resistance");
-		double disruptionEnergy = attributes.Get("disruption resistance energy") / disruptionResistance;
-		double disruptionFuel = attributes.Get("disruption resistance fuel") / disruptionResistance;
-		double disruptionHeat = attributes.Get("disruption resistance heat") / disruptionResistance;
+		double disruptionResistance = stats.disruptionResistance;
+		double disruptionEnergy = stats.disruptionEnergy;
+		double disruptionFuel = stats.disruptionFuel;
+		double disruptionHeat = stats.disruptionHeat;
 		DoStatusEffect(isDisabled, disruption, disruptionResistance, energy, disruptionEnergy, fuel, disruptionFuel, heat, disruptionHeat);
 	}
 	
 	if(slowness)
 	{
-		double slowingResistance = attributes.Get("slowing resistance");
-		double slowingEnergy = attributes.Get("slowing resistance energy") / slowingResistance;
-		double slowingFuel = attributes.Get("slowing resistance fuel") / slowingResistance;
-		double slowingHeat = attributes.Get("slowing resistance heat") / slowingResistance;
+		double slowingResistance = stats.slowingResistance;
+		double slowingEnergy = stats.slowingEnergy;
+		double slowingFuel = stats.slowingFuel;
+		double slowingHeat = stats.slowingHeat;
 		DoStatusEffect(isDisabled, slowness, slowingResistance, energy, slowingEnergy, fuel, slowingFuel, heat, slowingHeat);
 	}
 	
@@ -2011,19 +2064,17 @@ void Ship::DoGeneration()
 	// maximum capacity for the rest of the turn, but must be clamped to the
 	// maximum here before they gain more. This is so that, for example, a ship
 	// with no batteries but a good generator can still move.
-	energy = min(energy, attributes.Get("energy capacity"));
-	fuel = min(fuel, attributes.Get("fuel capacity"));
+	energy = min(energy, stats.energyCapacity);
+	fuel = min(fuel, stats.fuelCapacity);
 	
-	heat -= heat * HeatDissipation();
+	heat -= heat * stats.heatDissipation;
 	if(heat > MaximumHeat())
 		isOverheated = true;
 	else if(heat < .9 * MaximumHeat())
 		isOverheated = false;
 	
-	double maxShields = attributes.Get("shields");
-	shields = min(shields, maxShields);
-	double maxHull = attributes.Get("hull");
-	hull = min(hull, maxHull);
+	shields = min(shields, stats.shields);
+	hull = min(hull, stats.hull);
 	
 	isDisabled = isOverheated || hull < MinimumHull() || (!crew && RequiredCrew());
 	
@@ -2048,35 +2099,35 @@ void Ship::DoGeneration()
 		if(currentSystem)
 		{
 			double scale = .2 + 1.8 / (.001 * position.Length() + 1);
-			fuel += currentSystem->SolarWind() * .03 * scale * (sqrt(attributes.Get("ramscoop")) + .05 * scale);
+			fuel += currentSystem->SolarWind() * .03 * scale * (stats.sqrtRamscoop + .05 * scale);
 			
 			double solarScaling = currentSystem->SolarPower() * scale;
-			energy += solarScaling * attributes.Get("solar collection");
-			heat += solarScaling * attributes.Get("solar heat");
+			energy += solarScaling * stats.solarCollection;
+			heat += solarScaling * stats.solarHeat;
 		}
 		
-		double coolingEfficiency = CoolingEfficiency();
-		energy += attributes.Get("energy generation") - attributes.Get("energy consumption");
-		fuel += attributes.Get("fuel generation");
-		heat += attributes.Get("heat generation");
-		heat -= coolingEfficiency * attributes.Get("cooling");
+		double coolingEfficiency = stats.coolingEfficiency;
+		energy += stats.netEnergyGeneration;
+		fuel += stats.fuelGeneration;
+		heat += stats.heatGeneration;
+		heat -= coolingEfficiency * stats.cooling;
 		
 		// Convert fuel into energy and heat only when the required amount of fuel is available.
-		if(attributes.Get("fuel consumption") <= fuel)
+		if(stats.fuelConsumption <= fuel)
 		{	
-			fuel -= attributes.Get("fuel consumption");
-			energy += attributes.Get("fuel energy");
-			heat += attributes.Get("fuel heat");
+			fuel -= stats.fuelConsumption;
+			energy += stats.fuelEnergy;
+			heat += stats.fuelHeat;
 		}
 		
 		// Apply active cooling. The fraction of full cooling to apply equals
 		// your ship's current fraction of its maximum temperature.
-		double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+		double activeCooling = coolingEfficiency * stats.activeCooling;
 		if(activeCooling > 0. && heat > 0. && energy >= 0.)
 		{
 			// Although it's a misuse of this feature, handle the case where
 			// "active cooling" does not require any energy.
-			double coolingEnergy = attributes.Get("cooling energy");
+			double coolingEnergy = stats.coolingEnergy;
 			if(coolingEnergy)
 			{
 				double spentEnergy = min(energy, coolingEnergy * min(1., Heat()));
@@ -2943,14 +2994,14 @@ double Ship::IdleHeat() const
 {
 	// This ship's cooling ability:
 	double coolingEfficiency = CoolingEfficiency();
-	double cooling = coolingEfficiency * attributes.Get("cooling");
-	double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+	double cooling = coolingEfficiency * stats.cooling;
+	double activeCooling = coolingEfficiency * stats.activeCooling;
 	
 	// Idle heat is the heat level where:
 	// heat = heat * diss + heatGen - cool - activeCool * heat / (100 * mass)
 	// heat = heat * (diss - activeCool / (100 * mass)) + (heatGen - cool)
 	// heat * (1 - diss + activeCool / (100 * mass)) = (heatGen - cool)
-	double production = max(0., attributes.Get("heat generation") - cooling);
+	double production = max(0., stats.heatGeneration - cooling);
 	double dissipation = HeatDissipation() + activeCooling / MaximumHeat();
 	if(!dissipation) return production ? numeric_limits<double>::max() : 0;
 	return production / dissipation;
@@ -2961,7 +3012,7 @@ double Ship::IdleHeat() const
 // Get the heat dissipation, in heat units per heat unit per frame.
 double Ship::HeatDissipation() const
 {
-	return .001 * attributes.Get("heat dissipation");
+	return stats.heatDissipation;
 }
 
 
@@ -2977,11 +3028,7 @@ double Ship::MaximumHeat() const
 // Calculate the multiplier for cooling efficiency.
 double Ship::CoolingEfficiency() const
 {
-	// This is an S-curve where the efficiency is 100% if you have no outfits
-	// that create "cooling inefficiency", and as that value increases the
-	// efficiency stays high for a while, then drops off, then approaches 0.
-	double x = attributes.Get("cooling inefficiency");
-	return 2. + 2. / (1. + exp(x / -2.)) - 4. / (1. + exp(x / -4.));
+	return stats.coolingEfficiency;
 }
 
 
@@ -3028,15 +3075,15 @@ double Ship::Mass() const
 
 double Ship::TurnRate() const
 {
-	return attributes.Get("turn") / Mass();
+	return stats.turn / Mass();
 }
 
 
 
 double Ship::Acceleration() const
 {
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / Mass();
+	double thrust = stats.thrust;
+	return (thrust ? thrust : stats.afterburnerThrust) / Mass();
 }
 
 
@@ -3046,15 +3093,15 @@ double Ship::MaxVelocity() const
 	// v * drag / mass == thrust / mass
 	// v * drag == thrust
 	// v = thrust / drag
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / attributes.Get("drag");
+	double thrust = stats.thrust;
+	return (thrust ? thrust : stats.afterburnerThrust) / stats.drag;
 }
 
 
 
 double Ship::MaxReverseVelocity() const
 {
-	return attributes.Get("reverse thrust") / attributes.Get("drag");
+	return stats.reverseThrust / stats.drag;
 }
 
 
@@ -3287,7 +3334,7 @@ void Ship::Jettison(const string &commodity, int tons)
 	heat -= tons * MAXIMUM_TEMPERATURE * Heat();
 	
 	for( ; tons > 0; tons -= Flotsam::TONS_PER_BOX)
-		jettisoned.emplace_back(new Flotsam(commodity, (Flotsam::TONS_PER_BOX < tons) ? Flotsam::TONS_PER_BOX : tons));
+		jettisoned.push_back(Flotsam::Create(commodity, (Flotsam::TONS_PER_BOX < tons) ? Flotsam::TONS_PER_BOX : tons));
 }
 
 
@@ -3307,7 +3354,7 @@ void Ship::Jettison(const Outfit *outfit, int count)
 	const int perBox = (mass <= 0.) ? count : (mass > Flotsam::TONS_PER_BOX) ? 1 : static_cast<int>(Flotsam::TONS_PER_BOX / mass);
 	while(count > 0)
 	{
-		jettisoned.emplace_back(new Flotsam(outfit, (perBox < count) ? perBox : count));
+		jettisoned.push_back(Flotsam::Create(outfit, (perBox < count) ? perBox : count));
 		count -= perBox;
 	}
 }
@@ -3359,6 +3406,7 @@ void Ship::AddOutfit(const Outfit *outfit, int count)
 				outfits.erase(it);
 		}
 		attributes.Add(*outfit, count);
+		UpdateDerivedStats();
 		if(outfit->IsWeapon())
 			armament.Add(outfit, count);
 		
@@ -3835,3 +3883,116 @@ int Ship::TakeDamage(const Weapon &weapon, double damageScaling, double distance
 	
 	return type;
 }
+
+
+
+// Recalculate the values cached from this ship's attributes.
+void Ship::UpdateDerivedStats()
+{
+	stats.Update(attributes);
+}
+
+
+
+// Make sure the cached values match the attributes. If they do not, some
+// code path changed the attributes without updating them.
+void Ship::CheckDerivedStats()
+{
+	DerivedStats expected;
+	expected.Update(attributes);
+	if(stats == expected)
+		return;
+	
+	Files::LogError("Warning: cached attributes of " + modelName
+		+ (name.empty() ? "" : " \"" + name + "\"") + " are out of date.");
+	stats = expected;
+}
+
+
+
+Ship::DerivedStats::DerivedStats()
+{
+	static const Outfit EMPTY = Outfit();
+	Update(EMPTY);
+}
+
+
+
+void Ship::DerivedStats::Update(const Outfit &attributes)
+{
+	hull = attributes.Get("hull");
+	shields = attributes.Get("shields");
+	energyCapacity = attributes.Get("energy capacity");
+	fuelCapacity = attributes.Get("fuel capacity");
+	
+	hullAvailable = attributes.Get("hull repair rate") * (1. + attributes.Get("hull repair multiplier"));
+	hullEnergy = (attributes.Get("hull energy") * (1. + attributes.Get("hull energy multiplier"))) / hullAvailable;
+	hullFuel = (attributes.Get("hull fuel") * (1. + attributes.Get("hull fuel multiplier"))) / hullAvailable;
+	hullHeat = (attributes.Get("hull heat") * (1. + attributes.Get("hull heat multiplier"))) / hullAvailable;
+	shieldsAvailable = attributes.Get("shield generation") * (1. + attributes.Get("shield generation multiplier"));
+	shieldsEnergy = (attributes.Get("shield energy") * (1. + attributes.Get("shield energy multiplier"))) / shieldsAvailable;
+	shieldsFuel = (attributes.Get("shield fuel") * (1. + attributes.Get("shield fuel multiplier"))) / shieldsAvailable;
+	shieldsHeat = (attributes.Get("shield heat") * (1. + attributes.Get("shield heat multiplier"))) / shieldsAvailable;
+	
+	ionResistance = attributes.Get("ion resistance");
+	ionEnergy = attributes.Get("ion resistance energy") / ionResistance;
+	ionFuel = attributes.Get("ion resistance fuel") / ionResistance;
+	ionHeat = attributes.Get("ion resistance heat") / ionResistance;
+	disruptionResistance = attributes.Get("disruption resistance");
+	disruptionEnergy = attributes.Get("disruption resistance energy") / disruptionResistance;
+	disruptionFuel = attributes.Get("disruption resistance fuel") / disruptionResistance;
+	disruptionHeat = attributes.Get("disruption resistance heat") / disruptionResistance;
+	slowingResistance = attributes.Get("slowing resistance");
+	slowingEnergy = attributes.Get("slowing resistance energy") / slowingResistance;
+	slowingFuel = attributes.Get("slowing resistance fuel") / slowingResistance;
+	slowingHeat = attributes.Get("slowing resistance heat") / slowingResistance;
+	
+	heatDissipation = .001 * attributes.Get("heat dissipation");
+	// This is an S-curve where the efficiency is 100% if you have no outfits
+	// that create "cooling inefficiency", and as that value increases the
+	// efficiency stays high for a while, then drops off, then approaches 0.
+	double x = attributes.Get("cooling inefficiency");
+	coolingEfficiency = 2. + 2. / (1. + exp(x / -2.)) - 4. / (1. + exp(x / -4.));
+	sqrtRamscoop = sqrt(attributes.Get("ramscoop"));
+	solarCollection = attributes.Get("solar collection");
+	solarHeat = attributes.Get("solar heat");
+	netEnergyGeneration = attributes.Get("energy generation") - attributes.Get("energy consumption");
+	fuelGeneration = attributes.Get("fuel generation");
+	heatGeneration = attributes.Get("heat generation");
+	cooling = attributes.Get("cooling");
+	fuelConsumption = attributes.Get("fuel consumption");
+	fuelEnergy = attributes.Get("fuel energy");
+	fuelHeat = attributes.Get("fuel heat");
+	activeCooling = attributes.Get("active cooling");
+	coolingEnergy = attributes.Get("cooling energy");
+	
+	hyperdrive = attributes.Get("hyperdrive");
+	jumpDrive = attributes.Get("jump drive");
+	cloak = attributes.Get("cloak");
+	cloakingFuel = attributes.Get("cloaking fuel");
+	cloakingEnergy = attributes.Get("cloaking energy");
+	cloakingHeat = attributes.Get("cloaking heat");
+	drag = attributes.Get("drag");
+	turn = attributes.Get("turn");
+	turningEnergy = attributes.Get("turning energy");
+	turningHeat = attributes.Get("turning heat");
+	thrust = attributes.Get("thrust");
+	thrustingEnergy = attributes.Get("thrusting energy");
+	thrustingHeat = attributes.Get("thrusting heat");
+	reverseThrust = attributes.Get("reverse thrust");
+	reverseThrustingEnergy = attributes.Get("reverse thrusting energy");
+	reverseThrustingHeat = attributes.Get("reverse thrusting heat");
+	afterburnerThrust = attributes.Get("afterburner thrust");
+	afterburnerFuel = attributes.Get("afterburner fuel");
+	afterburnerEnergy = attributes.Get("afterburner energy");
+	afterburnerHeat = attributes.Get("afterburner heat");
+}
+
+
+
+// Compare the raw bytes, so that values which are NaN (e.g. a repair cost
+// divided by a repair rate of zero) still compare equal to themselves.
+bool Ship::DerivedStats::operator==(const DerivedStats &other) const
+{
+	return !memcmp(this, &other, sizeof(DerivedStats));
+}
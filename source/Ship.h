@@ -130,6 +130,9 @@ public:
 	// When loading a ship, some of the outfits it lists may not have been
 	// loaded yet. So, wait until everything has been loaded, then call this.
 	void FinishLoading(bool isNewInstance);
+	// In debug mode, check every frame that each ship's cached outfit-derived
+	// values still agree with its attributes, and log any that do not.
+	static void SetCheckDerivedStats(bool check);
 	// Check that this ship model and all its outfits have been loaded.
 	bool IsValid() const;
 	// Save a full description of this ship, as currently configured.
@@ -177,6 +180,10 @@ public:
 	// The player can selectively deploy their carried ships, rather than just all / none.
 	void SetDeployOrder(bool shouldDeploy = true);
 	bool HasDeployOrder() const;
+	// The AI keeps its per-ship bookkeeping in flat arrays. This is the index
+	// of this ship's entry in them, or -1 if it has not been given one yet.
+	int AISlot() const;
+	void SetAISlot(int slot);
 	
 	// Access the ship's personality, which affects how the AI behaves.
 	const Personality &GetPersonality() const;
@@ -190,8 +197,13 @@ public:
 	void SetCommands(const Command &command);
 	const Command &Commands() const;
 	// Move this ship. A ship may create effects as it moves, in particular if
-	// it is in the process of blowing up.
+	// it is in the process of blowing up. This only changes this ship and any
+	// ships it is carrying, so different ships can be moved in parallel.
 	void Move(std::vector<Visual> &visuals, std::list<std::shared_ptr<Flotsam>> &flotsam);
+	// Finish moving this ship. This is the part of its movement that depends on
+	// other ships (approaching a boarding target, or following its parent out
+	// of hyperspace), so it must be done for one ship at a time, after Move().
+	void FinishMove(std::vector<Visual> &visuals);
 	// Generate energy, heat, etc. (This is called by Move().)
 	void DoGeneration();
 	// Launch any ships that are ready to launch.
@@ -433,6 +445,94 @@ private:
 	void CreateSparks(std::vector<Visual> &visuals, const Effect *effect, double amount);
 	// A helper method for taking damage from either a projectile or a hazard.
 	int TakeDamage(const Weapon &weapon, double damageScaling, double distanceTraveled, const Point &damagePosition, bool isBlast);
+	// Recalculate the values cached from this ship's attributes. This must be
+	// done whenever the attributes change, i.e. an outfit is added or removed.
+	void UpdateDerivedStats();
+	// Make sure the cached values match the attributes, for debug mode.
+	void CheckDerivedStats();
+	
+	
+private:
+	// The values that DoGeneration() and Move() need from the ship's
+	// attributes every frame. Looking each one up by name is expensive, so
+	// they are computed once whenever the outfits change. Every member is a
+	// double so that two copies can be compared byte for byte.
+	class DerivedStats {
+	public:
+		DerivedStats();
+		
+		void Update(const Outfit &attributes);
+		bool operator==(const DerivedStats &other) const;
+		
+		// Capacities:
+		double hull;
+		double shields;
+		double energyCapacity;
+		double fuelCapacity;
+		
+		// Hull and shield repair, with the energy, fuel, and heat used per
+		// point repaired:
+		double hullAvailable;
+		double hullEnergy;
+		double hullFuel;
+		double hullHeat;
+		double shieldsAvailable;
+		double shieldsEnergy;
+		double shieldsFuel;
+		double shieldsHeat;
+		
+		// Status effect resistance, with the cost per point resisted:
+		double ionResistance;
+		double ionEnergy;
+		double ionFuel;
+		double ionHeat;
+		double disruptionResistance;
+		double disruptionEnergy;
+		double disruptionFuel;
+		double disruptionHeat;
+		double slowingResistance;
+		double slowingEnergy;
+		double slowingFuel;
+		double slowingHeat;
+		
+		// Generation and cooling:
+		double heatDissipation;
+		double coolingEfficiency;
+		double sqrtRamscoop;
+		double solarCollection;
+		double solarHeat;
+		double netEnergyGeneration;
+		double fuelGeneration;
+		double heatGeneration;
+		double cooling;
+		double fuelConsumption;
+		double fuelEnergy;
+		double fuelHeat;
+		double activeCooling;
+		double coolingEnergy;
+		
+		// Movement:
+		double hyperdrive;
+		double jumpDrive;
+		double cloak;
+		double cloakingFuel;
+		double cloakingEnergy;
+		double cloakingHeat;
+		double drag;
+		double turn;
+		double turningEnergy;
+		double turningHeat;
+		double thrust;
+		double thrustingEnergy;
+		double thrustingHeat;
+		double reverseThrust;
+		double reverseThrustingEnergy;
+		double reverseThrustingHeat;
+		double afterburnerThrust;
+		double afterburnerFuel;
+		double afterburnerEnergy;
+		double afterburnerHeat;
+	};
 	
 	
 private:
@@ -460,17 +560,22 @@ private:
 	
 	int forget = 0;
 	bool isInSystem = true;
+	// The part of this step's movement that FinishMove() still has to do.
+	enum class PendingMove : int {NONE, HYPERSPACE, FLIGHT};
+	PendingMove pendingMove = PendingMove::NONE;
 	// "Special" ships cannot be forgotten, and if they land on a planet, they
 	// continue to exist and refuel instead of being deleted.
 	bool isSpecial = false;
 	bool isYours = false;
 	bool isParked = false;
 	bool shouldDeploy = false;
+	int aiSlot = -1;
 	bool isOverheated = false;
 	bool isDisabled = false;
 	bool isBoarding = false;
 	bool hasBoarded = false;
 	bool isThrusting = false;
+	bool isUsingAfterburner = false;
 	bool isReversing = false;
 	bool isSteering = false;
 	double steeringDirection = 0.;
@@ -495,6 +600,7 @@ private:
 	// Installed outfits, cargo, etc.:
 	Outfit attributes;
 	Outfit baseAttributes;
+	DerivedStats stats;
 	bool addAttributes = false;
 	const Outfit *explosionWeapon = nullptr;
 	std::map<const Outfit *, int> outfits;
@@ -80,29 +80,40 @@ void ShipInfoPanel::Draw()
 	// Dim everything behind this panel.
 	DrawBackdrop();
 	
+	static const int SHIP_TAB = Information::ConditionSlot("ship tab");
+	static const int CAN_PARK = Information::ConditionSlot("can park");
+	static const int SHOW_PARK = Information::ConditionSlot("show park");
+	static const int SHOW_UNPARK = Information::ConditionSlot("show unpark");
+	static const int SHOW_DISOWN = Information::ConditionSlot("show disown");
+	static const int SHOW_DUMP = Information::ConditionSlot("show dump");
+	static const int ENABLE_DUMP = Information::ConditionSlot("enable dump");
+	static const int FIVE_BUTTONS = Information::ConditionSlot("five buttons");
+	static const int THREE_BUTTONS = Information::ConditionSlot("three buttons");
+	static const int ENABLE_LOGBOOK = Information::ConditionSlot("enable logbook");
+	
 	// Fill in the information for how this interface should be drawn.
 	Information interfaceInfo;
-	interfaceInfo.SetCondition("ship tab");
+	interfaceInfo.SetCondition(SHIP_TAB);
 	if(canEdit && (shipIt != player.Ships().end())
 			&& (shipIt->get() != player.Flagship() || (*shipIt)->IsParked()))
 	{
 		if(!(*shipIt)->IsDisabled())
-			interfaceInfo.SetCondition("can park");
-		interfaceInfo.SetCondition((*shipIt)->IsParked() ? "show unpark" : "show park");
-		interfaceInfo.SetCondition("show disown");
+			interfaceInfo.SetCondition(CAN_PARK);
+		interfaceInfo.SetCondition((*shipIt)->IsParked() ? SHOW_UNPARK : SHOW_PARK);
+		interfaceInfo.SetCondition(SHOW_DISOWN);
 	}
 	else if(!canEdit)
 	{
-		interfaceInfo.SetCondition("show dump");
+		interfaceInfo.SetCondition(SHOW_DUMP);
 		if(CanDump())
-			interfaceInfo.SetCondition("enable dump");
+			interfaceInfo.SetCondition(ENABLE_DUMP);
 	}
 	if(player.Ships().size() > 1)
-		interfaceInfo.SetCondition("five buttons");
+		interfaceInfo.SetCondition(FIVE_BUTTONS);
 	else
-		interfaceInfo.SetCondition("three buttons");
+		interfaceInfo.SetCondition(THREE_BUTTONS);
 	if(player.HasLogs())
-		interfaceInfo.SetCondition("enable logbook");
+		interfaceInfo.SetCondition(ENABLE_LOGBOOK);
 	
 	// Draw the interface.
 	const Interface *infoPanelUi = GameData::Interfaces().Get("info panel");
@@ -15,6 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "ImageBuffer.h"
 #include "Preferences.h"
 #include "Screen.h"
+#include "SpriteAtlas.h"
 
 #include "gl_header.h"
 #include <SDL2/SDL.h>
@@ -40,7 +41,7 @@ const string &Sprite::Name() const
 
 
 // Upload the given frames. The given buffer will be cleared afterwards.
-void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
+void Sprite::AddFrames(ImageBuffer &buffer, bool is2x, bool canShare)
 {
 	// Do nothing if the buffer is empty.
 	if(!buffer.Pixels())
@@ -58,6 +59,14 @@ void Sprite::AddFrames(ImageBuffer &buffer, bool is2x)
 	if(Preferences::Has("Reduce large graphics") && buffer.Width() * buffer.Height() >= 1000000)
 		buffer.ShrinkToHalfSize();
 	
+	// Small sprites can share a texture with others of the same frame count.
+	isShared[is2x] = canShare && SpriteAtlas::Add(buffer, texture[is2x], textureRect[is2x]);
+	if(isShared[is2x])
+	{
+		buffer.Clear();
+		return;
+	}
+	
 	// Upload the images as a single array texture.
 	glGenTextures(1, &texture[is2x]);
 	glBindTexture(GL_TEXTURE_2D_ARRAY, texture[is2x]);
@@ -95,8 +104,17 @@ void Sprite::AddMasks(vector<Mask> &masks)
 // Free up all textures loaded for this sprite.
 void Sprite::Unload()
 {
-	glDeleteTextures(2, texture);
+	// A shared texture cannot be freed, because other sprites still use it.
+	for(int i = 0; i < 2; ++i)
+		if(!isShared[i])
+			glDeleteTextures(1, &texture[i]);
 	texture[0] = texture[1] = 0;
+	isShared[0] = isShared[1] = false;
+	for(float *rect : textureRect)
+	{
+		rect[0] = rect[1] = 0.f;
+		rect[2] = rect[3] = 1.f;
+	}
 	
 	masks.clear();
 	width = 0.f;
@@ -155,6 +173,23 @@ uint32_t Sprite::Texture(bool isHighDPI) const
 
 
 
+// Get the area of the texture that this sprite uses, based on whether the
+// screen is high DPI or not.
+const float *Sprite::TextureRect() const
+{
+	return TextureRect(Screen::IsHighResolution());
+}
+
+
+
+// Get the area of the texture that this sprite uses, for the given high DPI mode.
+const float *Sprite::TextureRect(bool isHighDPI) const
+{
+	return (isHighDPI && texture[1]) ? textureRect[1] : textureRect[0];
+}
+
+
+
 // Get the collision mask for the given frame of the animation.
 const Mask &Sprite::GetMask(int frame) const
 {
@@ -26,10 +26,10 @@ class ImageBuffer;
 
 // Class representing a drawable sprite. A sprite can have multiple frames, for
 // animation. Certain sprites will also include a "mask" that can be used to
-// check whether something has collided with them. Each frame is stored in a
-// separate OpenGL texture object. This may not be as efficient as sprite
-// sheets, but with modern graphics cards it will not matter much and it makes
-// working with the graphics a lot simpler.
+// check whether something has collided with them. The frames are stored as the
+// layers of an OpenGL array texture. Small sprites may share that texture with
+// other sprites (see SpriteAtlas), in which case the sprite only covers part of
+// each layer; shaders must map texture coordinates using TextureRect().
 class Sprite {
 public:
 	explicit Sprite(const std::string &name = "");
@@ -37,7 +37,8 @@ public:
 	const std::string &Name() const;
 	
 	// Upload the given frames. The given buffer will be cleared afterwards.
-	void AddFrames(ImageBuffer &buffer, bool is2x);
+	// If allowed, small sprites will be placed in a shared texture.
+	void AddFrames(ImageBuffer &buffer, bool is2x, bool canShare = false);
 	// Move the given masks into this sprite's internal storage. The given
 	// vector will be cleared.
 	void AddMasks(std::vector<Mask> &masks);
@@ -59,6 +60,10 @@ public:
 	// setting or specifying it manually.
 	uint32_t Texture() const;
 	uint32_t Texture(bool isHighDPI) const;
+	// Get the area of that texture that this sprite uses, as (left, top, right,
+	// bottom) texture coordinates. This is (0, 0, 1, 1) unless it is shared.
+	const float *TextureRect() const;
+	const float *TextureRect(bool isHighDPI) const;
 	// Get the collision mask for the given frame of the animation.
 	const Mask &GetMask(int frame = 0) const;
 	
@@ -67,6 +72,8 @@ private:
 	std::string name;
 	
 	uint32_t texture[2] = {0, 0};
+	float textureRect[2][4] = {{0.f, 0.f, 1.f, 1.f}, {0.f, 0.f, 1.f, 1.f}};
+	bool isShared[2] = {false, false};
 	std::vector<Mask> masks;
 	
 	float width = 0.f;
@@ -0,0 +1,153 @@
+/* SpriteAtlas.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "SpriteAtlas.h"
+
+#include "ImageBuffer.h"
+
+#include "gl_header.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// A page is filled in "shelves": rows of sprites, each as tall as the
+	// tallest sprite in it. Only the most recent page for each frame count
+	// is still open for adding sprites.
+	class Page {
+	public:
+		GLuint texture = 0;
+		int size = 0;
+		int x = 0;
+		int y = 0;
+		int shelfHeight = 0;
+	};
+	
+	// The open page for each frame count.
+	map<int, Page> pages;
+	
+	// Limit each page to this many texels, across all its layers, so that a
+	// page which is mostly empty does not waste much video memory.
+	const int MAX_PAGE_TEXELS = 1 << 20;
+	const int MAX_PAGE_SIZE = 1024;
+	const int MIN_PAGE_SIZE = 128;
+	// Sprites with more frames than this get their own texture.
+	const int MAX_FRAMES = 64;
+	// At least this many sprites of the largest shared size must fit across
+	// the width and height of a page.
+	const int MIN_SPRITES_PER_ROW = 4;
+	// Each sprite is surrounded by a copy of its edge pixels, so that linear
+	// filtering at its edges never blends in any of its neighbors.
+	const int GUTTER = 1;
+	
+	// Get the size of the pages used for sprites with the given frame count.
+	int PageSize(int frames)
+	{
+		int size = MAX_PAGE_SIZE;
+		while(size > MIN_PAGE_SIZE && size * size * frames > MAX_PAGE_TEXELS)
+			size /= 2;
+		return size;
+	}
+	
+	void CreatePage(Page &page, int size, int frames)
+	{
+		page = Page();
+		page.size = size;
+		
+		glGenTextures(1, &page.texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, page.texture);
+		
+		// Use the same settings as a sprite's own texture would.
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		
+		// Allocate the storage without uploading anything yet.
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, frames,
+			0, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+	}
+	
+	// Find room for a width x height area on the page. Returns false if the
+	// page is already too full.
+	bool Place(Page &page, int width, int height, int &x, int &y)
+	{
+		if(page.x + width > page.size)
+		{
+			// Start a new shelf.
+			page.y += page.shelfHeight;
+			page.x = 0;
+			page.shelfHeight = 0;
+		}
+		if(page.y + height > page.size)
+			return false;
+		
+		x = page.x;
+		y = page.y;
+		page.x += width;
+		page.shelfHeight = max(page.shelfHeight, height);
+		return true;
+	}
+}
+
+
+
+// Try to place the given frames on a shared page.
+bool SpriteAtlas::Add(const ImageBuffer &buffer, uint32_t &texture, float rect[4])
+{
+	int frames = buffer.Frames();
+	if(frames > MAX_FRAMES)
+		return false;
+	
+	int size = PageSize(frames);
+	int width = buffer.Width() + 2 * GUTTER;
+	int height = buffer.Height() + 2 * GUTTER;
+	if(width * MIN_SPRITES_PER_ROW > size || height * MIN_SPRITES_PER_ROW > size)
+		return false;
+	
+	Page &page = pages[frames];
+	int x = 0;
+	int y = 0;
+	if(!page.texture || !Place(page, width, height, x, y))
+	{
+		CreatePage(page, size, frames);
+		Place(page, width, height, x, y);
+	}
+	else
+		glBindTexture(GL_TEXTURE_2D_ARRAY, page.texture);
+	
+	// Copy the frames into a buffer with room for the gutter, extending the
+	// outermost pixels of each frame out into it.
+	vector<uint32_t> pixels(width * height * frames);
+	uint32_t *out = pixels.data();
+	for(int frame = 0; frame < frames; ++frame)
+		for(int row = 0; row < height; ++row)
+		{
+			const uint32_t *in = buffer.Begin(min(max(row - GUTTER, 0), buffer.Height() - 1), frame);
+			for(int column = 0; column < width; ++column)
+				*out++ = in[min(max(column - GUTTER, 0), buffer.Width() - 1)];
+		}
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, 0, width, height, frames,
+		GL_BGRA, GL_UNSIGNED_BYTE, pixels.data());
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	
+	texture = page.texture;
+	float scale = 1.f / size;
+	rect[0] = (x + GUTTER) * scale;
+	rect[1] = (y + GUTTER) * scale;
+	rect[2] = (x + GUTTER + buffer.Width()) * scale;
+	rect[3] = (y + GUTTER + buffer.Height()) * scale;
+	return true;
+}
@@ -0,0 +1,41 @@
+/* SpriteAtlas.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef SPRITE_ATLAS_H_
+#define SPRITE_ATLAS_H_
+
+#include <cstdint>
+
+class ImageBuffer;
+
+
+
+// Class for packing small sprites into shared array textures ("pages"), so
+// that many different sprites can be drawn without switching textures. All
+// the sprites on one page have the same number of frames, and each frame is
+// stored at the same place in its own layer of the page. That way the shaders
+// can still use the frame number as the layer index; they only need to map
+// the sprite's (0, 0) to (1, 1) texture coordinates to its area of the page.
+// This must only be used from the main (OpenGL) thread.
+class SpriteAtlas {
+public:
+	// Try to place the given frames on a shared page. If this succeeds, the
+	// page's texture is stored in "texture" and the sprite's area of it is
+	// stored in "rect" as (left, top, right, bottom) texture coordinates. If
+	// the image is too large to share a page, this returns false and the
+	// sprite should be given a texture of its own.
+	static bool Add(const ImageBuffer &buffer, uint32_t &texture, float rect[4]);
+};
+
+
+
+#endif
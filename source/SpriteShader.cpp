@@ -17,6 +17,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Shader.h"
 #include "Sprite.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 #include <sstream>
 
@@ -32,11 +34,30 @@ namespace {
 	GLint blurI;
 	GLint clipI;
 	GLint alphaI;
+	GLint rectI;
 	GLint swizzlerI;
 	
 	GLuint vao;
 	GLuint vbo;
-
+	
+	// The instanced shader reads the per-item values from an instance buffer
+	// holding an array of SpriteShader::Item, instead of from uniforms.
+	Shader instancedShader;
+	GLint instancedScaleI;
+	GLint instancedBlurScaleI;
+	GLint instancedSwizzlerI;
+	GLint instanceFrameI;
+	GLint instancePositionI;
+	GLint instanceTransformI;
+	GLint instanceBlurI;
+	GLint instanceClipAlphaI;
+	GLint instanceRectI;
+	
+	GLuint instancedVao;
+	GLuint instanceVbo;
+	
+	unsigned drawCalls = 0;
+	
 	const vector<vector<GLint>> SWIZZLE = {
 		{GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA}, // red + yellow markings (republic)
 		{GL_RED, GL_BLUE, GL_GREEN, GL_ALPHA}, // red + magenta markings
@@ -51,11 +72,13 @@ namespace {
 }
 
 bool SpriteShader::useShaderSwizzle = false;
+bool SpriteShader::useInstancing = false;
 
 // Initialize the shaders.
-void SpriteShader::Init(bool useShaderSwizzle)
+void SpriteShader::Init(bool useShaderSwizzle, bool useInstancing)
 {
 	SpriteShader::useShaderSwizzle = useShaderSwizzle;
+	SpriteShader::useInstancing = useInstancing;
 	
 	static const char *vertexCode =
 		"// vertex sprite shader\n"
@@ -75,23 +98,79 @@ void SpriteShader::Init(bool useShaderSwizzle)
 		"  fragTexCoord = vec2(texCoord.x, max(clip, texCoord.y)) + blurOff;\n"
 		"}\n";
 	
+	// The instanced version of the vertex shader takes the same values as
+	// per-instance attributes, and passes the ones the fragment shader needs
+	// along to it.
+	static const char *instancedVertexCode =
+		"// vertex instanced sprite shader\n"
+		"uniform vec2 scale;\n"
+		"uniform float blurScale;\n"
+		
+		"in vec2 vert;\n"
+		"in vec2 instanceFrame;\n"
+		"in vec2 instancePosition;\n"
+		"in vec4 instanceTransform;\n"
+		"in vec2 instanceBlur;\n"
+		"in vec2 instanceClipAlpha;\n"
+		"in vec4 instanceRect;\n"
+		"out vec2 fragTexCoord;\n"
+		"flat out float frame;\n"
+		"flat out float frameCount;\n"
+		"flat out vec2 blur;\n"
+		"flat out float alpha;\n"
+		"flat out vec4 rect;\n"
+		
+		"void main() {\n"
+		"  frame = instanceFrame.x;\n"
+		"  frameCount = instanceFrame.y;\n"
+		"  blur = instanceBlur * blurScale;\n"
+		"  alpha = instanceClipAlpha.y;\n"
+		"  rect = instanceRect;\n"
+		"  float clip = 1 - instanceClipAlpha.x;\n"
+		"  mat2 transform = mat2(instanceTransform.xy, instanceTransform.zw);\n"
+		"  vec2 blurOff = 2 * vec2(vert.x * abs(blur.x), vert.y * abs(blur.y));\n"
+		"  gl_Position = vec4((transform * (vert + blurOff) + instancePosition) * scale, 0, 1);\n"
+		"  vec2 texCoord = vert + vec2(.5, .5);\n"
+		"  fragTexCoord = vec2(texCoord.x, max(clip, texCoord.y)) + blurOff;\n"
+		"}\n";
+	
+	// Both versions of the fragment shader share the same body; only the
+	// source of the per-sprite values differs.
 	ostringstream fragmentCodeStream;
 	fragmentCodeStream <<
 		"// fragment sprite shader\n"
 		"uniform sampler2DArray tex;\n"
 		"uniform float frame;\n"
 		"uniform float frameCount;\n"
-		"uniform vec2 blur;\n";
-	if(useShaderSwizzle) fragmentCodeStream <<
-		"uniform int swizzler;\n";
-	fragmentCodeStream <<
+		"uniform vec2 blur;\n"
 		"uniform float alpha;\n"
+		"uniform vec4 rect;\n";
+	ostringstream instancedFragmentCodeStream;
+	instancedFragmentCodeStream <<
+		"// fragment instanced sprite shader\n"
+		"uniform sampler2DArray tex;\n"
+		"flat in float frame;\n"
+		"flat in float frameCount;\n"
+		"flat in vec2 blur;\n"
+		"flat in float alpha;\n"
+		"flat in vec4 rect;\n";
+	
+	ostringstream bodyStream;
+	if(useShaderSwizzle) bodyStream <<
+		"uniform int swizzler;\n";
+	bodyStream <<
 		"const int range = 5;\n"
 		
 		"in vec2 fragTexCoord;\n"
 		
 		"out vec4 finalColor;\n"
 		
+		// Map the sprite's texture coordinates to its area of a shared texture.
+		// Clamping them first has the same effect as GL_CLAMP_TO_EDGE.
+		"vec2 SpriteCoord(vec2 coord) {\n"
+		"  return mix(rect.xy, rect.zw, clamp(coord, 0., 1.));\n"
+		"}\n"
+		
 		"void main() {\n"
 		"  float first = floor(frame);\n"
 		"  float second = mod(ceil(frame), frameCount);\n"
@@ -101,10 +180,10 @@ void SpriteShader::Init(bool useShaderSwizzle)
 		"  {\n"
 		"    if(fade != 0)\n"
 		"      color = mix(\n"
-		"        texture(tex, vec3(fragTexCoord, first)),\n"
-		"        texture(tex, vec3(fragTexCoord, second)), fade);\n"
+		"        texture(tex, vec3(SpriteCoord(fragTexCoord), first)),\n"
+		"        texture(tex, vec3(SpriteCoord(fragTexCoord), second)), fade);\n"
 		"    else\n"
-		"      color = texture(tex, vec3(fragTexCoord, first));\n"
+		"      color = texture(tex, vec3(SpriteCoord(fragTexCoord), first));\n"
 		"  }\n"
 		"  else\n"
 		"  {\n"
@@ -113,7 +192,7 @@ void SpriteShader::Init(bool useShaderSwizzle)
 		"    for(int i = -range; i <= range; ++i)\n"
 		"    {\n"
 		"      float scale = (range + 1 - abs(i)) / divisor;\n"
-		"      vec2 coord = fragTexCoord + (blur * i) / range;\n"
+		"      vec2 coord = SpriteCoord(fragTexCoord + (blur * i) / range);\n"
 		"      if(fade != 0)\n"
 		"        color += scale * mix(\n"
 		"          texture(tex, vec3(coord, first)),\n"
@@ -126,7 +205,7 @@ void SpriteShader::Init(bool useShaderSwizzle)
 	// Only included when hardware swizzle not supported, GL <3.3 and GLES
 	if(useShaderSwizzle)
 	{
-		fragmentCodeStream <<
+		bodyStream <<
 		"  switch (swizzler) {\n"
 		"    case 0:\n"
 		"      color = color.rgba;\n"
@@ -157,10 +236,11 @@ void SpriteShader::Init(bool useShaderSwizzle)
 		"      break;\n"
 		"  }\n";
 	}
-	fragmentCodeStream <<
+	bodyStream <<
 		"  finalColor = color * alpha;\n"
 		"}\n";
 	
+	fragmentCodeStream << bodyStream.str();
 	static const string fragmentCodeString = fragmentCodeStream.str();
 	static const char *fragmentCode = fragmentCodeString.c_str();
 	
@@ -173,6 +253,7 @@ void SpriteShader::Init(bool useShaderSwizzle)
 	blurI = shader.Uniform("blur");
 	clipI = shader.Uniform("clip");
 	alphaI = shader.Uniform("alpha");
+	rectI = shader.Uniform("rect");
 	if(useShaderSwizzle)
 		swizzlerI = shader.Uniform("swizzler");
 	
@@ -201,6 +282,52 @@ void SpriteShader::Init(bool useShaderSwizzle)
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
+	
+	if(!useInstancing)
+		return;
+	
+	instancedFragmentCodeStream << bodyStream.str();
+	static const string instancedFragmentCodeString = instancedFragmentCodeStream.str();
+	static const char *instancedFragmentCode = instancedFragmentCodeString.c_str();
+	
+	instancedShader = Shader(instancedVertexCode, instancedFragmentCode);
+	instancedScaleI = instancedShader.Uniform("scale");
+	instancedBlurScaleI = instancedShader.Uniform("blurScale");
+	if(useShaderSwizzle)
+		instancedSwizzlerI = instancedShader.Uniform("swizzler");
+	instanceFrameI = instancedShader.Attrib("instanceFrame");
+	instancePositionI = instancedShader.Attrib("instancePosition");
+	instanceTransformI = instancedShader.Attrib("instanceTransform");
+	instanceBlurI = instancedShader.Attrib("instanceBlur");
+	instanceClipAlphaI = instancedShader.Attrib("instanceClipAlpha");
+	instanceRectI = instancedShader.Attrib("instanceRect");
+	
+	glUseProgram(instancedShader.Object());
+	glUniform1i(instancedShader.Uniform("tex"), 0);
+	glUseProgram(0);
+	
+	// The instanced VAO shares the sprite vertex data, but also reads one Item
+	// from the instance buffer for each sprite that is drawn.
+	glGenVertexArrays(1, &instancedVao);
+	glBindVertexArray(instancedVao);
+	
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glEnableVertexAttribArray(instancedShader.Attrib("vert"));
+	glVertexAttribPointer(instancedShader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	
+	glGenBuffers(1, &instanceVbo);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+	
+	// The attribute offsets are set each time a run of items is drawn, so
+	// here they only need to be enabled and marked as per-instance.
+	for(GLint attrib : {instanceFrameI, instancePositionI, instanceTransformI, instanceBlurI, instanceClipAlphaI, instanceRectI})
+	{
+		glEnableVertexAttribArray(attrib);
+		glVertexAttribDivisor(attrib, 1);
+	}
+	
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
 }
 
 
@@ -212,6 +339,8 @@ void SpriteShader::Draw(const Sprite *sprite, const Point &position, float zoom,
 	
 	Item item;
 	item.texture = sprite->Texture();
+	const float *rect = sprite->TextureRect();
+	copy(rect, rect + 4, item.rect);
 	item.frame = frame;
 	item.frameCount = sprite->Frames();
 	// Position.
@@ -255,6 +384,7 @@ void SpriteShader::Add(const Item &item, bool withBlur)
 	// Clipping has the opposite sense in the shader.
 	glUniform1f(clipI, 1.f - item.clip);
 	glUniform1f(alphaI, item.alpha);
+	glUniform4fv(rectI, 1, item.rect);
 	
 	// Bounds check for the swizzle value:
 	int swizzle = (static_cast<size_t>(item.swizzle) >= SWIZZLE.size() ? 0 : item.swizzle);
@@ -265,12 +395,19 @@ void SpriteShader::Add(const Item &item, bool withBlur)
 		glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[swizzle].data());
 	
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	++drawCalls;
+	
+	// The texture may be shared with sprites that other shaders draw, so do
+	// not leave it swizzled.
+	if(swizzle && !SpriteShader::useShaderSwizzle)
+		glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[0].data());
 }
 
 
 
 void SpriteShader::Unbind()
 {
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 	glUseProgram(0);
 	
@@ -280,3 +417,77 @@ void SpriteShader::Unbind()
 	else
 		glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[0].data());
 }
+
+
+
+bool SpriteShader::UseInstancing()
+{
+	return useInstancing;
+}
+
+
+
+void SpriteShader::BindInstanced()
+{
+	glUseProgram(instancedShader.Object());
+	glBindVertexArray(instancedVao);
+	// Bind the instance buffer so the items can be uploaded to it.
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+	
+	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
+	glUniform2fv(instancedScaleI, 1, scale);
+}
+
+
+
+void SpriteShader::AddInstanced(const vector<Item> &items, bool withBlur)
+{
+	if(items.empty())
+		return;
+	
+	// Upload all the items at once, then draw each run of items that share
+	// the same texture and swizzle with one call.
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Item) * items.size(), items.data(), GL_STREAM_DRAW);
+	glUniform1f(instancedBlurScaleI, withBlur ? 1.f : 0.f);
+	
+	for(size_t first = 0; first < items.size(); )
+	{
+		const Item &item = items[first];
+		size_t last = first + 1;
+		while(last < items.size() && items[last].texture == item.texture && items[last].swizzle == item.swizzle)
+			++last;
+		
+		glBindTexture(GL_TEXTURE_2D_ARRAY, item.texture);
+		// Bounds check for the swizzle value:
+		int swizzle = (static_cast<size_t>(item.swizzle) >= SWIZZLE.size() ? 0 : item.swizzle);
+		// Set the color swizzle.
+		if(SpriteShader::useShaderSwizzle)
+			glUniform1i(instancedSwizzlerI, swizzle);
+		else
+			glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[swizzle].data());
+		
+		// Point the per-instance attributes at the start of this run. In the
+		// Item class, the frame and frame count are adjacent, as are the clip
+		// and alpha values, so each pair can be read as one vec2.
+		const char *base = reinterpret_cast<const char *>(first * sizeof(Item));
+		glVertexAttribPointer(instanceFrameI, 2, GL_FLOAT, GL_FALSE, sizeof(Item), base + offsetof(Item, frame));
+		glVertexAttribPointer(instancePositionI, 2, GL_FLOAT, GL_FALSE, sizeof(Item), base + offsetof(Item, position));
+		glVertexAttribPointer(instanceTransformI, 4, GL_FLOAT, GL_FALSE, sizeof(Item), base + offsetof(Item, transform));
+		glVertexAttribPointer(instanceBlurI, 2, GL_FLOAT, GL_FALSE, sizeof(Item), base + offsetof(Item, blur));
+		glVertexAttribPointer(instanceClipAlphaI, 2, GL_FLOAT, GL_FALSE, sizeof(Item), base + offsetof(Item, clip));
+		glVertexAttribPointer(instanceRectI, 4, GL_FLOAT, GL_FALSE, sizeof(Item), base + offsetof(Item, rect));
+		
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, last - first);
+		++drawCalls;
+		if(swizzle && !SpriteShader::useShaderSwizzle)
+			glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[0].data());
+		first = last;
+	}
+}
+
+
+
+unsigned SpriteShader::DrawCalls()
+{
+	return drawCalls;
+}
@@ -17,6 +17,7 @@ class Sprite;
 class Point;
 
 #include <cstdint>
+#include <vector>
 
 
 
@@ -38,12 +39,14 @@ public:
 		float blur[2] = {0.f, 0.f};
 		float clip = 1.f;
 		float alpha = 1.f;
+		// The area of the texture that the sprite uses (see Sprite::TextureRect()).
+		float rect[4] = {0.f, 0.f, 1.f, 1.f};
 	};
 	
 	
 public:
 	// Initialize the shaders.
-	static void Init(bool useShaderSwizzle);
+	static void Init(bool useShaderSwizzle, bool useInstancing);
 	
 	// Draw a sprite.
 	static void Draw(const Sprite *sprite, const Point &position, float zoom = 1.f, int swizzle = 0, float frame = 0.f);
@@ -52,9 +55,20 @@ public:
 	static void Add(const Item &item, bool withBlur = false);
 	static void Unbind();
 	
+	// If instanced drawing is supported, a whole list of items can be uploaded
+	// at once. Each run of consecutive items that share a texture and swizzle
+	// is then drawn with a single draw call.
+	static bool UseInstancing();
+	static void BindInstanced();
+	static void AddInstanced(const std::vector<Item> &items, bool withBlur = false);
+	
+	// Get the total number of draw calls issued by this shader so far.
+	static unsigned DrawCalls();
+	
 	
 private:
 	static bool useShaderSwizzle;
+	static bool useInstancing;
 };
 
 
@@ -21,23 +21,20 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Hazard.h"
 #include "Minable.h"
 #include "Planet.h"
-#include "Random.h"
 #include "SpriteSet.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 using namespace std;
 
 namespace {
-	// Dynamic economy parameters: how much of its production each system keeps
-	// and exports each day:
-	const double KEEP = .89;
-	const double EXPORT = .10;
-	// Standard deviation of the daily production of each commodity:
-	const double VOLUME = 2000.;
 	// Above this supply amount, price differences taper off:
 	const double LIMIT = 20000.;
+	
+	// The index that will be given to the next system that is created.
+	atomic<int> nextIndex(0);
 }
 
 const double System::DEFAULT_NEIGHBOR_DISTANCE = 100.;
@@ -128,6 +125,13 @@ int System::HazardProbability::Period() const
 
 
 
+System::System()
+	: index(nextIndex++)
+{
+}
+
+
+
 // Load a system's description.
 void System::Load(const DataNode &node, Set<Planet> &planets)
 {
@@ -456,6 +460,15 @@ bool System::IsValid() const
 
 
 
+// Get a small number that identifies this system, for looking up data about
+// it in a flat array. Copies of a system share the same index.
+int System::Index() const
+{
+	return index;
+}
+
+
+
 // Get this system's name.
 const string &System::Name() const
 {
@@ -732,20 +745,6 @@ bool System::HasTrade() const
 
 
 
-// Update the economy.
-void System::StepEconomy()
-{
-	for(auto &it : trade)
-	{
-		it.second.exports = EXPORT * it.second.supply;
-		it.second.supply *= KEEP;
-		it.second.supply += Random::Normal() * VOLUME;
-		it.second.Update();
-	}
-}
-
-
-
 void System::SetSupply(const string &commodity, double tons)
 {
 	auto it = trade.find(commodity);
@@ -766,14 +765,6 @@ double System::Supply(const string &commodity) const
 
 
 
-double System::Exports(const string &commodity) const
-{
-	auto it = trade.find(commodity);
-	return (it == trade.end()) ? 0 : it->second.exports;
-}
-
-
-
 // Get the probabilities of various fleets entering this system.
 const vector<System::FleetProbability> &System::Fleets() const
 {
@@ -85,6 +85,8 @@ public:
 	
 	
 public:
+	System();
+	
 	// Load a system's description.
 	void Load(const DataNode &node, Set<Planet> &planets);
 	// Update any information about the system that may have changed due to events,
@@ -96,6 +98,9 @@ public:
 	void Unlink(System *other);
 	
 	bool IsValid() const;
+	// Get a small number that identifies this system, for looking up data about
+	// it in a flat array. Copies of a system share the same index.
+	int Index() const;
 	// Get this system's name and position (in the star map).
 	const std::string &Name() const;
 	void SetName(const std::string &name);
@@ -157,11 +162,8 @@ public:
 	// Get the price of the given commodity in this system.
 	int Trade(const std::string &commodity) const;
 	bool HasTrade() const;
-	// Update the economy. Returns the amount of trade goods this system exports.
-	void StepEconomy();
 	void SetSupply(const std::string &commodity, double tons);
 	double Supply(const std::string &commodity) const;
-	double Exports(const std::string &commodity) const;
 	
 	// Get the probabilities of various fleets entering this system.
 	const std::vector<FleetProbability> &Fleets() const;
@@ -189,11 +191,11 @@ private:
 		int base = 0;
 		int price = 0;
 		double supply = 0.;
-		double exports = 0.;
 	};
 	
 	
 private:
+	int index;
 	bool isDefined = false;
 	bool hasPosition = false;
 	// Name and position (within the star map) of this system.
@@ -240,6 +242,9 @@ private:
 	
 	// Attributes, for use in location filters.
 	std::set<std::string> attributes;
+	
+	// Let Economy read and write the supplies without looking them up by name.
+	friend class Economy;
 };
 
 
@@ -0,0 +1,193 @@
+/* ThreadPool.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "ThreadPool.h"
+
+#include "Random.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// Every loop is divided into this many blocks. This does not depend on the
+	// number of cores, so that the results do not either.
+	const int BLOCKS = 8;
+	// Loops over fewer objects than this per block are not worth running on
+	// more than one thread.
+	const size_t MIN_BLOCK_SIZE = 16;
+	
+	class Pool {
+	public:
+		Pool();
+		~Pool();
+		
+		void Run(size_t count, const function<void(int, size_t, size_t)> &function);
+		
+		// Thread entry point.
+		void operator()(int index);
+	
+	private:
+		// Run every block that belongs to the thread with the given index.
+		void RunBlocks(int index);
+	
+	private:
+		int threads = 1;
+		
+		// The loop that is currently being run.
+		const function<void(int, size_t, size_t)> *work = nullptr;
+		size_t count = 0;
+		uint64_t seeds[BLOCKS] = {};
+		// This is incremented each time a new loop begins.
+		int generation = 0;
+		// The number of worker threads that are not done yet.
+		int remaining = 0;
+		bool done = false;
+		
+		mutex poolMutex;
+		condition_variable startCondition;
+		condition_variable finishCondition;
+		vector<thread> workers;
+	};
+	
+	Pool pool;
+	
+	size_t Begin(size_t count, int block)
+	{
+		return count * block / BLOCKS;
+	}
+}
+
+
+
+// Get the number of blocks that Run() divides its work into.
+int ThreadPool::Blocks()
+{
+	return BLOCKS;
+}
+
+
+
+// Call the given function for each block of the objects [0, count).
+void ThreadPool::Run(size_t count, const function<void(int block, size_t begin, size_t end)> &function)
+{
+	pool.Run(count, function);
+}
+
+
+
+namespace {
+	Pool::Pool()
+	{
+		int cores = static_cast<int>(thread::hardware_concurrency());
+		threads = max(1, min(BLOCKS, cores));
+	}
+	
+	
+	
+	Pool::~Pool()
+	{
+		{
+			lock_guard<mutex> lock(poolMutex);
+			done = true;
+		}
+		startCondition.notify_all();
+		for(thread &worker : workers)
+			worker.join();
+	}
+	
+	
+	
+	void Pool::Run(size_t count, const function<void(int, size_t, size_t)> &function)
+	{
+		// The seed for each block comes from the calling thread's generator,
+		// so each time a loop is run its blocks get new random numbers, but
+		// the same ones no matter which threads end up running them.
+		uint64_t blockSeeds[BLOCKS];
+		for(uint64_t &seed : blockSeeds)
+			seed = (static_cast<uint64_t>(Random::Int()) << 32) | Random::Int();
+		
+		if(threads == 1 || count < MIN_BLOCK_SIZE * BLOCKS)
+		{
+			for(int block = 0; block < BLOCKS; ++block)
+			{
+				Random::Stream stream(blockSeeds[block]);
+				function(block, Begin(count, block), Begin(count, block + 1));
+			}
+			return;
+		}
+		
+		{
+			lock_guard<mutex> lock(poolMutex);
+			if(workers.empty())
+				for(int index = 1; index < threads; ++index)
+					workers.emplace_back(ref(*this), index);
+			work = &function;
+			this->count = count;
+			copy(blockSeeds, blockSeeds + BLOCKS, seeds);
+			remaining = threads - 1;
+			++generation;
+		}
+		startCondition.notify_all();
+		
+		// The calling thread takes care of its share of the blocks, too.
+		RunBlocks(0);
+		
+		unique_lock<mutex> lock(poolMutex);
+		while(remaining)
+			finishCondition.wait(lock);
+		work = nullptr;
+	}
+	
+	
+	
+	void Pool::operator()(int index)
+	{
+		int lastGeneration = 0;
+		unique_lock<mutex> lock(poolMutex);
+		while(true)
+		{
+			if(generation == lastGeneration)
+			{
+				if(done)
+					return;
+				startCondition.wait(lock);
+				continue;
+			}
+			lastGeneration = generation;
+			
+			// Run this thread's blocks without holding the lock. Nothing that
+			// they read changes until all the threads are done.
+			lock.unlock();
+			RunBlocks(index);
+			lock.lock();
+			
+			if(!--remaining)
+				finishCondition.notify_one();
+		}
+	}
+	
+	
+	
+	void Pool::RunBlocks(int index)
+	{
+		for(int block = index; block < BLOCKS; block += threads)
+		{
+			Random::Stream stream(seeds[block]);
+			(*work)(block, Begin(count, block), Begin(count, block + 1));
+		}
+	}
+}
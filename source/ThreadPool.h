@@ -0,0 +1,44 @@
+/* ThreadPool.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <cstddef>
+#include <functional>
+
+
+
+// Class for splitting a loop over many objects between several threads. The
+// objects are always divided into the same number of contiguous blocks, no
+// matter how many threads there are, so if each block writes its results into
+// a buffer of its own, appending those buffers in block order gives the same
+// order a single-threaded loop would have. Each block also draws its random
+// numbers from a Random::Stream of its own, seeded from the calling thread's
+// generator, so the results do not depend on which thread runs which block.
+// The worker threads are started the first time they are needed, and are
+// joined when the program exits.
+class ThreadPool {
+public:
+	// Get the number of blocks that Run() divides its work into.
+	static int Blocks();
+	// Call the given function for each block of the objects [0, count), giving
+	// it the block's index and the range of objects it covers. The calling
+	// thread does some of the blocks itself. This does not return until all
+	// the blocks are done. Small loops are run entirely on the calling thread,
+	// but still block by block.
+	static void Run(size_t count, const std::function<void(int block, size_t begin, size_t end)> &function);
+};
+
+
+
+#endif
@@ -203,14 +203,18 @@ void TradingPanel::Draw()
 		}
 	}
 	
+	static const int CAN_SELL_OUTFITS = Information::ConditionSlot("can sell outfits");
+	static const int CAN_SELL = Information::ConditionSlot("can sell");
+	static const int CAN_BUY = Information::ConditionSlot("can buy");
+	
 	const Interface *tradeUi = GameData::Interfaces().Get("trade");
 	Information info;
 	if(sellOutfits)
-		info.SetCondition("can sell outfits");
+		info.SetCondition(CAN_SELL_OUTFITS);
 	else if(player.Cargo().HasOutfits() || canSell)
-		info.SetCondition("can sell");
+		info.SetCondition(CAN_SELL);
 	if(player.Cargo().Free() > 0 && canBuy)
-		info.SetCondition("can buy");
+		info.SetCondition(CAN_BUY);
 	tradeUi->Draw(info, this);
 }
 
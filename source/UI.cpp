@@ -104,8 +104,10 @@ void UI::StepAll()
 
 
 // Draw all the panels.
-void UI::DrawAll()
+void UI::DrawAll(double interpolation)
 {
+	this->interpolation = interpolation;
+	
 	// First, clear all the clickable zones. New ones will be added in the
 	// course of drawing the screen.
 	for(const shared_ptr<Panel> &it : stack)
@@ -123,6 +125,14 @@ void UI::DrawAll()
 
 
 
+// Get the interpolation that the panels are currently being drawn with.
+double UI::Interpolation() const
+{
+	return interpolation;
+}
+
+
+
 // Add the given panel to the stack. UI is responsible for deleting it.
 void UI::Push(Panel *panel)
 {
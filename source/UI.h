@@ -36,8 +36,11 @@ public:
 	
 	// Step all the panels forward (advance animations, move objects, etc.).
 	void StepAll();
-	// Draw all the panels.
-	void DrawAll();
+	// Draw all the panels. The interpolation is the fraction of a step that
+	// has passed since the panels were last stepped.
+	void DrawAll(double interpolation = 0.);
+	// Get the interpolation that the panels are currently being drawn with.
+	double Interpolation() const;
 	
 	// Add the given panel to the stack. If you do not want a panel to be
 	// deleted when it is popped, save a copy of its shared pointer elsewhere.
@@ -83,6 +86,8 @@ private:
 	bool canSave = false;
 	// Whether the player has requested the game to shut down.
 	bool isDone = false;
+	// How far past the most recent step the current frame is being drawn.
+	double interpolation = 0.;
 	
 	std::vector<std::shared_ptr<Panel>> stack;
 	std::vector<std::shared_ptr<Panel>> toPush;
@@ -23,7 +23,8 @@ class Effect;
 
 
 // A Visual is the object created by an Effect. This is a separate class from
-// Effect to allow it to be much more lightweight.
+// Effect to allow it to be much more lightweight. Once created, its state is
+// handed over to a ParticleSystem, which steps and draws all the visuals.
 class Visual : public Body {
 public:
 	Visual() = default;
@@ -38,13 +39,13 @@ public:
 	double Zoom() const;
 	*/
 	
-	// Step the effect forward.
-	void Move();
-	
 	
 private:
 	Angle spin;
 	int lifetime = 0;
+	
+	// Allow the particle system to take over this visual's state.
+	friend class ParticleSystem;
 };
 
 
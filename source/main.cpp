@@ -28,13 +28,16 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Panel.h"
 #include "PlayerInfo.h"
 #include "Preferences.h"
+#include "SaveQueue.h"
 #include "Screen.h"
+#include "Ship.h"
 #include "SpriteSet.h"
 #include "SpriteShader.h"
 #include "Test.h"
 #include "UI.h"
 
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <map>
 
@@ -47,9 +50,17 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 using namespace std;
 
+namespace {
+	// Never take more than this many steps (times the game speed) in a single
+	// frame, even if the game has fallen further behind than that.
+	const int MAX_STEPS_PER_FRAME = 4;
+	// Frame times this close to a whole number of steps are rounded to it.
+	const chrono::steady_clock::duration STEP_SNAP = chrono::microseconds(500);
+}
+
 void PrintHelp();
 void PrintVersion();
-void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRun, bool debugMode);
+void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRun, bool debugMode, int simSpeed);
 Conversation LoadConversation();
 #ifdef _WIN32
 void InitConsole();
@@ -69,6 +80,7 @@ int main(int argc, char *argv[])
 	bool debugMode = false;
 	bool loadOnly = false;
 	string testToRunName = "";
+	int simSpeed = 1;
 
 	for(const char *const *it = argv + 1; *it; ++it)
 	{
@@ -86,11 +98,16 @@ int main(int argc, char *argv[])
 		else if(arg == "-t" || arg == "--talk")
 			conversation = LoadConversation();
 		else if(arg == "-d" || arg == "--debug")
+		{
 			debugMode = true;
+			Ship::SetCheckDerivedStats(true);
+		}
 		else if(arg == "-p" || arg == "--parse-save")
 			loadOnly = true;
 		else if(arg == "--test" && *++it)
 			testToRunName = *it;
+		else if(arg == "--sim-speed" && *++it)
+			simSpeed = max(1, min(1000, atoi(*it)));
 	}
 	
 	try {
@@ -126,7 +143,7 @@ int main(int argc, char *argv[])
 		if(!GameWindow::Init())
 			return 1;
 		
-		GameData::LoadShaders(!GameWindow::HasSwizzle());
+		GameData::LoadShaders(!GameWindow::HasSwizzle(), GameWindow::HasInstancing());
 		
 		// Show something other than a blank window.
 		GameWindow::Step();
@@ -134,7 +151,7 @@ int main(int argc, char *argv[])
 		Audio::Init(GameData::Sources());
 		
 		// This is the main loop where all the action begins.
-		GameLoop(player, conversation, testToRunName, debugMode);
+		GameLoop(player, conversation, testToRunName, debugMode, simSpeed);
 	}
 	catch(const runtime_error &error)
 	{
@@ -156,7 +173,7 @@ int main(int argc, char *argv[])
 	return 0;
 }
 
-void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRunName, bool debugMode)
+void GameLoop(PlayerInfo &player, const Conversation &conversation, const string &testToRunName, bool debugMode, int simSpeed)
 {
 	// gamePanels is used for the main panel where you fly your spaceship.
 	// All other game content related dialogs are placed on top of the gamePanels.
@@ -175,13 +192,19 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 	
 	bool showCursor = true;
 	int cursorTime = 0;
-	int frameRate = 60;
-	FrameTimer timer(frameRate);
 	bool isPaused = false;
 	bool isFastForward = false;
 	
-	// If fast forwarding, keep track of whether the current frame should be drawn.
-	int skipFrame = 0;
+	// The game is simulated in fixed steps, normally 60 per second. Frames are
+	// drawn as often as the display refreshes, independent of the step rate, and
+	// anything that is moving is drawn part of the way into the next step.
+	int stepRate = 60;
+	FrameTimer timer(GameWindow::RefreshRate());
+	// Time that has passed, but that has not been simulated yet.
+	chrono::steady_clock::duration unsimulated = chrono::steady_clock::duration::zero();
+	chrono::steady_clock::time_point lastFrame = chrono::steady_clock::now();
+	// Whether the game panels were stepped in the most recent step.
+	bool isGameRunning = false;
 	
 	// Limit how quickly full-screen mode can be toggled.
 	int toggleTimeout = 0;
@@ -194,8 +217,6 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 	// IsDone becomes true when the game is quit.
 	while(!menuPanels.IsDone())
 	{
-		if(toggleTimeout)
-			--toggleTimeout;
 		chrono::steady_clock::time_point start = chrono::steady_clock::now();
 		
 		// Handle any events that occurred in this frame.
@@ -229,6 +250,7 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 				// The window has been resized. Adjust the raw screen size
 				// and the OpenGL viewport to match.
 				GameWindow::AdjustViewport();
+				timer.SetFrameRate(GameWindow::RefreshRate());
 			}
 			else if(activeUI.Handle(event))
 			{
@@ -253,7 +275,6 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 		// In full-screen mode, hide the cursor if inactive for ten seconds,
 		// but only if the player is flying around in the main view.
 		bool inFlight = (menuPanels.IsEmpty() && gamePanels.Root() == gamePanels.Top());
-		++cursorTime;
 		bool shouldShowCursor = (!GameWindow::IsFullscreen() || cursorTime < 600 || !inFlight);
 		if(shouldShowCursor != showCursor)
 		{
@@ -268,44 +289,69 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 		if(Preferences::Has("Interrupt fast-forward") && !inFlight && isFastForward && !allowFastForward)
 			isFastForward = false;
 		
-		// Tell all the panels to step forward, then draw them.
-		((!isPaused && menuPanels.IsEmpty()) ? gamePanels : menuPanels).StepAll();
+		// Let the player know if a saved game could not be written.
+		for(const string &path : SaveQueue::TakeFailures())
+			(menuPanels.IsEmpty() ? gamePanels : menuPanels).Push(new Dialog(
+				"Unable to save \"" + Files::Name(path) + "\". Check that the saves folder is writable."));
 		
-		// All manual events and processing done. Handle any test inputs and events if we have any.
-		if(testContext.testToRun)
-			testContext.testToRun->Step(testContext, menuPanels, gamePanels, player);
+		// Caps lock slows the game down in debug mode.
+		bool isSlowed = ((mod & KMOD_CAPS) && inFlight && debugMode);
 		
-		// Caps lock slows the frame rate in debug mode.
-		// Slowing eases in and out over a couple of frames.
-		if((mod & KMOD_CAPS) && inFlight && debugMode)
-		{
-			if(frameRate > 10)
-			{
-				frameRate = max(frameRate - 5, 10);
-				timer.SetFrameRate(frameRate);
-			}
-		}
-		else
+		// Figure out how many steps need to be taken to catch up with the time
+		// that has passed. Fast-forwarding just takes more steps per frame.
+		int speed = simSpeed * ((isFastForward && inFlight && stepRate == 60) ? 3 : 1);
+		chrono::steady_clock::duration stepTime = chrono::nanoseconds(1000000000 / stepRate);
+		chrono::steady_clock::duration elapsed = start - lastFrame;
+		lastFrame = start;
+		// If this frame took almost exactly a whole number of steps, as it will
+		// if the display refreshes at the step rate, treat it as taking exactly
+		// that long so that timing jitter does not cause uneven steps.
+		chrono::steady_clock::duration realStepTime = stepTime / speed;
+		chrono::steady_clock::duration remainder = elapsed % realStepTime;
+		if(remainder < STEP_SNAP)
+			elapsed -= remainder;
+		else if(realStepTime - remainder < STEP_SNAP)
+			elapsed += realStepTime - remainder;
+		unsimulated += elapsed * speed;
+		
+		for(int steps = 0; unsimulated >= stepTime && steps < MAX_STEPS_PER_FRAME * speed; ++steps)
 		{
-			if(frameRate < 60)
-			{
-				frameRate = min(frameRate + 5, 60);
-				timer.SetFrameRate(frameRate);
-			}
+			unsimulated -= stepTime;
+			if(toggleTimeout)
+				--toggleTimeout;
+			++cursorTime;
 			
-			if(isFastForward && inFlight)
-			{
-				skipFrame = (skipFrame + 1) % 3;
-				if(skipFrame)
-					continue;
-			}
+			// Tell all the panels to step forward.
+			isGameRunning = (!isPaused && menuPanels.IsEmpty());
+			(isGameRunning ? gamePanels : menuPanels).StepAll();
+			
+			// All manual events and processing done. Handle any test inputs and events if we have any.
+			if(testContext.testToRun)
+				testContext.testToRun->Step(testContext, menuPanels, gamePanels, player);
+			
+			// Slowing eases in and out over a couple of steps, no matter how
+			// many steps are taken in each frame.
+			if(isSlowed)
+				stepRate = max(stepRate - 5, 10);
+			else
+				stepRate = min(stepRate + 5, 60);
+			stepTime = chrono::nanoseconds(1000000000 / stepRate);
 		}
+		// If the game cannot keep up, let it run slower rather than trying to
+		// catch up later.
+		unsimulated %= stepTime;
 		
 		Audio::Step();
 		
 		// Events in this frame may have cleared out the menu, in which case
 		// we should draw the game panels instead:
-		(menuPanels.IsEmpty() ? gamePanels : menuPanels).DrawAll();
+		if(menuPanels.IsEmpty())
+		{
+			double interpolation = isGameRunning ? static_cast<double>(unsimulated.count()) / stepTime.count() : 0.;
+			gamePanels.DrawAll(interpolation);
+		}
+		else
+			menuPanels.DrawAll();
 		if(isFastForward)
 			SpriteShader::Draw(SpriteSet::Get("ui/fast forward"), Screen::TopLeft() + Point(10., 10.));
 		
@@ -321,6 +367,8 @@ void GameLoop(PlayerInfo &player, const Conversation &conversation, const string
 	// If player quit while landed on a planet, save the game if there are changes.
 	if(player.GetPlanet() && gamePanels.CanSave())
 		player.Save();
+	// Do not quit until all the saves have been written.
+	SaveQueue::Finish();
 }
 
 
@@ -339,7 +387,12 @@ void PrintHelp()
 	cerr << "    -d, --debug: turn on debugging features (e.g. Caps Lock slows down instead of speeds up)." << endl;
 	cerr << "    -p, --parse-save: load the most recent saved game and inspect it for content errors" << endl;
 	cerr << "    --tests: print table of available tests, then exit." << endl;
+	cerr << "    --economy <days>: simulate the economy for the given number of days, print" << endl;
+	cerr << "        the supply and price of each commodity in each system as CSV, then exit." << endl;
+	cerr << "    --seed <number>: random seed to use with --economy (default 0)." << endl;
 	cerr << "    --test <name>: run given test from resources directory" << endl;
+	cerr << "    --sim-speed <n>: run the game n times faster than normal, drawing frames no more" << endl;
+	cerr << "        often than the display refreshes (for benchmarking)." << endl;
 	cerr << endl;
 	cerr << "Report bugs to: <https://github.com/endless-sky/endless-sky/issues>" << endl;
 	cerr << "Home page: <https://endless-sky.github.io>" << endl;
@@ -38,8 +38,9 @@ public:
 	// string can have suffixes like "M", "B", etc.
 	static double Parse(const std::string &str);
 	// Replace a set of "keys," which must be strings in the form "<name>", with
-	// a new set of strings, and return the result.
-	static std::string Replace(const std::string &source, const std::map<std::string, std::string> keys);
+	// a new set of strings, and return the result. Text that is substituted
+	// repeatedly should be stored as a TextTemplate instead.
+	static std::string Replace(const std::string &source, const std::map<std::string, std::string> &keys);
 	// Replace all occurences of "target" with "replacement" in-place.
 	static void ReplaceAll(std::string &text, const std::string &target, const std::string &replacement);
 	
@@ -0,0 +1,90 @@
+/* TextTemplate.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "TextTemplate.h"
+
+using namespace std;
+
+
+
+TextTemplate::TextTemplate(const string &text)
+	: text(text)
+{
+	size_t left = text.find('<');
+	while(left != string::npos)
+	{
+		size_t right = text.find('>', left);
+		if(right == string::npos)
+			break;
+		
+		++right;
+		possibleKeys.push_back(Key{left, text.substr(left, right - left)});
+		left = text.find('<', left + 1);
+	}
+}
+
+
+
+// Get the text, without any substitutions.
+const string &TextTemplate::Text() const
+{
+	return text;
+}
+
+
+
+bool TextTemplate::IsEmpty() const
+{
+	return text.empty();
+}
+
+
+
+// Replace each key that appears in the given map with its value, and
+// return the result. Any other keys are left as they are.
+string TextTemplate::Replace(const map<string, string> &keys) const
+{
+	if(possibleKeys.empty())
+		return text;
+	
+	// Figure out how long the result will be before building it, so that it
+	// only needs to be allocated once.
+	size_t length = text.length();
+	size_t start = 0;
+	for(const Key &key : possibleKeys)
+	{
+		if(key.start < start)
+			continue;
+		auto it = keys.find(key.name);
+		if(it == keys.end())
+			continue;
+		length += it->second.length() - key.name.length();
+		start = key.start + key.name.length();
+	}
+	
+	string result;
+	result.reserve(length);
+	start = 0;
+	for(const Key &key : possibleKeys)
+	{
+		if(key.start < start)
+			continue;
+		auto it = keys.find(key.name);
+		if(it == keys.end())
+			continue;
+		result.append(text, start, key.start - start);
+		result.append(it->second);
+		start = key.start + key.name.length();
+	}
+	result.append(text, start, text.length() - start);
+	return result;
+}
@@ -0,0 +1,61 @@
+/* TextTemplate.h
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef ES_TEXT_TEXTTEMPLATE_H_
+#define ES_TEXT_TEXTTEMPLATE_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+
+
+// Class holding a string that may contain "<name>" keys to be substituted. The
+// positions of the possible keys are found once, when the text is given, so
+// filling in the text with a set of substitutions only has to look up each key
+// and allocate the result once.
+class TextTemplate {
+public:
+	TextTemplate() = default;
+	// Allow this conversion to be implicit, so that a template can be assigned
+	// from a string just like the string it replaces.
+	TextTemplate(const std::string &text);
+	
+	// Get the text, without any substitutions.
+	const std::string &Text() const;
+	bool IsEmpty() const;
+	
+	// Replace each key that appears in the given map with its value, and
+	// return the result. Any other keys are left as they are.
+	std::string Replace(const std::map<std::string, std::string> &keys) const;
+
+
+private:
+	// A span of the text from a '<' to the first '>' after it. Each '<' can
+	// start a key, so these may overlap; once a key is replaced, any others
+	// that start inside of it are skipped.
+	class Key {
+	public:
+		size_t start;
+		std::string name;
+	};
+
+
+private:
+	std::string text;
+	std::vector<Key> possibleKeys;
+};
+
+
+
+#endif
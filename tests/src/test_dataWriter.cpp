@@ -0,0 +1,59 @@
+/* test_dataWriter.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/DataWriter.h"
+
+// ... and any system includes needed for the test file.
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "A DataWriter can compose text without a file", "[DataWriter]" ) {
+	GIVEN( "a DataWriter with no path" ) {
+		DataWriter out;
+		WHEN( "nodes and their children are written" ) {
+			out.Write("pilot", "Jane", "Doe");
+			out.BeginChild();
+			{
+				out.Write("date", 16, 11, 3013);
+			}
+			out.EndChild();
+			out.WriteComment("done");
+			
+			THEN( "the text is indented and quoted as in a file" ) {
+				CHECK( out.SaveToString() == "pilot Jane Doe\n\tdate 16 11 3013\n# done\n" );
+			}
+			AND_WHEN( "the text has been retrieved" ) {
+				out.SaveToString();
+				THEN( "the writer starts over with an empty buffer" ) {
+					CHECK( out.SaveToString().empty() );
+					out.Write("system", "Sol Prime");
+					CHECK( out.SaveToString() == "system \"Sol Prime\"\n" );
+				}
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,78 @@
+/* test_datafile.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/DataFile.h"
+
+#include "output-capture.hpp"
+
+// ... and any system includes needed for the test file.
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Parse the given text, and list the tokens of each top-level node.
+std::vector<std::vector<std::string>> Parse(const std::string &text)
+{
+	std::istringstream in(text);
+	DataFile file(in);
+	std::vector<std::vector<std::string>> result;
+	for(const DataNode &node : file)
+	{
+		result.emplace_back();
+		for(int i = 0; i < node.Size(); ++i)
+			result.back().push_back(node.Token(i));
+	}
+	return result;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Parsing text that does not end in a newline", "[DataFile]" ) {
+	using Nodes = std::vector<std::vector<std::string>>;
+	GIVEN( "a last line with no line break" ) {
+		THEN( "its tokens are all read" ) {
+			CHECK( Parse("ship Shuttle\nsystem \"Sol Prime\"") == Nodes{{"ship", "Shuttle"}, {"system", "Sol Prime"}} );
+		}
+		THEN( "an unterminated quote ends with the text" ) {
+			OutputSink traces(std::cerr);
+			CHECK( Parse("name \"Sol Prime") == Nodes{{"name", "Sol Prime"}} );
+			CHECK( traces.Flush().find("Closing quotation mark is missing") != std::string::npos );
+		}
+		THEN( "a trailing comment or whitespace adds nothing" ) {
+			CHECK( Parse("date 1 2 3 # comment") == Nodes{{"date", "1", "2", "3"}} );
+			CHECK( Parse("date 1 2 3\n\t") == Nodes{{"date", "1", "2", "3"}} );
+		}
+	}
+	GIVEN( "text with multi-byte characters" ) {
+		THEN( "they are kept intact within tokens" ) {
+			CHECK( Parse("planet \"Ülgen Prime\" Φ\n") == Nodes{{"planet", "Ülgen Prime", "Φ"}} );
+		}
+	}
+	GIVEN( "empty text" ) {
+		THEN( "there are no nodes" ) {
+			CHECK( Parse("").empty() );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,134 @@
+/* test_distanceMap.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/DistanceMap.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Set.h"
+#include "../../source/System.h"
+
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+// Link the given number of systems into a grid, in which each system is
+// linked to the ones beside it, and return them in the order they were made.
+std::vector<const System *> MakeGrid(Set<System> &systems, int width, int height)
+{
+	auto grid = std::vector<const System *>{};
+	for(int y = 0; y < height; ++y)
+		for(int x = 0; x < width; ++x)
+		{
+			System *system = systems.Get("System " + std::to_string(x) + "," + std::to_string(y));
+			if(x)
+				system->Link(systems.Get("System " + std::to_string(x - 1) + "," + std::to_string(y)));
+			if(y)
+				system->Link(systems.Get("System " + std::to_string(x) + "," + std::to_string(y - 1)));
+			grid.push_back(system);
+		}
+	return grid;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "A DistanceMap finds routes to other systems", "[DistanceMap]" ) {
+	GIVEN( "a grid of linked systems" ) {
+		auto systems = Set<System>{};
+		const auto grid = MakeGrid(systems, 5, 4);
+		const System *corner = grid.front();
+		const System *farCorner = grid.back();
+		
+		WHEN( "there is no limit on the distance" ) {
+			const auto map = DistanceMap(corner);
+			THEN( "every system can be reached" ) {
+				CHECK( map.Systems().size() == grid.size() );
+				CHECK( map.HasRoute(farCorner) );
+				CHECK( map.Days(corner) == 0 );
+				CHECK( map.Days(farCorner) == 7 );
+			}
+			THEN( "each route leads one jump closer to the center" ) {
+				for(const System *system : grid)
+					if(system != corner)
+					{
+						const System *next = map.Route(system);
+						REQUIRE( next );
+						CHECK( map.Days(next) == map.Days(system) - 1 );
+						CHECK( map.RequiredFuel(system, next) == 100 );
+					}
+				CHECK( map.Route(corner) == nullptr );
+			}
+			THEN( "systems outside the map have no route" ) {
+				CHECK_FALSE( map.HasRoute(nullptr) );
+				CHECK( map.Days(systems.Get("Nowhere")) == -1 );
+				CHECK( map.RequiredFuel(corner, systems.Get("Nowhere")) == -1 );
+			}
+		}
+		WHEN( "the distance is limited" ) {
+			const auto map = DistanceMap(corner, -1, 2);
+			THEN( "only the nearby systems are included" ) {
+				CHECK( map.Systems().size() == 6 );
+				CHECK( map.Days(grid[2]) == 2 );
+				CHECK_FALSE( map.HasRoute(grid[3]) );
+			}
+		}
+		WHEN( "the number of systems is limited" ) {
+			const auto map = DistanceMap(corner, 3);
+			THEN( "the search stops once that many are found" ) {
+				CHECK( map.Systems().size() == 4 );
+			}
+		}
+		WHEN( "many maps are made one after another" ) {
+			const auto first = DistanceMap(corner);
+			const auto second = DistanceMap(farCorner, -1, 1);
+			THEN( "they do not interfere with each other" ) {
+				CHECK( first.Days(farCorner) == 7 );
+				CHECK( second.Days(corner) == -1 );
+				CHECK( second.Systems().size() == 3 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark DistanceMap", "[!benchmark][distancemap]" ) {
+	// About as many systems as in the stock map.
+	auto systems = Set<System>{};
+	const auto grid = MakeGrid(systems, 25, 24);
+	BENCHMARK( "DistanceMap with each system as the center" ) {
+		int total = 0;
+		for(const System *center : grid)
+			total += DistanceMap(center).Days(grid.back());
+		return total;
+	};
+	BENCHMARK( "DistanceMap of the 20 nearest systems to each system" ) {
+		int total = 0;
+		for(const System *center : grid)
+			total += DistanceMap(center, 20).Systems().size();
+		return total;
+	};
+}
+#endif
+// #endregion benchmarks
+
+
+
+} // test namespace
@@ -0,0 +1,79 @@
+/* test_distanceTable.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/DistanceTable.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/DistanceMap.h"
+#include "../../source/System.h"
+
+#include <string>
+
+namespace { // test namespace
+// #region mock data
+// Link the systems "0" through "count - 1" into a line, and add a pair of
+// systems that are not connected to the rest of them.
+void MakeGalaxy(Set<System> &systems, int count)
+{
+	for(int i = 1; i < count; ++i)
+		systems.Get(std::to_string(i - 1))->Link(systems.Get(std::to_string(i)));
+	systems.Get("island")->Link(systems.Get("isle"));
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "A DistanceTable counts the jumps between systems", "[DistanceTable]" ) {
+	GIVEN( "a galaxy with two separate groups of systems" ) {
+		auto systems = Set<System>{};
+		MakeGalaxy(systems, 12);
+		auto table = DistanceTable{};
+		table.Update(systems);
+		const System *first = systems.Get("0");
+		
+		THEN( "systems on the same route have the same distance as a DistanceMap" ) {
+			const auto map = DistanceMap(first);
+			for(int i = 0; i < 12; ++i)
+			{
+				const System *system = systems.Get(std::to_string(i));
+				CHECK( table.Days(first, system) == map.Days(system) );
+				CHECK( table.Days(system, first) == i );
+			}
+		}
+		THEN( "systems without a route have no distance" ) {
+			CHECK( table.Days(first, systems.Get("island")) == -1 );
+			CHECK( table.Days(systems.Get("isle"), systems.Get("island")) == 1 );
+		}
+		THEN( "the systems within a given distance can be listed" ) {
+			CHECK( table.Systems(systems.Get("5"), 1).size() == 3 );
+			CHECK( table.Systems(systems.Get("island"), -1).size() == 2 );
+		}
+		
+		WHEN( "a link is removed and the table is updated" ) {
+			systems.Get("5")->Unlink(systems.Get("6"));
+			table.Update(systems);
+			THEN( "the distances change" ) {
+				CHECK( table.Days(first, systems.Get("5")) == 5 );
+				CHECK( table.Days(first, systems.Get("6")) == -1 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
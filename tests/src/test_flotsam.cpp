@@ -0,0 +1,67 @@
+/* test_flotsam.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/Flotsam.h"
+
+// ... and any system includes needed for the test file.
+#include <memory>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Creating flotsam from the pool", "[flotsam]" ) {
+	GIVEN( "flotsam that has been created and destroyed" ) {
+		std::vector<std::shared_ptr<Flotsam>> boxes;
+		for(int i = 0; i < 20; ++i)
+			boxes.push_back(Flotsam::Create("Food", Flotsam::TONS_PER_BOX));
+		boxes.clear();
+		unsigned allocations = Flotsam::Allocations();
+		
+		WHEN( "the same amount of flotsam is created again" ) {
+			for(int i = 0; i < 20; ++i)
+				boxes.push_back(Flotsam::Create("Food", i + 1));
+			
+			THEN( "no new memory is allocated for it" ) {
+				CHECK( Flotsam::Allocations() == allocations );
+			}
+			THEN( "each flotsam has its own contents" ) {
+				for(int i = 0; i < 20; ++i)
+				{
+					CHECK( boxes[i]->CommodityType() == "Food" );
+					CHECK( boxes[i]->Count() == i + 1 );
+				}
+			}
+		}
+		WHEN( "more flotsam is created than the pool holds" ) {
+			for(int i = 0; i < 21; ++i)
+				boxes.push_back(Flotsam::Create("Food", Flotsam::TONS_PER_BOX));
+			
+			THEN( "the pool allocates more memory" ) {
+				CHECK( Flotsam::Allocations() == allocations + 1 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,178 @@
+/* test_gzip.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/Gzip.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/DataFile.h"
+#include "../../source/DataNode.h"
+#include "../../source/DataWriter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+// Compose something shaped like a long-running pilot's save file.
+std::string MakeSave(int ships)
+{
+	DataWriter out;
+	out.Write("pilot", "Jane", "Doe");
+	out.Write("date", 16, 11, 3013);
+	out.Write("system", "Sol");
+	for(int i = 0; i < ships; ++i)
+	{
+		out.Write("ship", "Bactrian");
+		out.BeginChild();
+		{
+			out.Write("name", "Ship " + std::to_string(i));
+			out.Write("outfits");
+			out.BeginChild();
+			{
+				out.Write("Heavy Laser Turret", 4);
+				out.Write("\"Bondsman\" Hyperdrive");
+				out.Write("Hyperdrive");
+			}
+			out.EndChild();
+			out.Write("crew", 70 + i % 13);
+			out.Write("fuel", 600.5);
+		}
+		out.EndChild();
+	}
+	out.WriteComment("How you began:");
+	return out.SaveToString();
+}
+
+
+
+// Write out the nodes of a parsed file, so two files can be compared.
+std::string Reformat(const std::string &text)
+{
+	std::istringstream in(text);
+	DataFile file(in);
+	DataWriter out;
+	for(const DataNode &node : file)
+		out.Write(node);
+	return out.SaveToString();
+}
+
+// Generate text that does not compress well.
+std::string Noise(size_t size, unsigned seed)
+{
+	std::string text;
+	for(size_t i = 0; i < size; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		text += static_cast<char>('a' + (seed >> 16) % 26);
+	}
+	return text;
+}
+
+// Write the given data to a file and read it back through Gzip::Read.
+std::string ReadBack(const std::string &data)
+{
+	const std::string path = "test_gzip_read.tmp";
+	{
+		std::ofstream out(path, std::ios::binary);
+		out.write(data.data(), data.size());
+	}
+	std::string result;
+	Gzip::Read(path, [&result](const char *chunk, size_t size) { result.append(chunk, size); return true; });
+	std::remove(path.c_str());
+	return result;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Compressing saved games", "[Gzip]" ) {
+	GIVEN( "the text of a large save file" ) {
+		const std::string text = MakeSave(500);
+		REQUIRE_FALSE( Gzip::IsCompressed(text) );
+		
+		WHEN( "it is compressed" ) {
+			const std::string compressed = Gzip::Compress(text);
+			THEN( "the result is recognizably gzip data, and smaller" ) {
+				CHECK( Gzip::IsCompressed(compressed) );
+				CHECK( compressed.size() < text.size() / 4 );
+			}
+			THEN( "decompressing it restores the exact text" ) {
+				CHECK( Gzip::Decompress(compressed) == text );
+			}
+			THEN( "the restored text parses to the same nodes" ) {
+				CHECK( Reformat(Gzip::Decompress(compressed)) == Reformat(text) );
+			}
+			AND_WHEN( "the compressed data is cut short" ) {
+				const std::string truncated = compressed.substr(0, compressed.size() / 2);
+				THEN( "it is not mistaken for the whole file" ) {
+					CHECK( Gzip::Decompress(truncated).empty() );
+				}
+			}
+		}
+	}
+	GIVEN( "an empty file" ) {
+		THEN( "it survives the round trip" ) {
+			const std::string compressed = Gzip::Compress("");
+			CHECK( Gzip::IsCompressed(compressed) );
+			CHECK( Gzip::Decompress(compressed).empty() );
+		}
+	}
+	GIVEN( "text that is not compressed" ) {
+		THEN( "it cannot be decompressed" ) {
+			CHECK( Gzip::Decompress("pilot Jane Doe\n").empty() );
+		}
+	}
+}
+
+SCENARIO( "Reading saved games from disk", "[Gzip]" ) {
+	GIVEN( "a large, highly compressible file" ) {
+		// Long runs that inflate to far more than one buffer's worth of output,
+		// separated by noise so that the compressed file spans many reads.
+		std::string text;
+		for(int i = 0; i < 40; ++i)
+			text += std::string((i + 1) << 14, 'x') + Noise(i * 1000, i);
+		const std::string compressed = Gzip::Compress(text);
+		REQUIRE( compressed.size() > (1 << 17) );
+		
+		WHEN( "it is read in compressed form" ) {
+			THEN( "every byte arrives" ) {
+				const std::string result = ReadBack(compressed);
+				CHECK( result.size() == text.size() );
+				CHECK( result == text );
+			}
+		}
+		WHEN( "it is read in uncompressed form" ) {
+			THEN( "every byte arrives" ) {
+				CHECK( ReadBack(text) == text );
+			}
+		}
+		WHEN( "the compressed file is cut short" ) {
+			THEN( "only the start of the text arrives" ) {
+				const std::string result = ReadBack(compressed.substr(0, compressed.size() / 2));
+				CHECK( result.size() < text.size() );
+				CHECK( text.compare(0, result.size(), result) == 0 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
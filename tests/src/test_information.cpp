@@ -0,0 +1,121 @@
+/* test_information.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/Information.h"
+
+// ... and any system includes needed for the test file.
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO("Looking up information by name or by slot", "[Information]") {
+	GIVEN( "A name used for a string" ) {
+		int slot = Information::StringSlot("test information string");
+		THEN( "The same name always has the same slot" ) {
+			CHECK( Information::StringSlot("test information string") == slot );
+		}
+		THEN( "A different name has a different slot" ) {
+			CHECK( Information::StringSlot("test information other string") != slot );
+		}
+		WHEN( "the string is set by name" ) {
+			Information info;
+			info.SetString("test information string", "value");
+			THEN( "it can be read by name or by slot" ) {
+				CHECK( info.GetString("test information string") == "value" );
+				CHECK( info.GetString(slot) == "value" );
+			}
+		}
+		WHEN( "the string is set by slot" ) {
+			Information info;
+			info.SetString(slot, "value");
+			THEN( "it can be read by name or by slot" ) {
+				CHECK( info.GetString("test information string") == "value" );
+				CHECK( info.GetString(slot) == "value" );
+			}
+		}
+	}
+	GIVEN( "An empty Information object" ) {
+		Information info;
+		THEN( "Unset values have their defaults" ) {
+			CHECK( info.GetString("test information never set").empty() );
+			CHECK( info.GetString(-1).empty() );
+			CHECK( info.BarValue("test information never set") == 0. );
+			CHECK( info.BarSegments("test information never set") == 1. );
+			CHECK( info.GetSpriteUnit("test information never set").X() == 0. );
+			CHECK( info.GetSpriteUnit("test information never set").Y() == -1. );
+			CHECK( info.GetSpriteFrame("test information never set") == 0.f );
+		}
+		WHEN( "a bar with a higher slot is set" ) {
+			Information::BarSlot("test information low bar");
+			info.SetBar("test information high bar", .5, 4.);
+			THEN( "the bars before it still have their defaults" ) {
+				CHECK( info.BarValue("test information low bar") == 0. );
+				CHECK( info.BarSegments("test information low bar") == 1. );
+				CHECK( info.BarValue("test information high bar") == .5 );
+				CHECK( info.BarSegments("test information high bar") == 4. );
+			}
+		}
+	}
+}
+
+SCENARIO("Checking conditions", "[Information]") {
+	Information info;
+	info.SetCondition("test information condition");
+	GIVEN( "Conditions given as strings" ) {
+		THEN( "An empty condition is always true" ) {
+			CHECK( info.HasCondition("") );
+		}
+		THEN( "A condition is true only if it was set" ) {
+			CHECK( info.HasCondition("test information condition") );
+			CHECK_FALSE( info.HasCondition("test information unset condition") );
+		}
+		THEN( "A leading \"!\" negates the condition" ) {
+			CHECK_FALSE( info.HasCondition("!test information condition") );
+			CHECK( info.HasCondition("!test information unset condition") );
+		}
+	}
+	GIVEN( "Conditions that were looked up in advance" ) {
+		THEN( "They give the same results as the strings" ) {
+			CHECK( info.HasCondition(Information::Condition()) );
+			CHECK( info.HasCondition(Information::Condition("")) );
+			CHECK( info.HasCondition(Information::Condition("test information condition")) );
+			CHECK_FALSE( info.HasCondition(Information::Condition("test information unset condition")) );
+			CHECK_FALSE( info.HasCondition(Information::Condition("!test information condition")) );
+			CHECK( info.HasCondition(Information::Condition("!test information unset condition")) );
+		}
+	}
+	GIVEN( "A condition that is set by slot" ) {
+		int slot = Information::ConditionSlot("test information slot condition");
+		CHECK( slot == Information::ConditionSlot("test information slot condition") );
+		CHECK_FALSE( info.HasCondition("test information slot condition") );
+		info.SetCondition(slot);
+		THEN( "It can be checked by name or in advance" ) {
+			CHECK( info.HasCondition("test information slot condition") );
+			CHECK( info.HasCondition(Information::Condition("test information slot condition")) );
+			CHECK_FALSE( info.HasCondition(Information::Condition("!test information slot condition")) );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -16,6 +16,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "../../source/Random.h"
 
 // ... and any system includes needed for the test file.
+#include <cstdint>
+#include <vector>
 
 namespace { // test namespace
 
@@ -28,6 +30,39 @@ namespace { // test namespace
 TEST_CASE( "Random::Int", "[random]") {
 	REQUIRE( Random::Int(1) == 0 );
 }
+
+SCENARIO( "Drawing numbers from a Random::Stream", "[random]" ) {
+	GIVEN( "two streams with the same seed" ) {
+		std::vector<uint32_t> first;
+		std::vector<uint32_t> second;
+		{
+			Random::Stream stream(12345);
+			for(int i = 0; i < 10; ++i)
+				first.push_back(Random::Int());
+		}
+		{
+			Random::Stream stream(12345);
+			for(int i = 0; i < 10; ++i)
+				second.push_back(Random::Int());
+		}
+		THEN( "they produce the same numbers" ) {
+			CHECK( first == second );
+		}
+	}
+	GIVEN( "a stream that is used while the usual generator is seeded" ) {
+		Random::Seed(42);
+		uint32_t expected = Random::Int();
+		Random::Seed(42);
+		{
+			Random::Stream stream(7);
+			Random::Int();
+			Random::Real();
+		}
+		THEN( "the usual generator is not affected by it" ) {
+			CHECK( Random::Int() == expected );
+		}
+	}
+}
 // Test code goes here. Preferably, use scenario-driven language making use of the SCENARIO, GIVEN,
 // WHEN, and THEN macros. (There will be cases where the more traditional TEST_CASE and SECTION macros
 // are better suited to declaration of the public API.)
@@ -16,7 +16,9 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "../../source/Set.h"
 
 // ... and any system includes needed for the test file.
+#include <map>
 #include <string>
+#include <vector>
 
 namespace { // test namespace
 // #region mock data
@@ -24,6 +26,15 @@ class T {
 public:
 	int a = 1;
 };
+
+// Generate names resembling those of the game's data objects.
+std::vector<std::string> MakeNames(int count)
+{
+	auto names = std::vector<std::string>{};
+	for(int i = 0; i < count; ++i)
+		names.emplace_back("Data Object " + std::to_string(i * 7919 % 10007) + " (Mark " + std::to_string(i % 5) + ")");
+	return names;
+}
 // #endregion mock data
 
 
@@ -140,8 +151,126 @@ SCENARIO( "A Set can be reverted to an earlier state", "[Set]" ) {
 		}
 	}
 }
+
+SCENARIO( "A Set indexes its entries by name", "[Set]" ) {
+	GIVEN( "a Set<T> with many entries" ) {
+		auto s = Set<T>{};
+		const auto names = MakeNames(1000);
+		for(const auto &name : names)
+			s.Get(name)->a = name.size();
+		REQUIRE( s.size() == static_cast<int>(names.size()) );
+		
+		THEN( "each entry can be found by name" ) {
+			for(const auto &name : names)
+			{
+				REQUIRE( s.Find(name) );
+				CHECK( s.Find(name)->a == static_cast<int>(name.size()) );
+			}
+			CHECK_FALSE( s.Find("Not an Object") );
+		}
+		THEN( "only names that were added are in it" ) {
+			for(const auto &name : names)
+				CHECK( s.Has(name) );
+			CHECK_FALSE( s.Has("Not an Object") );
+		}
+		THEN( "iteration is in sorted order" ) {
+			const std::string *previous = nullptr;
+			for(const auto &it : s)
+			{
+				if(previous)
+					CHECK( *previous < it.first );
+				previous = &it.first;
+			}
+		}
+		THEN( "pointers remain valid as more entries are added" ) {
+			const T *first = s.Find(names.front());
+			for(int i = 0; i < 1000; ++i)
+				s.Get("Extra " + std::to_string(i));
+			CHECK( s.Find(names.front()) == first );
+			CHECK( s.size() == 2000 );
+		}
+		
+		WHEN( "the Set is copied" ) {
+			const auto copy = s;
+			THEN( "the copy indexes its own entries" ) {
+				CHECK( copy.size() == s.size() );
+				for(const auto &name : names)
+				{
+					REQUIRE( copy.Find(name) );
+					CHECK( copy.Find(name) != s.Find(name) );
+					CHECK( copy.Get(name) == copy.Find(name) );
+				}
+			}
+		}
+	}
+	
+	GIVEN( "a Set<T> reverted to a smaller Set" ) {
+		auto original = Set<T>{};
+		original.Get("B");
+		original.Get("D");
+		auto instance = original;
+		instance.Get("A");
+		instance.Get("C");
+		instance.Get("E");
+		instance.Revert(original);
+		
+		THEN( "the index only finds the remaining entries" ) {
+			REQUIRE( instance.size() == 2 );
+			CHECK_FALSE( instance.Has("A") );
+			CHECK_FALSE( instance.Has("E") );
+			CHECK( instance.Has("B") );
+			CHECK( instance.Has("D") );
+			CHECK( instance.Get("D") == instance.Find("D") );
+			
+			instance.Get("F");
+			CHECK( instance.size() == 3 );
+			CHECK( instance.Has("F") );
+			CHECK( instance.Find("B") );
+		}
+	}
+}
 // #endregion unit tests
 
 
 
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark Set::Find", "[!benchmark][set]" ) {
+	// Approximate sizes of the sets in GameData with all the stock data loaded.
+	const auto sizes = std::map<std::string, int>{
+		{"colors", 150}, {"conversations", 1200}, {"effects", 250}, {"events", 900},
+		{"fleets", 600}, {"galaxies", 30}, {"governments", 100}, {"hazards", 30},
+		{"interfaces", 60}, {"minables", 20}, {"missions", 2000}, {"outfits", 1100},
+		{"persons", 60}, {"phrases", 1100}, {"planets", 650}, {"ships", 450},
+		{"systems", 600}, {"outfitters", 250}, {"shipyards", 150}, {"news", 300}
+	};
+	for(const auto &it : sizes)
+	{
+		const auto names = MakeNames(it.second);
+		auto s = Set<T>{};
+		auto m = std::map<std::string, T>{};
+		for(const auto &name : names)
+		{
+			s.Get(name);
+			m[name];
+		}
+		BENCHMARK( "Set::Find() over all " + it.first ) {
+			int found = 0;
+			for(const auto &name : names)
+				found += (s.Find(name) != nullptr);
+			return found;
+		};
+		BENCHMARK( "std::map::find() over all " + it.first ) {
+			int found = 0;
+			for(const auto &name : names)
+				found += (m.find(name) != m.end());
+			return found;
+		};
+	}
+}
+#endif
+// #endregion benchmarks
+
+
+
 } // test namespace
@@ -0,0 +1,82 @@
+/* test_threadPool.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/ThreadPool.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Random.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Run a loop over the given number of objects, recording which block handled
+// each object and a random number drawn for it.
+void RunLoop(size_t count, std::vector<int> &blocks, std::vector<uint32_t> &numbers)
+{
+	blocks.assign(count, -1);
+	numbers.assign(count, 0);
+	ThreadPool::Run(count, [&blocks, &numbers](int block, size_t begin, size_t end)
+	{
+		for(size_t i = begin; i < end; ++i)
+		{
+			blocks[i] = block;
+			numbers[i] = Random::Int();
+		}
+	});
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Running a loop on the thread pool", "[threadPool]" ) {
+	for(size_t count : {size_t(0), size_t(10), size_t(1000)})
+	{
+		GIVEN( "a loop over " + std::to_string(count) + " objects" ) {
+			std::vector<int> blocks;
+			std::vector<uint32_t> numbers;
+			Random::Seed(1);
+			RunLoop(count, blocks, numbers);
+			
+			THEN( "every object is handled once, by blocks in order" ) {
+				for(size_t i = 0; i < count; ++i)
+				{
+					CHECK( blocks[i] >= 0 );
+					CHECK( blocks[i] < ThreadPool::Blocks() );
+					if(i)
+						CHECK( blocks[i] >= blocks[i - 1] );
+				}
+			}
+			THEN( "the same seed gives the same random numbers" ) {
+				std::vector<int> otherBlocks;
+				std::vector<uint32_t> otherNumbers;
+				Random::Seed(1);
+				RunLoop(count, otherBlocks, otherNumbers);
+				CHECK( otherNumbers == numbers );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,84 @@
+/* text/test_textTemplate.cpp
+Copyright (c) 2021 by OOTA, Masato
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/text/TextTemplate.h"
+
+// ... and any system includes needed for the test file.
+#include <map>
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+const std::map<std::string, std::string> keys = {
+	{"<first>", "Jane"},
+	{"<last>", "Doe"},
+	{"<ship>", "Bounder"},
+	{"<empty>", ""},
+	{"<a <b>", "nested"},
+};
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO("Filling in a text template", "[TextTemplate]") {
+	GIVEN( "A text with no keys" ) {
+		TextTemplate text("Nothing to see here.");
+		THEN( "The text is returned unchanged" ) {
+			CHECK( text.Replace(keys) == "Nothing to see here." );
+			CHECK( text.Text() == "Nothing to see here." );
+		}
+	}
+	GIVEN( "An empty template" ) {
+		TextTemplate text;
+		THEN( "It is empty and replaces to an empty string" ) {
+			CHECK( text.IsEmpty() );
+			CHECK( text.Replace(keys).empty() );
+		}
+	}
+	GIVEN( "A text with known keys" ) {
+		TextTemplate text("Welcome aboard the <ship>, <first> <last>.");
+		THEN( "Each key is replaced" ) {
+			CHECK( text.Replace(keys) == "Welcome aboard the Bounder, Jane Doe." );
+		}
+		THEN( "The original text is kept" ) {
+			CHECK( text.Text() == "Welcome aboard the <ship>, <first> <last>." );
+		}
+	}
+	GIVEN( "A text with keys that are not in the map" ) {
+		TextTemplate text("<first> <middle> <last><empty>");
+		THEN( "Only the known keys are replaced" ) {
+			CHECK( text.Replace(keys) == "Jane <middle> Doe" );
+		}
+	}
+	GIVEN( "A text with unbalanced angle brackets" ) {
+		TextTemplate text("1 < 2 and <first> > <last");
+		THEN( "Only complete keys are replaced" ) {
+			CHECK( text.Replace(keys) == "1 < 2 and Jane > <last" );
+		}
+	}
+	GIVEN( "A text with keys that overlap" ) {
+		THEN( "The first key that matches is used" ) {
+			CHECK( TextTemplate("<a <b>").Replace(keys) == "nested" );
+			CHECK( TextTemplate("<c <first>>").Replace(keys) == "<c Jane>" );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace